@@ -1,6 +1,7 @@
 #ifndef TEMPL_CONSTRAINT_NETWORK_HPP
 #define TEMPL_CONSTRAINT_NETWORK_HPP
 
+#include <cstdint>
 #include <graph_analysis/BaseGraph.hpp>
 #include "Constraint.hpp"
 #include "Variable.hpp"
@@ -74,14 +75,32 @@ public:
      */
     graph_analysis::BaseGraph::Ptr getGraph() const { return mGraph; }
 
+    /**
+     * Get the revision of this constraint network, which is incremented with
+     * every modification, i.e. adding variables, adding/removing constraints
+     * or changing existing constraints (see incrementRevision)
+     * This allows to invalidate derived data, e.g., cached closures
+     */
+    uint64_t getRevision() const { return mRevision; }
+
 protected:
     /**
      * Set the underlying graph of this constraint network
      */
-    graph_analysis::BaseGraph::Ptr setGraph(const graph_analysis::BaseGraph::Ptr& graph) { return mGraph = graph; }
+    graph_analysis::BaseGraph::Ptr setGraph(const graph_analysis::BaseGraph::Ptr& graph) { incrementRevision(); return mGraph = graph; }
+
+    /**
+     * Mark this network as modified
+     * \details Has to be called by subclasses which modify constraints in
+     * place, or modify the underlying graph directly
+     */
+    void incrementRevision() { ++mRevision; }
 
     virtual ConstraintNetwork* getClone() const { return new ConstraintNetwork(*this); }
 
+private:
+    uint64_t mRevision;
+
 };
 
 } // end namespace templ
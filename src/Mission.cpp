@@ -67,6 +67,7 @@ Mission::Mission(const Mission& other)
     , mpLogger(other.mpLogger)
     , mDataPropertyAssignments(other.mDataPropertyAssignments)
     , mPreparedForPlanning(other.mPreparedForPlanning)
+    , mpDistanceMatrix(other.mpDistanceMatrix)
 {
 
     if(other.mpRelations)
@@ -224,6 +225,12 @@ void Mission::prepareForPlanning()
     {
         throw std::runtime_error("templ::Mission::validate: no time intervals defined");
     }
+
+    symbols::constants::Location::PtrList locations = getLocations();
+    if(!mpDistanceMatrix || mpDistanceMatrix->getLocations() != locations)
+    {
+        mpDistanceMatrix = make_shared<solvers::DistanceMatrix>(locations);
+    }
 }
 
 solvers::temporal::TemporalAssertion::Ptr Mission::addResourceLocationCardinalityConstraint(
@@ -433,8 +440,9 @@ std::string Mission::toString(size_t indent) const
         {
             const Location::Ptr& b = locations[j];
 
+            double distance = mpDistanceMatrix ? mpDistanceMatrix->getDistance(a,b) : Location::getDistance(*a,*b);
             ss << hspace << "        " << a->toString() << " -- " << b->toString()
-                << " " << Location::getDistance(*a,*b)
+                << " " << distance
                 << "m" << std::endl;
         }
     }
@@ -498,6 +506,7 @@ std::vector<solvers::FluentTimeResource> Mission::getResourceRequirements(const
     // If multiple requirements exists that have the same interval
     // they can be compacted into one requirement
     FluentTimeResource::compact(requirements);
+    FluentTimeResource::updateRequirementIndices(requirements);
     return requirements;
 }
 
@@ -532,6 +541,7 @@ std::vector<solvers::FluentTimeResource> Mission::getResourceRequirements(const
                 requirementsNoOverlap.end());
     }
 
+    FluentTimeResource::updateRequirementIndices(newRequirements);
     return newRequirements;
 }
 
@@ -15,6 +15,7 @@
 #include "Role.hpp"
 #include "symbols/ObjectVariable.hpp"
 #include "symbols/constants/Location.hpp"
+#include "solvers/DistanceMatrix.hpp"
 #include "utils/Logger.hpp"
 #include "DataPropertyAssignment.hpp"
 
@@ -488,6 +489,14 @@ public:
      */
     void prepareForPlanning();
 
+    /**
+     * Get the distance matrix of all (used) locations, which is computed
+     * with prepareForPlanning
+     * \return distance matrix, or an empty pointer if the mission has not
+     * been prepared for planning
+     */
+    const solvers::DistanceMatrix::Ptr& getDistanceMatrix() const { return mpDistanceMatrix; }
+
     /**
      * Update the max cardinalites according the the available resources of a
      * mission
@@ -614,6 +623,9 @@ private:
     DataPropertyAssignment::List mDataPropertyAssignments;
 
     bool mPreparedForPlanning;
+
+    /// Distances between the locations (computed when preparing for planning)
+    solvers::DistanceMatrix::Ptr mpDistanceMatrix;
 };
 
 } // end namespace templ
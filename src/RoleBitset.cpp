@@ -0,0 +1,121 @@
+#include "RoleBitset.hpp"
+#include <algorithm>
+
+namespace templ {
+
+bool RoleBitset::empty() const
+{
+    for(uint64_t word : mWords)
+    {
+        if(word)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t RoleBitset::count() const
+{
+    size_t count = 0;
+    for(uint64_t word : mWords)
+    {
+        count += __builtin_popcountll(word);
+    }
+    return count;
+}
+
+RoleBitset& RoleBitset::operator|=(const RoleBitset& other)
+{
+    if(other.mWords.size() > mWords.size())
+    {
+        mWords.resize(other.mWords.size(), 0);
+    }
+    for(size_t i = 0; i < other.mWords.size(); ++i)
+    {
+        mWords[i] |= other.mWords[i];
+    }
+    return *this;
+}
+
+RoleBitset& RoleBitset::operator&=(const RoleBitset& other)
+{
+    if(mWords.size() > other.mWords.size())
+    {
+        mWords.resize(other.mWords.size());
+    }
+    for(size_t i = 0; i < mWords.size(); ++i)
+    {
+        mWords[i] &= other.mWords[i];
+    }
+    return *this;
+}
+
+RoleBitset& RoleBitset::operator^=(const RoleBitset& other)
+{
+    if(other.mWords.size() > mWords.size())
+    {
+        mWords.resize(other.mWords.size(), 0);
+    }
+    for(size_t i = 0; i < other.mWords.size(); ++i)
+    {
+        mWords[i] ^= other.mWords[i];
+    }
+    return *this;
+}
+
+RoleBitset& RoleBitset::operator-=(const RoleBitset& other)
+{
+    size_t size = std::min(mWords.size(), other.mWords.size());
+    for(size_t i = 0; i < size; ++i)
+    {
+        mWords[i] &= ~other.mWords[i];
+    }
+    return *this;
+}
+
+bool RoleBitset::operator==(const RoleBitset& other) const
+{
+    size_t size = std::max(mWords.size(), other.mWords.size());
+    for(size_t i = 0; i < size; ++i)
+    {
+        uint64_t a = i < mWords.size() ? mWords[i] : 0;
+        uint64_t b = i < other.mWords.size() ? other.mWords[i] : 0;
+        if(a != b)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool RoleBitset::includes(const RoleBitset& other) const
+{
+    for(size_t i = 0; i < other.mWords.size(); ++i)
+    {
+        uint64_t word = i < mWords.size() ? mWords[i] : 0;
+        if(other.mWords[i] & ~word)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::vector<size_t> RoleBitset::getIds() const
+{
+    std::vector<size_t> ids;
+    for(size_t i = 0; i < mWords.size(); ++i)
+    {
+        uint64_t word = mWords[i];
+        while(word)
+        {
+            ids.push_back(i*64 + __builtin_ctzll(word));
+            // clear the lowest set bit
+            word &= word - 1;
+        }
+    }
+    return ids;
+}
+
+} // end namespace templ
@@ -0,0 +1,89 @@
+#ifndef TEMPL_ROLE_BITSET_HPP
+#define TEMPL_ROLE_BITSET_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace templ {
+
+/**
+ * \class RoleBitset
+ * \brief Set of roles represented as bitset over role ids
+ * \details Set operations (union, intersection, difference) operate on 64 bit
+ * words. The bitset grows as required, where missing words count as zero.
+ * The mapping between roles and ids is maintained by the owner of the bitset
+ * (see RoleInfo)
+ */
+class RoleBitset
+{
+public:
+    RoleBitset() = default;
+
+    void set(size_t id)
+    {
+        size_t word = id/64;
+        if(word >= mWords.size())
+        {
+            mWords.resize(word + 1, 0);
+        }
+        mWords[word] |= (static_cast<uint64_t>(1) << (id % 64));
+    }
+
+    void reset(size_t id)
+    {
+        size_t word = id/64;
+        if(word < mWords.size())
+        {
+            mWords[word] &= ~(static_cast<uint64_t>(1) << (id % 64));
+        }
+    }
+
+    bool test(size_t id) const
+    {
+        size_t word = id/64;
+        return word < mWords.size() && (mWords[word] & (static_cast<uint64_t>(1) << (id % 64)));
+    }
+
+    void clear() { mWords.clear(); }
+
+    bool empty() const;
+
+    /**
+     * Get the number of roles in this set
+     */
+    size_t count() const;
+
+    RoleBitset& operator|=(const RoleBitset& other);
+    RoleBitset& operator&=(const RoleBitset& other);
+    RoleBitset& operator^=(const RoleBitset& other);
+
+    /**
+     * Remove all roles which are part of the other set
+     */
+    RoleBitset& operator-=(const RoleBitset& other);
+
+    RoleBitset operator|(const RoleBitset& other) const { RoleBitset r(*this); return r |= other; }
+    RoleBitset operator&(const RoleBitset& other) const { RoleBitset r(*this); return r &= other; }
+    RoleBitset operator^(const RoleBitset& other) const { RoleBitset r(*this); return r ^= other; }
+    RoleBitset operator-(const RoleBitset& other) const { RoleBitset r(*this); return r -= other; }
+
+    bool operator==(const RoleBitset& other) const;
+    bool operator!=(const RoleBitset& other) const { return !(*this == other); }
+
+    /**
+     * Check if all roles of the other set are part of this set
+     */
+    bool includes(const RoleBitset& other) const;
+
+    /**
+     * Get the ids of all roles in this set (ascending)
+     */
+    std::vector<size_t> getIds() const;
+
+private:
+    std::vector<uint64_t> mWords;
+};
+
+} // end namespace templ
+#endif // TEMPL_ROLE_BITSET_HPP
@@ -27,31 +27,139 @@ std::map<RoleInfo::Attribute, std::string> RoleInfo::AttributeTxt =
 }
  ;
 
+RoleInfo::Tag RoleInfo::getTag(const std::string& tag)
+{
+    for(const std::pair<const Tag, std::string>& p : TagTxt)
+    {
+        if(p.second == tag)
+        {
+            return p.first;
+        }
+    }
+    return UNKNOWN;
+}
+
 RoleInfo::RoleInfo()
     : mRoles()
     , mTaggedRoles()
 {}
 
-void RoleInfo::addRole(const Role& role, const Tag& tag)
+size_t RoleInfo::getId(const Role& role)
+{
+    std::map<Role, size_t>::const_iterator cit = mRoleIds.find(role);
+    if(cit != mRoleIds.end())
+    {
+        return cit->second;
+    }
+
+    size_t id = mIndexedRoles.size();
+    mIndexedRoles.push_back(role);
+    mRoleIds[role] = id;
+    return id;
+}
+
+bool RoleInfo::findId(const Role& role, size_t& id) const
 {
-    addRole(role, TagTxt[ tag ]);
+    std::map<Role, size_t>::const_iterator cit = mRoleIds.find(role);
+    if(cit == mRoleIds.end())
+    {
+        return false;
+    }
+    id = cit->second;
+    return true;
 }
 
-void RoleInfo::addRole(const Role& role, const std::string& tag)
+void RoleInfo::insert(RoleSet& roleSet, const Role& role)
+{
+    size_t id = getId(role);
+    roleSet.bits.set(id);
+    roleSet.roles.insert(role);
+    mAllRoles.bits.set(id);
+    mAllRoles.roles.insert(role);
+}
+
+void RoleInfo::erase(RoleSet& roleSet, const Role& role)
+{
+    size_t id;
+    if(findId(role, id))
+    {
+        roleSet.bits.reset(id);
+        roleSet.roles.erase(role);
+    }
+}
+
+void RoleInfo::assign(RoleSet& roleSet, const Role::Set& roles)
+{
+    roleSet.bits.clear();
+    roleSet.roles.clear();
+    for(const Role& role : roles)
+    {
+        insert(roleSet, role);
+    }
+}
+
+Role::List RoleInfo::toList(const RoleBitset& bits) const
+{
+    Role::List roles;
+    for(size_t id : bits.getIds())
+    {
+        roles.push_back(mIndexedRoles[id]);
+    }
+    std::sort(roles.begin(), roles.end());
+    return roles;
+}
+
+const RoleInfo::RoleSet& RoleInfo::getRoleSet(const std::string& tag) const
 {
-    assert(!role.getName().empty());
     if(tag.empty())
     {
-        mRoles.insert(role);
-    } else {
-        mTaggedRoles[tag].insert(role);
+        return mRoles;
+    }
+    Tag t = getTag(tag);
+    if(t != UNKNOWN || tag == TagTxt[UNKNOWN])
+    {
+        return mTaggedRoles[t];
+    }
+
+    std::map<std::string, RoleSet>::const_iterator cit = mCustomTaggedRoles.find(tag);
+    if(cit != mCustomTaggedRoles.end())
+    {
+        return cit->second;
+    }
+    static const RoleSet empty;
+    return empty;
+}
+
+RoleInfo::RoleSet& RoleInfo::getRoleSet(const std::string& tag)
+{
+    if(tag.empty())
+    {
+        return mRoles;
+    }
+    Tag t = getTag(tag);
+    if(t != UNKNOWN || tag == TagTxt[UNKNOWN])
+    {
+        return mTaggedRoles[t];
     }
-    mAllRoles.insert(role);
+    return mCustomTaggedRoles[tag];
+}
+
+void RoleInfo::addRole(const Role& role, const Tag& tag)
+{
+    assert(!role.getName().empty());
+    insert(mTaggedRoles[tag], role);
+}
+
+void RoleInfo::addRole(const Role& role, const std::string& tag)
+{
+    assert(!role.getName().empty());
+    insert(getRoleSet(tag), role);
 }
 
 void RoleInfo::removeRole(const Role& role, const Tag& tag)
 {
-    removeRole(role, TagTxt[ tag ]);
+    assert(!role.getName().empty());
+    erase(mTaggedRoles[tag], role);
 }
 
 void RoleInfo::removeRole(const Role& role, const std::string& tag)
@@ -59,90 +167,94 @@ void RoleInfo::removeRole(const Role& role, const std::string& tag)
     assert(!role.getName().empty());
     if(tag.empty())
     {
-        if(mRoles.erase(role) != 0)
+        if(!mRoles.roles.count(role))
         {
             throw std::runtime_error("templ::RoleInfo::removeRole failed to remove (any) role");
         }
+        erase(mRoles, role);
     } else {
-        mTaggedRoles[tag].erase(role);
+        erase(getRoleSet(tag), role);
     }
-
-    // mAllRoles.insert(role);
 }
 
-
 const std::set<Role>& RoleInfo::getRoles(const std::string& tag) const
 {
-    if(tag.empty())
-    {
-        return mRoles;
-    }
-    return mTaggedRoles[tag];
+    return getRoleSet(tag).roles;
 }
 
 const std::set<Role>& RoleInfo::getRoles(const Tag& tag) const
 {
-    return getRoles( TagTxt[tag] );
+    return mTaggedRoles[tag].roles;
 }
 
 const std::set<Role> RoleInfo::getRoles(const std::set<Tag>& tags) const
 {
-    std::set<Role> roles;
+    RoleBitset roles;
     for(const Tag& t : tags)
     {
-        const std::set<Role>& tagRoles = getRoles( t );
-        roles.insert(tagRoles.begin(), tagRoles.end());
+        roles |= mTaggedRoles[t].bits;
     }
-    return roles;
+    Role::List roleList = toList(roles);
+    return Role::Set(roleList.begin(), roleList.end());
 }
 
 moreorg::ModelPool RoleInfo::getModelPool(const std::set<Tag>& tags) const
 {
-    std::set<Role> roles = getRoles(tags);
+    RoleBitset roles;
+    for(const Tag& t : tags)
+    {
+        roles |= mTaggedRoles[t].bits;
+    }
 
     moreorg::ModelPool agentPool;
-    for(const Role& r : roles)
+    for(size_t id : roles.getIds())
     {
-        agentPool[r.getModel()] += 1;
+        agentPool[mIndexedRoles[id].getModel()] += 1;
     }
     return agentPool;
 }
 
 bool RoleInfo::hasRole(const Role& role, const std::string& tag) const
 {
-    const std::set<Role>* roleSet = 0;
-    if(tag.empty())
-    {
-        roleSet = &mRoles;
-    } else {
-        roleSet = &mTaggedRoles[tag];
-    }    return roleSet->end() != roleSet->find(role);
+    return getRoleSet(tag).roles.count(role);
 }
 
 bool RoleInfo::hasRole(const Role& role, const Tag& tag) const
 {
-    return hasRole(role, TagTxt[tag]);
+    size_t id;
+    if(!findId(role, id))
+    {
+        return false;
+    }
+    return mTaggedRoles[tag].bits.test(id);
 }
 
 std::string RoleInfo::toString(uint32_t indent) const
 {
     std::stringstream ss;
     std::string hspace(indent,' ');
-    if(!mRoles.empty())
+    if(!mRoles.roles.empty())
     {
         ss << hspace << "    roles:" << std::endl;
-        Role::TypeMap typeMap = Role::toTypeMap(mRoles);
+        Role::TypeMap typeMap = Role::toTypeMap(mRoles.roles);
         ss << Role::toString(typeMap, indent + 8);
     }
 
-    std::map<std::string, std::set<Role> >::const_iterator rit = mTaggedRoles.begin();
-    for(; rit != mTaggedRoles.end(); ++rit)
+    for(const std::pair<const Tag, std::string>& p : TagTxt)
+    {
+        if(!mTaggedRoles[p.first].roles.empty())
+        {
+            ss << hspace << "    roles (" << p.second << "):" << std::endl;
+            Role::TypeMap typeMap = Role::toTypeMap(mTaggedRoles[p.first].roles);
+            ss << Role::toString(typeMap, indent + 8);
+        }
+    }
+    for(const std::pair<const std::string, RoleSet>& p : mCustomTaggedRoles)
     {
-        const std::set<Role>& roles = rit->second;
-        if(!roles.empty())
+        if(!p.second.roles.empty())
         {
-            ss << hspace << "    roles (" << rit->first << "):" << std::endl;
-            Role::TypeMap typeMap = Role::toTypeMap(roles);
+            ss << hspace << "    roles (" << p.first << "):" << std::endl;
+            Role::TypeMap typeMap = Role::toTypeMap(p.second.roles);
             ss << Role::toString(typeMap, indent + 8);
         }
     }
@@ -151,44 +263,35 @@ std::string RoleInfo::toString(uint32_t indent) const
 
 const Role::Set& RoleInfo::getAllRoles() const
 {
-    if(mAllRoles.empty() && !(mRoles.empty() && mTaggedRoles.empty()))
-    {
-        mAllRoles.insert(mRoles.begin(), mRoles.end());
-	std::map<std::string, std::set<Role> >::const_iterator cit = mTaggedRoles.begin();
-  	for( ; cit != mTaggedRoles.end(); ++cit)
-        {
-            const std::set<Role>& taggedRoles = cit->second;
-            mAllRoles.insert(taggedRoles.begin(), taggedRoles.end());
-        }
-    }
-    return mAllRoles;
+    return mAllRoles.roles;
 }
 
 RoleInfo::Status RoleInfo::getStatus(const owlapi::model::IRI& model, uint32_t id) const
 {
-    try {
-        const Role& role = getRole(model, id);
-        if(hasRole(role, REQUIRED))
+    size_t roleId;
+    if(!findId(Role(id, model), roleId) || !mAllRoles.bits.test(roleId))
+    {
+        // role unknown
+        return UNKNOWN_STATUS;
+    }
+
+    if(mTaggedRoles[REQUIRED].bits.test(roleId))
+    {
+        if(mTaggedRoles[ASSIGNED].bits.test(roleId))
         {
-            if(hasRole(role, ASSIGNED))
-            {
-                return REQUIRED_ASSIGNED;
-            } else {
-                return REQUIRED_UNASSIGNED;
-            }
-        } else { // NOT REQUIRED
+            return REQUIRED_ASSIGNED;
+        } else {
+            return REQUIRED_UNASSIGNED;
+        }
+    } else { // NOT REQUIRED
+        if(mTaggedRoles[ASSIGNED].bits.test(roleId))
         {
-            if(hasRole(role, ASSIGNED))
-            {
-                return NOTREQUIRED_ASSIGNED;
-            }
-	    if(hasRole(role, AVAILABLE))
-                return NOTREQUIRED_AVAILABLE;
-            }
+            return NOTREQUIRED_ASSIGNED;
+        }
+        if(mTaggedRoles[AVAILABLE].bits.test(roleId))
+        {
+            return NOTREQUIRED_AVAILABLE;
         }
-    } catch(const std::invalid_argument& e)
-    {
-        // role unknown
     }
     return UNKNOWN_STATUS;
 }
@@ -196,8 +299,7 @@ RoleInfo::Status RoleInfo::getStatus(const owlapi::model::IRI& model, uint32_t i
 std::set<RoleInfo::Status> RoleInfo::getStati() const
 {
     std::set<RoleInfo::Status> stati;
-    Role::Set roles = getAllRoles();
-    for(const Role& role : roles)
+    for(const Role& role : getAllRoles())
     {
         stati.insert( getStatus(role) );
     }
@@ -207,13 +309,22 @@ std::set<RoleInfo::Status> RoleInfo::getStati() const
 std::set<std::string> RoleInfo::getTags(const Role& role) const
 {
     std::set<std::string> tags;
-    for(const std::pair<std::string, Role::Set>& p : mTaggedRoles)
+    size_t id;
+    if(findId(role, id))
     {
-        const std::string& tag = p.first;
-        const Role::Set& roles = p.second;
-        if(roles.end() != std::find(roles.begin(), roles.end(), role))
+        for(const std::pair<const Tag, std::string>& p : TagTxt)
+        {
+            if(mTaggedRoles[p.first].bits.test(id))
+            {
+                tags.insert(p.second);
+            }
+        }
+        for(const std::pair<const std::string, RoleSet>& p : mCustomTaggedRoles)
         {
-            tags.insert(tag);
+            if(p.second.bits.test(id))
+            {
+                tags.insert(p.first);
+            }
         }
     }
     return tags;
@@ -221,28 +332,15 @@ std::set<std::string> RoleInfo::getTags(const Role& role) const
 
 bool RoleInfo::hasTag(const Role& role) const
 {
-    std::set<std::string> tags;
-    for(const std::pair<std::string, Role::Set>& p : mTaggedRoles)
-    {
-        const Role::Set& roles = p.second;
-        if(roles.end() != std::find(roles.begin(), roles.end(), role))
-        {
-            return true;
-        }
-    }
-    return false;
+    return !getTags(role).empty();
 }
 
 const Role& RoleInfo::getRole(const owlapi::model::IRI& model, uint32_t id) const
 {
-    Role::Set::const_iterator cit;
-    cit = std::find_if(mAllRoles.begin(), mAllRoles.end(), [&model,id](const Role& other)
-            {
-                return other.getModel() == model && other.getId() == id;
-            });
-    if(cit != mAllRoles.end())
+    size_t roleId;
+    if(findId(Role(id, model), roleId) && mAllRoles.bits.test(roleId))
     {
-        return *cit;
+        return mIndexedRoles[roleId];
     }
 
     throw std::invalid_argument("templ::RoleInfo::getRole: could not find role: " +
@@ -251,47 +349,12 @@ const Role& RoleInfo::getRole(const owlapi::model::IRI& model, uint32_t id) cons
 
 Role::List RoleInfo::getRelativeComplement(const std::string& tag0, const std::string& tag1) const
 {
-    std::set<Role> tag0Roles = getRoles(tag0);
-    std::set<Role> tag1Roles = getRoles(tag1);
-    std::vector<Role> delta(tag0Roles.begin(), tag0Roles.end());
-
-    for(size_t r0 = 0; r0 < delta.size();)
-    {
-        bool found = false;
-        for(const Role& tag1Role : tag1Roles)
-        {
-            if( delta[r0] == tag1Role)
-            {
-                delta.erase( delta.begin() + r0);
-                found = true;
-                break;
-            }
-        }
-        if(!found)
-        {
-            ++r0;
-        }
-    }
-
-    return delta;
+    return toList(getRoleSet(tag0).bits - getRoleSet(tag1).bits);
 }
 
-
 Role::List RoleInfo::getIntersection(const std::string& tag0, const std::string& tag1) const
 {
-
-    std::set<Role> tag0Roles = getRoles(tag0);
-    std::set<Role> tag1Roles = getRoles(tag1);
-
-    Role::List result(tag0Roles.size() + tag1Roles.size());
-    Role::List::iterator it;
-
-    it = std::set_intersection(tag0Roles.begin(), tag0Roles.end(),
-            tag1Roles.begin(),
-            tag1Roles.end(), result.begin());
-
-    result.resize(it - result.begin());
-    return result;
+    return toList(getRoleSet(tag0).bits & getRoleSet(tag1).bits);
 }
 
 Role::List RoleInfo::getIntersection(const Role::Set& set0, const Role::Set& set1)
@@ -309,26 +372,60 @@ Role::List RoleInfo::getIntersection(const Role::Set& set0, const Role::Set& set
 
 Role::List RoleInfo::getSymmetricDifference(const std::string& tag0, const std::string& tag1) const
 {
+    return toList(getRoleSet(tag0).bits ^ getRoleSet(tag1).bits);
+}
 
-    std::set<Role> tag0Roles = getRoles(tag0);
-    std::set<Role> tag1Roles = getRoles(tag1);
+std::map<std::string, Role::Set> RoleInfo::getTaggedRoles() const
+{
+    std::map<std::string, Role::Set> taggedRoles;
+    for(const std::pair<const Tag, std::string>& p : TagTxt)
+    {
+        if(!mTaggedRoles[p.first].roles.empty())
+        {
+            taggedRoles[p.second] = mTaggedRoles[p.first].roles;
+        }
+    }
+    for(const std::pair<const std::string, RoleSet>& p : mCustomTaggedRoles)
+    {
+        if(!p.second.roles.empty())
+        {
+            taggedRoles[p.first] = p.second.roles;
+        }
+    }
+    return taggedRoles;
+}
 
-    Role::List result(tag0Roles.size() + tag1Roles.size());
-    Role::List::iterator it;
+void RoleInfo::setRoles(const Role::Set& roles)
+{
+    assign(mRoles, roles);
+}
 
-    it = std::set_symmetric_difference(tag0Roles.begin(), tag0Roles.end(),
-            tag1Roles.begin(),
-            tag1Roles.end(), result.begin());
+void RoleInfo::setTaggedRoles(const std::map<std::string, Role::Set>& taggedRoles)
+{
+    for(RoleSet& roleSet : mTaggedRoles)
+    {
+        roleSet.bits.clear();
+        roleSet.roles.clear();
+    }
+    mCustomTaggedRoles.clear();
 
-    result.resize(it - result.begin());
-    return result;
+    for(const std::pair<const std::string, Role::Set>& p : taggedRoles)
+    {
+        assign(getRoleSet(p.first), p.second);
+    }
 }
 
 void RoleInfo::clear()
 {
-    mAllRoles.clear();
-    mRoles.clear();
-    mTaggedRoles.clear();
+    mIndexedRoles.clear();
+    mRoleIds.clear();
+    mAllRoles = RoleSet();
+    mRoles = RoleSet();
+    for(RoleSet& roleSet : mTaggedRoles)
+    {
+        roleSet = RoleSet();
+    }
+    mCustomTaggedRoles.clear();
 }
 
 void RoleInfo::setAttribute(const std::string& attributeName, double value)
@@ -2,13 +2,22 @@
 #define TEMPL_ROLE_INFO_HPP
 
 #include <set>
+#include <map>
+#include <array>
 #include "SharedPtr.hpp"
 #include "Role.hpp"
+#include "RoleBitset.hpp"
 
 namespace templ {
 
 /**
  * Allow to collect related roles into a single object
+ *
+ * Roles are assigned a local id on first use, and each tag has its own
+ * bitset over these ids, so that set operations between tags are performed
+ * on words instead of ordered sets of roles.
+ * The ordered sets are maintained alongside the bitsets by all modifying
+ * functions, so that the const accessors do not modify the object
  */
 class RoleInfo
 {
@@ -41,6 +50,16 @@ public:
     static std::map<Tag, std::string> TagTxt;
     static std::map<Attribute, std::string> AttributeTxt;
 
+    /// Number of tags (including UNKNOWN)
+    static const size_t NUMBER_OF_TAGS = INFEASIBLE + 1;
+
+    /**
+     * Get the tag from its textual representation
+     * \return the tag, or UNKNOWN if the text is not one of the predefined
+     * tags
+     */
+    static Tag getTag(const std::string& tag);
+
     RoleInfo();
 
     void addRole(const Role& role, const Tag& tag);
@@ -65,6 +84,26 @@ public:
 
     const std::set<Role>& getAllRoles() const;
 
+    /**
+     * Get the untagged roles as bitset
+     */
+    const RoleBitset& getRoleBits() const { return mRoles.bits; }
+
+    /**
+     * Get the roles with the given tag as bitset
+     */
+    const RoleBitset& getRoleBits(const Tag& tag) const { return mTaggedRoles[tag].bits; }
+
+    /**
+     * Get all roles (tagged and untagged) as bitset
+     */
+    const RoleBitset& getAllRoleBits() const { return mAllRoles.bits; }
+
+    /**
+     * Check if all roles with the tag subset also have the tag superset
+     */
+    bool includes(const Tag& superset, const Tag& subset) const { return mTaggedRoles[superset].bits.includes(mTaggedRoles[subset].bits); }
+
     /**
      * Get the status a particular role
      */
@@ -104,11 +143,15 @@ public:
      */
     Role::List getRelativeComplement(const std::string& tag0, const std::string& tag1) const;
 
+    Role::List getRelativeComplement(const Tag& tag0, const Tag& tag1) const { return toList(mTaggedRoles[tag0].bits - mTaggedRoles[tag1].bits); }
+
     /**
      * Get intersection between tag0 and tag1 set
      */
     Role::List getIntersection(const std::string& tag0, const std::string& tag1) const;
 
+    Role::List getIntersection(const Tag& tag0, const Tag& tag1) const { return toList(mTaggedRoles[tag0].bits & mTaggedRoles[tag1].bits); }
+
     static Role::List getIntersection(const Role::Set& set0, const Role::Set& set1);
 
     /**
@@ -116,6 +159,24 @@ public:
      */
     Role::List getSymmetricDifference(const std::string& tag0, const std::string& tag1) const;
 
+    Role::List getSymmetricDifference(const Tag& tag0, const Tag& tag1) const { return toList(mTaggedRoles[tag0].bits ^ mTaggedRoles[tag1].bits); }
+
+    /**
+     * Get the untagged roles and the roles per tag (textual representation),
+     * e.g., for serialization
+     */
+    std::map<std::string, Role::Set> getTaggedRoles() const;
+
+    /**
+     * Set the untagged roles
+     */
+    void setRoles(const Role::Set& roles);
+
+    /**
+     * Set the roles per tag (textual representation)
+     */
+    void setTaggedRoles(const std::map<std::string, Role::Set>& taggedRoles);
+
     void clear();
 
     std::string toString(uint32_t indent = 0) const;
@@ -133,9 +194,66 @@ public:
     double getAttribute(const std::string& attributeName) const;
 
 protected:
-    mutable std::set<Role> mAllRoles;
-    std::set<Role> mRoles;
-    mutable std::map<std::string, Role::Set> mTaggedRoles;
+    /**
+     * Roles as bitset (for set operations) and as ordered set (for access)
+     */
+    struct RoleSet
+    {
+        RoleBitset bits;
+        Role::Set roles;
+    };
+
+    /**
+     * Get the role set for a tag (textual representation), where an empty
+     * tag refers to the untagged roles
+     * \return the role set, or an empty set for an unused custom tag
+     */
+    const RoleSet& getRoleSet(const std::string& tag) const;
+    RoleSet& getRoleSet(const std::string& tag);
+
+    /**
+     * Get the local id of a role, where the role is indexed if it is not yet
+     * known
+     */
+    size_t getId(const Role& role);
+
+    /**
+     * Find the local id of a role without indexing the role
+     * \return true if the role is known, false otherwise
+     */
+    bool findId(const Role& role, size_t& id) const;
+
+    /**
+     * Add a role to the role set and to the set of all roles
+     */
+    void insert(RoleSet& roleSet, const Role& role);
+
+    /**
+     * Remove a role from the role set
+     */
+    void erase(RoleSet& roleSet, const Role& role);
+
+    /**
+     * Replace the roles of the role set and add them to the set of all roles
+     */
+    void assign(RoleSet& roleSet, const Role::Set& roles);
+
+    /**
+     * Get the roles of a bitset in the order of the role set
+     */
+    Role::List toList(const RoleBitset& bits) const;
+
+    /// Roles by local id, the index only grows with the roles that have been
+    /// added to this object and is reset by clear()
+    Role::List mIndexedRoles;
+    std::map<Role, size_t> mRoleIds;
+
+    /// Roles that have been added (without considering removal)
+    RoleSet mAllRoles;
+    RoleSet mRoles;
+    std::array<RoleSet, NUMBER_OF_TAGS> mTaggedRoles;
+    /// Roles with tags that are not part of Tag
+    std::map<std::string, RoleSet> mCustomTaggedRoles;
     std::map<std::string, double> mAttributes;
 };
 
@@ -85,7 +85,8 @@ public:
     {
         std::stringstream ss;
         boost::archive::text_oarchive oarch(ss);
-        oarch << mRoles;
+        const Role::Set& roles = getRoles();
+        oarch << roles;
         return ss.str();
     }
 
@@ -94,7 +95,9 @@ public:
         std::stringstream ss;
         ss << s;
         boost::archive::text_iarchive iarch(ss);
-        iarch >> mRoles;
+        Role::Set roles;
+        iarch >> roles;
+        setRoles(roles);
     }
 
     // Serialization
@@ -103,7 +106,8 @@ public:
     {
         std::stringstream ss;
         boost::archive::text_oarchive oarch(ss);
-        oarch << mTaggedRoles;
+        const std::map<std::string, Role::Set> taggedRoles = getTaggedRoles();
+        oarch << taggedRoles;
         return ss.str();
     }
 
@@ -112,7 +116,9 @@ public:
         std::stringstream ss;
         ss << s;
         boost::archive::text_iarchive iarch(ss);
-        iarch >> mTaggedRoles;
+        std::map<std::string, Role::Set> taggedRoles;
+        iarch >> taggedRoles;
+        setTaggedRoles(taggedRoles);
     }
 
     std::string serializeRoleInfoAttributes()
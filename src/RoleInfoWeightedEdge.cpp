@@ -63,7 +63,8 @@ std::string RoleInfoWeightedEdge::serializeRoles()
 {
     std::stringstream ss;
     boost::archive::text_oarchive oarch(ss);
-    oarch << mRoles;
+    const Role::Set& roles = getRoles();
+    oarch << roles;
     return ss.str();
 }
 
@@ -71,7 +72,8 @@ std::string RoleInfoWeightedEdge::serializeTaggedRoles()
 {
     std::stringstream ss;
     boost::archive::text_oarchive oarch(ss);
-    oarch << mTaggedRoles;
+    const std::map<std::string, Role::Set> taggedRoles = getTaggedRoles();
+    oarch << taggedRoles;
     return ss.str();
 }
 
@@ -80,7 +82,9 @@ void RoleInfoWeightedEdge::deserializeRoles(const std::string& s)
     std::stringstream ss;
     ss << s;
     boost::archive::text_iarchive iarch(ss);
-    iarch >> mRoles;
+    Role::Set roles;
+    iarch >> roles;
+    setRoles(roles);
 }
 
 void RoleInfoWeightedEdge::deserializeTaggedRoles(const std::string& s)
@@ -88,7 +92,9 @@ void RoleInfoWeightedEdge::deserializeTaggedRoles(const std::string& s)
     std::stringstream ss;
     ss << s;
     boost::archive::text_iarchive iarch(ss);
-    iarch >> mTaggedRoles;
+    std::map<std::string, Role::Set> taggedRoles;
+    iarch >> taggedRoles;
+    setTaggedRoles(taggedRoles);
 }
 
 }  // end namespace templ
@@ -11,6 +11,10 @@ SpaceTimeNetwork::SpaceTimeNetwork(const SpaceTimeNetwork& other)
     , mTimepoints(other.mTimepoints)
     , mpLocalTransitionEdge(other.mpLocalTransitionEdge)
     , mTupleMap(other.mTupleMap)
+    , mTupleIndex(other.mTupleIndex)
+    , mColumns(other.mColumns)
+    , mRows(other.mRows)
+    , mTimepointAliases(other.mTimepointAliases)
 {
     if(other.mpGraph)
     {
@@ -50,12 +54,26 @@ SpaceTimeNetwork::SpaceTimeNetwork(const ValueList& values,
         weightedEdge->setWeight(std::numeric_limits<graph_analysis::WeightedEdge::value_t>::max());
         mpLocalTransitionEdge = weightedEdge;
     }
+    updateIndices();
     initialize();
 }
 
 SpaceTimeNetwork::~SpaceTimeNetwork()
 {}
 
+SpaceTimeNetwork SpaceTimeNetwork::clone() const
+{
+    SpaceTimeNetwork network(*this);
+    network.mTupleMap.clear();
+    network.mTupleIndex.clear();
+    if(mpGraph)
+    {
+        network.mpGraph = mpGraph->clone();
+        network.reconstructTupleMap();
+    }
+    return network;
+}
+
 // Construction of the basic time-expanded network
 //
 // (t0,v0)    (t0,v1)
@@ -77,7 +95,7 @@ void SpaceTimeNetwork::initialize()
             typename tuple_t::Ptr currentTuple(new tuple_t(*lit, *tit));
             mpGraph->addVertex(currentTuple);
 
-            mTupleMap[ ValueTimePair(*lit, *tit) ] = currentTuple;
+            registerTuple(*lit, *tit, currentTuple);
 
             if(previousTuple)
             {
@@ -103,7 +121,7 @@ void SpaceTimeNetwork::reconstructTupleMap()
     while(vertexIt->next())
     {
         typename tuple_t::Ptr currentTuple = dynamic_pointer_cast<tuple_t>( vertexIt->current() );
-        mTupleMap[ ValueTimePair(currentTuple->first(), currentTuple->second()) ] = currentTuple;
+        registerTuple(currentTuple->first(), currentTuple->second(), currentTuple);
     }
 }
 
@@ -111,7 +129,48 @@ void SpaceTimeNetwork::addTuple(const value_t& value,
         const timepoint_t& timepoint,
         const typename tuple_t::Ptr& tuple)
 {
-    mTupleMap[ ValueTimePair(value, timepoint) ] = tuple;
+    registerTuple(value, timepoint, tuple);
+}
+
+void SpaceTimeNetwork::registerTuple(const value_t& value,
+        const timepoint_t& timepoint,
+        const typename tuple_t::Ptr& tuple)
+{
+    ValueTimePair valueTimePair(value, timepoint);
+    typename tuple_t::Ptr& entry = mTupleMap[valueTimePair];
+    if(entry && entry != tuple)
+    {
+        // the replaced tuple is no longer part of the network
+        mTupleIndex.erase(entry.get());
+    }
+    entry = tuple;
+    mTupleIndex[tuple.get()] = valueTimePair;
+}
+
+void SpaceTimeNetwork::updateIndices()
+{
+    mColumns.clear();
+    for(size_t i = 0; i < mValues.size(); ++i)
+    {
+        // keep the first occurrence
+        mColumns.insert(std::make_pair(mValues[i], i));
+    }
+
+    mRows.clear();
+    for(size_t i = 0; i < mTimepoints.size(); ++i)
+    {
+        mRows.insert(std::make_pair(mTimepoints[i], i));
+    }
+}
+
+const SpaceTimeNetwork::timepoint_t& SpaceTimeNetwork::resolveTimepoint(const timepoint_t& timepoint) const
+{
+    TimepointAliases::const_iterator ait = mTimepointAliases.find(timepoint);
+    if(ait != mTimepointAliases.end())
+    {
+        return ait->second;
+    }
+    return timepoint;
 }
 
 /**
@@ -128,6 +187,16 @@ typename SpaceTimeNetwork::tuple_t::Ptr SpaceTimeNetwork::tupleByKeys(const valu
         return cit->second;
     }
 
+    TimepointAliases::const_iterator ait = mTimepointAliases.find(timepoint);
+    if(ait != mTimepointAliases.end())
+    {
+        cit = mTupleMap.find( ValueTimePair(value, ait->second) );
+        if(cit != mTupleMap.end())
+        {
+            return cit->second;
+        }
+    }
+
     throw std::invalid_argument("SpaceTimeNetwork::tupleByKeys: key does not exist");
 }
 
@@ -177,6 +246,7 @@ SpaceTimeNetwork SpaceTimeNetwork::fromFile(const std::string& filename, const s
 
     network.mValues = values;
     network.mTimepoints = timepoints;
+    network.updateIndices();
     network.reconstructTupleMap();
 
     return network;
@@ -224,6 +294,7 @@ SpaceTimeNetwork SpaceTimeNetwork::fromGraph(const graph_analysis::BaseGraph::Pt
 
     network.mValues = values;
     network.mTimepoints = timepoints;
+    network.updateIndices();
     network.reconstructTupleMap();
 
     return network;
@@ -231,15 +302,10 @@ SpaceTimeNetwork SpaceTimeNetwork::fromGraph(const graph_analysis::BaseGraph::Pt
 
 const SpaceTimeNetwork::ValueTimePair& SpaceTimeNetwork::getValueTimePair(const typename tuple_t::Ptr& searchTuple) const
 {
-    typename TupleMap::const_iterator cit = mTupleMap.begin();
-    for(; cit != mTupleMap.end(); ++cit)
+    typename TupleIndex::const_iterator cit = mTupleIndex.find(searchTuple.get());
+    if(cit != mTupleIndex.end())
     {
-        const ValueTimePair& valueTimePair = cit->first;
-        typename tuple_t::Ptr tuple = cit->second;
-        if(tuple ==  searchTuple)
-        {
-            return valueTimePair;
-        }
+        return cit->second;
     }
     throw std::invalid_argument("templ::SpaceTimeNetwork::getValueTimePair: could not find provided tuple in network");
 }
@@ -259,11 +325,12 @@ size_t SpaceTimeNetwork::getColumn(const graph_analysis::Vertex::Ptr& vertex) co
     typename tuple_t::Ptr tuple = dynamic_pointer_cast<tuple_t>(vertex);
     const value_t& value = getValue(tuple);
 
-    typename ValueList::const_iterator cit = std::find_if(mValues.begin(), mValues.end(), [value](const value_t& other)
-            {
-                return value == other;
-            });
-    return std::distance(mValues.begin(), cit);
+    ColumnIndex::const_iterator cit = mColumns.find(value);
+    if(cit != mColumns.end())
+    {
+        return cit->second;
+    }
+    return mValues.size();
 }
 
 size_t SpaceTimeNetwork::getRow(const graph_analysis::Vertex::Ptr& vertex) const
@@ -271,11 +338,12 @@ size_t SpaceTimeNetwork::getRow(const graph_analysis::Vertex::Ptr& vertex) const
     typename tuple_t::Ptr tuple = dynamic_pointer_cast<tuple_t>(vertex);
     const timepoint_t& timepoint = getTimepoint(tuple);
 
-    typename TimePointList::const_iterator cit = std::find_if(mTimepoints.begin(), mTimepoints.end(), [timepoint](const timepoint_t& other)
-            {
-                return timepoint == other;
-            });
-    return std::distance(mTimepoints.begin(), cit);
+    RowIndex::const_iterator cit = mRows.find(timepoint);
+    if(cit != mRows.end())
+    {
+        return cit->second;
+    }
+    return mTimepoints.size();
 }
 
 /**
@@ -283,6 +351,20 @@ size_t SpaceTimeNetwork::getRow(const graph_analysis::Vertex::Ptr& vertex) const
  */
 SpaceTimeNetwork::TimePointList SpaceTimeNetwork::getTimepoints(const timepoint_t& t_start, const timepoint_t& t_end) const
 {
+    RowIndex::const_iterator startIt = mRows.find(resolveTimepoint(t_start));
+    RowIndex::const_iterator endIt = mRows.find(resolveTimepoint(t_end));
+    if(startIt != mRows.end() && endIt != mRows.end())
+    {
+        if(startIt->second > endIt->second)
+        {
+            return TimePointList();
+        }
+        return TimePointList(mTimepoints.begin() + startIt->second,
+                mTimepoints.begin() + endIt->second + 1);
+    }
+
+    // Fall back to the comparison of timepoints which are not part of this
+    // network
     TimePointList timepoints;
     bool startFound = false;
     bool endFound = false;
@@ -2,7 +2,9 @@
 #define TEMPL_SPACE_TIME_NETWORK_HPP
 
 #include <limits>
+#include <map>
 #include <vector>
+#include <unordered_map>
 #include <stdexcept>
 #include <algorithm>
 #include <graph_analysis/BaseGraph.hpp>
@@ -48,6 +50,40 @@ protected:
     typedef typename tuple_t::PtrList TuplePtrList;
     TupleMap mTupleMap;
 
+    /// reverse index: tuple --> key-value
+    typedef std::unordered_map<const tuple_t*, ValueTimePair> TupleIndex;
+    TupleIndex mTupleIndex;
+    /// reverse index: value --> column, i.e. position in the list of values
+    typedef std::unordered_map<value_t, size_t> ColumnIndex;
+    ColumnIndex mColumns;
+    /// reverse index: timepoint --> row, i.e. position in the list of timepoints
+    typedef std::unordered_map<timepoint_t, size_t> RowIndex;
+    RowIndex mRows;
+    /// timepoints which are not part of the network, but are represented
+    /// by one of its timepoints
+    typedef std::map<timepoint_t, timepoint_t> TimepointAliases;
+    TimepointAliases mTimepointAliases;
+
+    /**
+     * Register a tuple in the tuple map and the reverse index
+     */
+    void registerTuple(const value_t& value,
+            const timepoint_t& timepoint,
+            const typename tuple_t::Ptr& tuple);
+
+    /**
+     * Rebuild the column and row index from the list of values and
+     * timepoints
+     */
+    void updateIndices();
+
+    /**
+     * Resolve a timepoint alias
+     * \return the representing timepoint, or the given timepoint if it is
+     * not an alias
+     */
+    const timepoint_t& resolveTimepoint(const timepoint_t& timepoint) const;
+
 public:
     SpaceTimeNetwork();
     SpaceTimeNetwork(const SpaceTimeNetwork& other);
@@ -67,6 +103,14 @@ public:
 
     virtual ~SpaceTimeNetwork();
 
+    /**
+     * Create a deep copy of this network
+     * \details The copy constructor shares tuples and edges with the original
+     * network, while the clone uses copies of them, so that their attributes
+     * can be modified independently
+     */
+    SpaceTimeNetwork clone() const;
+
     /**
      * Set the edge that has to be assigned for all transitions between same
      * types of the first dimension
@@ -105,6 +149,20 @@ public:
             const timepoint_t& timepoint,
             const typename tuple_t::Ptr& tuple);
 
+    /**
+     * Register a timepoint, which is represented by a timepoint of this
+     * network, so that tuples can be retrieved using either of them
+     * \param alias Timepoint which is not part of the network
+     * \param timepoint Timepoint of the network representing the alias
+     */
+    void addTimepointAlias(const timepoint_t& alias, const timepoint_t& timepoint) { mTimepointAliases[alias] = timepoint; }
+
+    /**
+     * Get the registered timepoint aliases
+     * \return map from alias to representing timepoint
+     */
+    const TimepointAliases& getTimepointAliases() const { return mTimepointAliases; }
+
     /**
      * Retrieve a tuple (actually a graph vertex) by the given key tuple
      * \param value
@@ -3,6 +3,7 @@
 
 #include <limits>
 #include <vector>
+#include <unordered_map>
 #include <stdexcept>
 #include <algorithm>
 #include <graph_analysis/BaseGraph.hpp>
@@ -55,6 +56,52 @@ protected:
     typedef typename tuple_t::PtrList TuplePtrList;
     TupleMap mTupleMap;
 
+    /// reverse index: tuple --> key-value
+    typedef std::unordered_map<const tuple_t*, ValueTimePair> TupleIndex;
+    TupleIndex mTupleIndex;
+    /// reverse index: value --> column, i.e. position in the list of values
+    typedef std::unordered_map<D0, size_t> ColumnIndex;
+    ColumnIndex mColumns;
+    /// reverse index: timepoint --> row, i.e. position in the list of timepoints
+    typedef std::unordered_map<D1, size_t> RowIndex;
+    RowIndex mRows;
+
+    /**
+     * Register a tuple in the tuple map and the reverse index
+     */
+    void registerTuple(const D0& value, const D1& timepoint, const typename tuple_t::Ptr& tuple)
+    {
+        ValueTimePair valueTimePair(value, timepoint);
+        typename tuple_t::Ptr& entry = mTupleMap[valueTimePair];
+        if(entry && entry != tuple)
+        {
+            // the replaced tuple is no longer part of the network
+            mTupleIndex.erase(entry.get());
+        }
+        entry = tuple;
+        mTupleIndex[tuple.get()] = valueTimePair;
+    }
+
+    /**
+     * Rebuild the column and row index from the list of values and
+     * timepoints
+     */
+    void updateIndices()
+    {
+        mColumns.clear();
+        for(size_t i = 0; i < mValues.size(); ++i)
+        {
+            // keep the first occurrence
+            mColumns.insert(std::make_pair(mValues[i], i));
+        }
+
+        mRows.clear();
+        for(size_t i = 0; i < mTimepoints.size(); ++i)
+        {
+            mRows.insert(std::make_pair(mTimepoints[i], i));
+        }
+    }
+
 public:
     TemporallyExpandedNetwork()
         : mpGraph( graph_analysis::BaseGraph::getInstance() )
@@ -65,6 +112,9 @@ public:
         , mTimepoints(other.mTimepoints)
         , mpLocalTransitionEdge(other.mpLocalTransitionEdge)
         , mTupleMap(other.mTupleMap)
+        , mTupleIndex(other.mTupleIndex)
+        , mColumns(other.mColumns)
+        , mRows(other.mRows)
     {
         if(other.mpGraph)
         {
@@ -104,6 +154,7 @@ public:
             weightedEdge->setWeight(std::numeric_limits<graph_analysis::WeightedEdge::value_t>::max());
             mpLocalTransitionEdge = weightedEdge;
         }
+        updateIndices();
         initialize();
     }
 
@@ -136,7 +187,7 @@ public:
                 typename tuple_t::Ptr currentTuple(new tuple_t(*lit, *tit));
                 mpGraph->addVertex(currentTuple);
 
-                mTupleMap[ ValueTimePair(*lit, *tit) ] = currentTuple;
+                registerTuple(*lit, *tit, currentTuple);
 
                 if(previousTuple)
                 {
@@ -162,7 +213,7 @@ public:
         while(vertexIt->next())
         {
             typename tuple_t::Ptr currentTuple = dynamic_pointer_cast<tuple_t>( vertexIt->current() );
-            mTupleMap[ ValueTimePair(currentTuple->first(), currentTuple->second()) ] = currentTuple;
+            registerTuple(currentTuple->first(), currentTuple->second(), currentTuple);
         }
     }
 
@@ -181,7 +232,7 @@ public:
 
     void addTuple(const D0& value, const D1& timepoint, const typename tuple_t::Ptr& tuple)
     {
-        mTupleMap[ ValueTimePair(value, timepoint) ] = tuple;
+        registerTuple(value, timepoint, tuple);
     }
 
     /**
@@ -246,6 +297,7 @@ public:
 
         network.mValues = values;
         network.mTimepoints = timepoints;
+        network.updateIndices();
         network.reconstructTupleMap();
 
         return network;
@@ -293,6 +345,7 @@ public:
 
         network.mValues = values;
         network.mTimepoints = timepoints;
+        network.updateIndices();
         network.reconstructTupleMap();
 
         return network;
@@ -300,15 +353,10 @@ public:
 
     const ValueTimePair& getValueTimePair(const typename tuple_t::Ptr& searchTuple) const
     {
-        typename TupleMap::const_iterator cit = mTupleMap.begin();
-        for(; cit != mTupleMap.end(); ++cit)
+        typename TupleIndex::const_iterator cit = mTupleIndex.find(searchTuple.get());
+        if(cit != mTupleIndex.end())
         {
-            const ValueTimePair& valueTimePair = cit->first;
-            typename tuple_t::Ptr tuple = cit->second;
-            if(tuple ==  searchTuple)
-            {
-                return valueTimePair;
-            }
+            return cit->second;
         }
         throw std::invalid_argument("templ::TemporallyExpandedNetwork::getValueTimePair: could not find provided tuple in network");
     }
@@ -328,11 +376,12 @@ public:
         typename tuple_t::Ptr tuple = dynamic_pointer_cast<tuple_t>(vertex);
         const D0& value = getValue(tuple);
 
-        typename ValueList::const_iterator cit = std::find_if(mValues.begin(), mValues.end(), [value](const D0& other)
-                {
-                    return value == other;
-                });
-        return std::distance(mValues.begin(), cit);
+        typename ColumnIndex::const_iterator cit = mColumns.find(value);
+        if(cit != mColumns.end())
+        {
+            return cit->second;
+        }
+        return mValues.size();
     }
 
     size_t getRow(const graph_analysis::Vertex::Ptr& vertex) const
@@ -340,11 +389,12 @@ public:
         typename tuple_t::Ptr tuple = dynamic_pointer_cast<tuple_t>(vertex);
         const D1& timepoint = getTimepoint(tuple);
 
-        typename TimePointList::const_iterator cit = std::find_if(mTimepoints.begin(), mTimepoints.end(), [timepoint](const D1& other)
-                {
-                    return timepoint == other;
-                });
-        return std::distance(mTimepoints.begin(), cit);
+        typename RowIndex::const_iterator cit = mRows.find(timepoint);
+        if(cit != mRows.end())
+        {
+            return cit->second;
+        }
+        return mTimepoints.size();
     }
 
     /**
@@ -352,6 +402,20 @@ public:
      */
     TimePointList getTimepoints(const timepoint_t& t_start, const timepoint_t& t_end) const
     {
+        typename RowIndex::const_iterator startIt = mRows.find(t_start);
+        typename RowIndex::const_iterator endIt = mRows.find(t_end);
+        if(startIt != mRows.end() && endIt != mRows.end())
+        {
+            if(startIt->second > endIt->second)
+            {
+                return TimePointList();
+            }
+            return TimePointList(mTimepoints.begin() + startIt->second,
+                    mTimepoints.begin() + endIt->second + 1);
+        }
+
+        // Fall back to the comparison of timepoints which are not part of this
+        // network
         TimePointList timepoints;
         bool startFound = false;
         bool endFound = false;
@@ -8,6 +8,7 @@
 #include <qxcfg/Configuration.hpp>
 #include "../SpaceTime.hpp"
 #include "../solvers/transshipment/MinCostFlow.hpp"
+#include "../solvers/CoalitionFeasibilityCache.hpp"
 #include "../constraints/ModelConstraint.hpp"
 #include "../DataPropertyAssignment.hpp"
 
@@ -664,7 +665,8 @@ SpaceTime::Network MissionGenerator::generateNetwork()
                                     RoleInfo::AVAILABLE});
 
                             pool[role.getModel()] += 1;
-                            moreorg::ModelPool::List coalitionStructure = ask.findFeasibleCoalitionStructure(pool,moveToResource, 1);
+                            moreorg::ModelPool::List coalitionStructure =
+                                solvers::CoalitionFeasibilityCache::getInstance().findFeasibleCoalitionStructure(ask, pool, moveToResource, 1);
                             if(!coalitionStructure.empty())
                             {
                                 candidates.push_back(value);
@@ -0,0 +1,287 @@
+#include "CoalitionFeasibilityCache.hpp"
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <boost/filesystem.hpp>
+#include <owlapi/io/OWLOntologyIO.hpp>
+#include <base/Time.hpp>
+#include <base-logging/Logging.hpp>
+
+namespace templ {
+namespace solvers {
+
+CoalitionFeasibilityCache::Result::Result()
+    : status(INFEASIBLE)
+    , timeoutInMs(0)
+{}
+
+CoalitionFeasibilityCache::OrganizationModelInfo::OrganizationModelInfo()
+    : hasKey(false)
+{}
+
+CoalitionFeasibilityCache::CoalitionFeasibilityCache()
+    : mHits(0)
+    , mMisses(0)
+{}
+
+CoalitionFeasibilityCache& CoalitionFeasibilityCache::getInstance()
+{
+    static CoalitionFeasibilityCache cache;
+    return cache;
+}
+
+moreorg::ModelPool::List CoalitionFeasibilityCache::findFeasibleCoalitionStructure(moreorg::OrganizationModelAsk& ask,
+        const moreorg::ModelPool& modelPool,
+        const moreorg::Resource::Set& resources,
+        double timeoutInMs)
+{
+    Key key = computeKey(ask, modelPool, resources);
+    Result result;
+    if(get(key, timeoutInMs, result))
+    {
+        return result.coalitionStructure;
+    }
+
+    // The lock is not held during the search, so that concurrent queries
+    // for the same key might both perform the search
+    base::Time start = base::Time::now();
+    result.coalitionStructure = ask.findFeasibleCoalitionStructure(modelPool, resources, timeoutInMs);
+    double elapsedInMs = (base::Time::now() - start).toMilliseconds();
+
+    result.timeoutInMs = timeoutInMs;
+    if(!result.coalitionStructure.empty())
+    {
+        result.status = FEASIBLE;
+    } else if(elapsedInMs >= timeoutInMs)
+    {
+        result.status = TIMEOUT;
+    } else {
+        result.status = INFEASIBLE;
+    }
+    put(key, result);
+
+    return result.coalitionStructure;
+}
+
+CoalitionFeasibilityCache::Key CoalitionFeasibilityCache::computeKey(const moreorg::OrganizationModelAsk& ask,
+        const moreorg::ModelPool& modelPool,
+        const moreorg::Resource::Set& resources)
+{
+    Key organizationModelKey = getOrganizationModelKey(ask.getOrganizationModel());
+    Key key;
+    key.update(organizationModelKey.first);
+    key.update(organizationModelKey.second);
+
+    // Canonical model pool: ordered by model, without zero entries
+    for(const moreorg::ModelPool::value_type& p : modelPool)
+    {
+        if(p.second != 0)
+        {
+            key.update(p.first.toString());
+            key.update(p.second);
+        }
+    }
+    // separate pool and resources
+    key.update(0xffffffffffffffffULL);
+    for(const moreorg::Resource& resource : resources)
+    {
+        // includes the property constraints of the resource
+        key.update(resource.toString());
+    }
+    return key;
+}
+
+void CoalitionFeasibilityCache::registerOrganizationModel(const moreorg::OrganizationModel::Ptr& organizationModel,
+        const DataPropertyAssignment::List& overrides)
+{
+    std::lock_guard<std::mutex> lock(mOrganizationModelsMutex);
+    OrganizationModelInfo info;
+    info.overrides = overrides;
+    mOrganizationModels[organizationModel] = info;
+}
+
+CoalitionFeasibilityCache::Key CoalitionFeasibilityCache::getOrganizationModelKey(const moreorg::OrganizationModel::Ptr& organizationModel)
+{
+    std::lock_guard<std::mutex> lock(mOrganizationModelsMutex);
+    OrganizationModelInfo& info = mOrganizationModels[organizationModel];
+    if(!info.hasKey)
+    {
+        info.key = computeOrganizationModelKey(organizationModel, info.overrides);
+        info.hasKey = true;
+    }
+    return info.key;
+}
+
+CoalitionFeasibilityCache::Key CoalitionFeasibilityCache::computeOrganizationModelKey(const moreorg::OrganizationModel::Ptr& organizationModel,
+        const DataPropertyAssignment::List& overrides)
+{
+    Key key;
+    key.update(organizationModel->ontology()->getIRI().toString());
+
+    // Content of the ontology, as serialized to file
+    namespace fs = boost::filesystem;
+    fs::path filename = fs::temp_directory_path() / fs::unique_path("templ-coalition-feasibility-%%%%-%%%%-%%%%.owl");
+    owlapi::io::OWLOntologyIO::write(filename.string(), organizationModel->ontology(), owlapi::io::RDFXML);
+    {
+        std::ifstream in(filename.string());
+        if(!in.is_open())
+        {
+            throw std::runtime_error("templ::solvers::CoalitionFeasibilityCache::computeOrganizationModelKey: failed to serialize organization model to '" + filename.string() + "'");
+        }
+        std::stringstream content;
+        content << in.rdbuf();
+        key.update(content.str());
+    }
+    fs::remove(filename);
+
+    key.update(overrides.size());
+    for(const DataPropertyAssignment& assignment : overrides)
+    {
+        key.update(assignment.getSubject().toString());
+        key.update(assignment.getPredicate().toString());
+        std::ostringstream value;
+        value.precision(17);
+        value << assignment.getValue();
+        key.update(value.str());
+    }
+    return key;
+}
+
+bool CoalitionFeasibilityCache::get(const Key& key, double timeoutInMs, Result& result)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    std::unordered_map<Key, Result>::const_iterator cit = mEntries.find(key);
+    if(cit != mEntries.end())
+    {
+        const Result& cached = cit->second;
+        // A timeout might be resolved with a longer timeout
+        if(cached.status != TIMEOUT || cached.timeoutInMs >= timeoutInMs)
+        {
+            result = cached;
+            ++mHits;
+            return true;
+        }
+    }
+    ++mMisses;
+    return false;
+}
+
+void CoalitionFeasibilityCache::put(const Key& key, const Result& result)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mEntries[key] = result;
+}
+
+void CoalitionFeasibilityCache::save(const std::string& filename) const
+{
+    std::ofstream out(filename);
+    if(!out.is_open())
+    {
+        throw std::runtime_error("templ::solvers::CoalitionFeasibilityCache::save: failed to open '" + filename + "'");
+    }
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    out << "# <key-first> <key-second> <status> <timeout-in-ms> <#coalitions> [<#models> [<model> <count>]*]*" << std::endl;
+    for(const std::pair<const Key, Result>& entry : mEntries)
+    {
+        const Result& result = entry.second;
+        out << entry.first.first << " " << entry.first.second << " "
+            << static_cast<int>(result.status) << " "
+            << result.timeoutInMs << " "
+            << result.coalitionStructure.size();
+        for(const moreorg::ModelPool& coalition : result.coalitionStructure)
+        {
+            out << " " << coalition.size();
+            for(const moreorg::ModelPool::value_type& p : coalition)
+            {
+                out << " " << p.first.toString() << " " << p.second;
+            }
+        }
+        out << std::endl;
+    }
+}
+
+void CoalitionFeasibilityCache::load(const std::string& filename)
+{
+    std::ifstream in(filename);
+    if(!in.is_open())
+    {
+        LOG_INFO_S << "Coalition feasibility cache '" << filename << "' does not exist yet";
+        return;
+    }
+
+    std::unordered_map<Key, Result> entries;
+    std::string line;
+    while(std::getline(in, line))
+    {
+        if(line.empty() || line[0] == '#')
+        {
+            continue;
+        }
+
+        std::istringstream ss(line);
+        Key key;
+        int status;
+        size_t numberOfCoalitions;
+        Result result;
+        ss >> key.first >> key.second >> status >> result.timeoutInMs >> numberOfCoalitions;
+        for(size_t c = 0; ss && c < numberOfCoalitions; ++c)
+        {
+            size_t numberOfModels;
+            ss >> numberOfModels;
+            moreorg::ModelPool coalition;
+            for(size_t m = 0; ss && m < numberOfModels; ++m)
+            {
+                std::string model;
+                size_t count;
+                ss >> model >> count;
+                coalition[owlapi::model::IRI(model)] = count;
+            }
+            result.coalitionStructure.push_back(coalition);
+        }
+
+        if(!ss || status < FEASIBLE || status > TIMEOUT)
+        {
+            throw std::runtime_error("templ::solvers::CoalitionFeasibilityCache::load: failed to parse line '" + line + "' of '" + filename + "'");
+        }
+        result.status = static_cast<Status>(status);
+        entries[key] = result;
+    }
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    for(const std::pair<const Key, Result>& entry : entries)
+    {
+        mEntries[entry.first] = entry.second;
+    }
+}
+
+size_t CoalitionFeasibilityCache::size() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mEntries.size();
+}
+
+void CoalitionFeasibilityCache::clear()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mEntries.clear();
+    mHits = 0;
+    mMisses = 0;
+}
+
+std::string CoalitionFeasibilityCache::toString(Status status)
+{
+    switch(status)
+    {
+        case FEASIBLE:
+            return "feasible";
+        case INFEASIBLE:
+            return "infeasible";
+        case TIMEOUT:
+            return "timeout";
+    }
+    return "unknown";
+}
+
+} // end namespace solvers
+} // end namespace templ
@@ -0,0 +1,161 @@
+#ifndef TEMPL_SOLVERS_COALITION_FEASIBILITY_CACHE_HPP
+#define TEMPL_SOLVERS_COALITION_FEASIBILITY_CACHE_HPP
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <moreorg/OrganizationModelAsk.hpp>
+#include "../utils/Hash.hpp"
+#include "../DataPropertyAssignment.hpp"
+
+namespace templ {
+namespace solvers {
+
+/**
+ * \class CoalitionFeasibilityCache
+ * \details Process-wide and thread-safe memo of the results of
+ * moreorg::OrganizationModelAsk::findFeasibleCoalitionStructure
+ *
+ * The feasibility check is a timed combinatorial search, which is performed
+ * for each transition of a candidate solution, while the same model pools
+ * recur. Entries are identified by a 128 bit content hash of the organization
+ * model (the serialized ontology and the applied data property overrides),
+ * the (canonical) model pool and the required resources including their
+ * property constraints.
+ * Infeasible results and timeouts are cached as well, where a timeout is
+ * only reused for a lookup with the same or a shorter timeout.
+ *
+ * The cache can be saved to and loaded from a file to keep the results
+ * between runs
+ */
+class CoalitionFeasibilityCache
+{
+public:
+    typedef utils::Hash128 Key;
+
+    enum Status { FEASIBLE = 0, INFEASIBLE, TIMEOUT };
+
+    struct Result
+    {
+        Result();
+
+        Status status;
+        /// Timeout that has been used for the feasibility check
+        double timeoutInMs;
+        moreorg::ModelPool::List coalitionStructure;
+    };
+
+    /**
+     * Get the process-wide instance
+     */
+    static CoalitionFeasibilityCache& getInstance();
+
+    /**
+     * Find a feasible coalition structure for the model pool, where each
+     * coalition provides the required resources
+     * \details Calls the organization model only if no reusable result is
+     * cached
+     * \return the coalition structure, or an empty list if no feasible
+     * structure exists or the check timed out
+     */
+    moreorg::ModelPool::List findFeasibleCoalitionStructure(moreorg::OrganizationModelAsk& ask,
+            const moreorg::ModelPool& modelPool,
+            const moreorg::Resource::Set& resources,
+            double timeoutInMs);
+
+    /**
+     * Compute the key for the given feasibility query
+     */
+    Key computeKey(const moreorg::OrganizationModelAsk& ask,
+            const moreorg::ModelPool& modelPool,
+            const moreorg::Resource::Set& resources);
+
+    /**
+     * Register the data property overrides which have been applied to an
+     * organization model, so that they become part of its content hash
+     * \details Resets the memoized content hash of the organization model
+     */
+    void registerOrganizationModel(const moreorg::OrganizationModel::Ptr& organizationModel,
+            const DataPropertyAssignment::List& overrides);
+
+    /**
+     * Get the content hash of an organization model
+     * \details The hash is computed once per organization model (until it
+     * is registered again)
+     * \see computeOrganizationModelKey
+     */
+    Key getOrganizationModelKey(const moreorg::OrganizationModel::Ptr& organizationModel);
+
+    /**
+     * Compute the content hash of an organization model from its serialized
+     * ontology and the given overrides
+     */
+    static Key computeOrganizationModelKey(const moreorg::OrganizationModel::Ptr& organizationModel,
+            const DataPropertyAssignment::List& overrides);
+
+    /**
+     * Lookup a cached result
+     * \param timeoutInMs Timeout of the query, so that a cached timeout is
+     * only returned if it has been obtained with at least this timeout
+     * \return true if a reusable result exists, false otherwise
+     */
+    bool get(const Key& key, double timeoutInMs, Result& result);
+
+    /**
+     * Add or replace a result
+     */
+    void put(const Key& key, const Result& result);
+
+    /**
+     * Save all entries to the given file
+     * \throws std::runtime_error if the file cannot be written
+     */
+    void save(const std::string& filename) const;
+
+    /**
+     * Add the entries from the given file, e.g., from a previous run
+     * \throws std::runtime_error if the file cannot be parsed
+     */
+    void load(const std::string& filename);
+
+    size_t size() const;
+
+    /**
+     * Remove all entries and reset statistics
+     */
+    void clear();
+
+    uint64_t getHits() const { return mHits.load(); }
+    uint64_t getMisses() const { return mMisses.load(); }
+
+    static std::string toString(Status status);
+
+private:
+    CoalitionFeasibilityCache();
+
+    mutable std::mutex mMutex;
+    std::unordered_map<Key, Result> mEntries;
+
+    struct OrganizationModelInfo
+    {
+        OrganizationModelInfo();
+
+        DataPropertyAssignment::List overrides;
+        bool hasKey;
+        Key key;
+    };
+
+    /// Content hashes of organization models (the organization models are
+    /// kept, so that their addresses cannot be reused)
+    std::mutex mOrganizationModelsMutex;
+    std::map<moreorg::OrganizationModel::Ptr, OrganizationModelInfo> mOrganizationModels;
+
+    std::atomic<uint64_t> mHits;
+    std::atomic<uint64_t> mMisses;
+};
+
+} // end namespace solvers
+} // end namespace templ
+#endif // TEMPL_SOLVERS_COALITION_FEASIBILITY_CACHE_HPP
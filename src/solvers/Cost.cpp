@@ -1,4 +1,5 @@
 #include "Cost.hpp"
+#include "CoalitionFeasibilityCache.hpp"
 #include <moreorg/facades/Robot.hpp>
 #include <moreorg/OrganizationModelAsk.hpp>
 #include <moreorg/Agent.hpp>
@@ -17,7 +18,8 @@ Cost::Cost(const moreorg::OrganizationModelAsk& organizationModelAsk,
     mMoveToResource.insert( moreorg::Resource( mobilityFunctionality ) );
 }
 
-double Cost::getTravelDistance(const symbols::constants::Location::PtrList& path)
+double Cost::getTravelDistance(const symbols::constants::Location::PtrList& path,
+        const DistanceMatrix::Ptr& distanceMatrix)
 {
     if(path.size() < 2)
     {
@@ -36,8 +38,13 @@ double Cost::getTravelDistance(const symbols::constants::Location::PtrList& path
         fromLocation = path[i];
         toLocation = path[i+1];
 
-        totalDistance +=
-            constants::Location::getDistance(*toLocation,*fromLocation);
+        if(distanceMatrix)
+        {
+            totalDistance += distanceMatrix->getDistance(toLocation, fromLocation);
+        } else {
+            totalDistance +=
+                constants::Location::getDistance(*toLocation,*fromLocation);
+        }
     }
 
     return totalDistance;
@@ -50,19 +57,21 @@ double Cost::estimateTravelTime(const symbols::constants::Location::Ptr& from,
 {
     assert(!coalition.empty());
 
-    double distance = symbols::constants::Location::getDistance(*from,*to);
+    double distance;
+    if(mpDistanceMatrix)
+    {
+        distance = mpDistanceMatrix->getDistance(from, to);
+    } else {
+        distance = symbols::constants::Location::getDistance(*from,*to);
+    }
     if(distance < 1E-06)
     {
         return 0;
     }
 
     ModelPool modelPool = Role::getModelPool(coalition);
-
-    // Identify systems that should be combined for the transport
-    ModelPool::List coalitionStructure =
-        mOrganizationModelAsk.findFeasibleCoalitionStructure(modelPool, mMoveToResource, mFeasibilityCheckTimeoutInMs);
-
-    if(coalitionStructure.empty())
+    double secondsPerMeter = getSecondsPerMeter(modelPool);
+    if(secondsPerMeter == std::numeric_limits<double>::max())
     {
         LOG_WARN_S << "Infeasible transition for model pool "
             << modelPool.toString(4)
@@ -73,17 +82,39 @@ double Cost::estimateTravelTime(const symbols::constants::Location::Ptr& from,
         return std::numeric_limits<double>::max();
     }
 
-    double minTime = 0;
-    for(const ModelPool& coalition : coalitionStructure)
+    return distance*secondsPerMeter;
+}
+
+double Cost::getSecondsPerMeter(const ModelPool& modelPool)
+{
+    std::map<ModelPool, double>::const_iterator cit = mSecondsPerMeter.find(modelPool);
+    if(cit != mSecondsPerMeter.end())
+    {
+        return cit->second;
+    }
+
+    // Identify systems that should be combined for the transport
+    ModelPool::List coalitionStructure =
+        CoalitionFeasibilityCache::getInstance().findFeasibleCoalitionStructure(mOrganizationModelAsk,
+                modelPool, mMoveToResource, mFeasibilityCheckTimeoutInMs);
+
+    double secondsPerMeter = 0;
+    if(coalitionStructure.empty())
     {
-        facades::Robot robot = moreorg::facades::Robot::getInstance(coalition, mOrganizationModelAsk);
-        if( robot.isMobile())
+        secondsPerMeter = std::numeric_limits<double>::max();
+    } else {
+        // The slowest mobile system determines the travel time
+        for(const ModelPool& coalition : coalitionStructure)
         {
-            double time = distance / robot.getNominalVelocity();
-            minTime = std::max(time, minTime);
+            facades::Robot robot = moreorg::facades::Robot::getInstance(coalition, mOrganizationModelAsk);
+            if( robot.isMobile())
+            {
+                secondsPerMeter = std::max(1.0/robot.getNominalVelocity(), secondsPerMeter);
+            }
         }
     }
-    return minTime;
+    mSecondsPerMeter[modelPool] = secondsPerMeter;
+    return secondsPerMeter;
 }
 
 } // end namespace solvers
@@ -3,6 +3,7 @@
 
 #include "../symbols/constants/Location.hpp"
 #include "../Role.hpp"
+#include "DistanceMatrix.hpp"
 #include <moreorg/OrganizationModelAsk.hpp>
 #include <moreorg/vocabularies/OM.hpp>
 
@@ -17,11 +18,19 @@ public:
             moreorg::vocabulary::OM::resolve("MoveTo"),
             double feasibilityCheckTimeoutInMs = 20000);
 
+    /**
+     * Set the distance matrix that should be used for the distance lookup
+     * (locations which are not part of the matrix are computed on demand)
+     */
+    void setDistanceMatrix(const DistanceMatrix::Ptr& distanceMatrix) { mpDistanceMatrix = distanceMatrix; }
+
     /**
      * Compute the travel distance from a given path using the norm of the
      * segment distances
+     * \param distanceMatrix Optional precomputed distances
      */
-    static double getTravelDistance(const symbols::constants::Location::PtrList& path);
+    static double getTravelDistance(const symbols::constants::Location::PtrList& path,
+            const DistanceMatrix::Ptr& distanceMatrix = DistanceMatrix::Ptr());
 
     /**
      * Estimate the travel time from a particular location to a destination for
@@ -39,10 +48,22 @@ public:
     double estimateReconfigurationCost(const CoalitionStructure& from,
         const CoalitionStructure& to);
 
+protected:
+    /**
+     * Get the inverse speed of the slowest mobile system of the coalition
+     * structure which allows to transport the model pool
+     * \return seconds per meter, or the maximum double value if no feasible
+     * coalition structure exists
+     */
+    double getSecondsPerMeter(const moreorg::ModelPool& modelPool);
+
 private:
     moreorg::OrganizationModelAsk mOrganizationModelAsk;
     moreorg::Resource::Set mMoveToResource;
     double mFeasibilityCheckTimeoutInMs;
+    DistanceMatrix::Ptr mpDistanceMatrix;
+    /// Inverse speed per model pool
+    std::map<moreorg::ModelPool, double> mSecondsPerMeter;
 };
 
 } // end namespace solvers
@@ -0,0 +1,180 @@
+#include "DistanceMatrix.hpp"
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <stdexcept>
+#include <algorithm>
+
+namespace templ {
+namespace solvers {
+
+using namespace symbols::constants;
+
+// Size of a cache line in bytes
+static const size_t CACHE_LINE_SIZE = 64;
+
+DistanceMatrix::DistanceMatrix(const Location::PtrList& locations)
+    : mLocations(locations)
+    , mStride(0)
+    , mpDistances(NULL)
+{
+    size_t n = mLocations.size();
+    for(size_t i = 0; i < n; ++i)
+    {
+        mIndices[mLocations[i].get()] = i;
+    }
+
+    // Pad the rows, so that each row starts at a cache line boundary
+    size_t entriesPerCacheLine = CACHE_LINE_SIZE/sizeof(double);
+    mStride = ((n + entriesPerCacheLine - 1)/entriesPerCacheLine)*entriesPerCacheLine;
+    void* memory = NULL;
+    if(posix_memalign(&memory, CACHE_LINE_SIZE, std::max(mStride*n, static_cast<size_t>(1))*sizeof(double)) != 0)
+    {
+        throw std::runtime_error("templ::solvers::DistanceMatrix: failed to allocate distance matrix");
+    }
+    mpDistances = static_cast<double*>(memory);
+
+    if(n == 0)
+    {
+        return;
+    }
+
+    bool homogeneous = true;
+    Location::CoordinateType coordinateType = mLocations.front()->getCoordinateType();
+    double radius = mLocations.front()->getRadius();
+    for(const Location::Ptr& location : mLocations)
+    {
+        if(location->getCoordinateType() != coordinateType || location->getRadius() != radius)
+        {
+            homogeneous = false;
+            break;
+        }
+    }
+
+    if(!homogeneous)
+    {
+        // Distances are only defined for locations of the same coordinate
+        // type, so fall back to the pairwise computation
+        for(size_t i = 0; i < n; ++i)
+        {
+            for(size_t j = 0; j < n; ++j)
+            {
+                double distance = std::numeric_limits<double>::quiet_NaN();
+                try {
+                    distance = Location::getDistance(*mLocations[i], *mLocations[j]);
+                } catch(const std::runtime_error& e)
+                {
+                    // keep NaN to mark the undefined distance
+                }
+                mpDistances[i*mStride + j] = distance;
+            }
+        }
+        return;
+    }
+
+    // Structure of arrays for the batch kernels
+    if(coordinateType == Location::LATLONG)
+    {
+        std::vector<double> sinColatitudes(n);
+        std::vector<double> cosColatitudes(n);
+        std::vector<double> longitudes(n);
+        for(size_t i = 0; i < n; ++i)
+        {
+            const base::Point& position = mLocations[i]->getPosition();
+            double colatitude = (position.x() + 90.0)*M_PI/180.0;
+            sinColatitudes[i] = std::sin(colatitude);
+            cosColatitudes[i] = std::cos(colatitude);
+            longitudes[i] = position.y();
+        }
+
+        for(size_t i = 0; i < n; ++i)
+        {
+            computeSphericalDistances(sinColatitudes[i], cosColatitudes[i], longitudes[i],
+                    n, sinColatitudes.data(), cosColatitudes.data(), longitudes.data(),
+                    radius, mpDistances + i*mStride);
+        }
+    } else {
+        std::vector<double> xs(n);
+        std::vector<double> ys(n);
+        std::vector<double> zs(n);
+        for(size_t i = 0; i < n; ++i)
+        {
+            const base::Point& position = mLocations[i]->getPosition();
+            xs[i] = position.x();
+            ys[i] = position.y();
+            zs[i] = position.z();
+        }
+
+        for(size_t i = 0; i < n; ++i)
+        {
+            computeCartesianDistances(xs[i], ys[i], zs[i],
+                    n, xs.data(), ys.data(), zs.data(),
+                    mpDistances + i*mStride);
+        }
+    }
+}
+
+DistanceMatrix::~DistanceMatrix()
+{
+    free(mpDistances);
+}
+
+int DistanceMatrix::getIndex(const Location::Ptr& location) const
+{
+    std::unordered_map<const Location*, size_t>::const_iterator cit = mIndices.find(location.get());
+    if(cit == mIndices.end())
+    {
+        return -1;
+    }
+    return static_cast<int>(cit->second);
+}
+
+double DistanceMatrix::getDistance(const Location::Ptr& from, const Location::Ptr& to) const
+{
+    int fromIdx = getIndex(from);
+    int toIdx = getIndex(to);
+    if(fromIdx >= 0 && toIdx >= 0)
+    {
+        double distance = getDistance(fromIdx, toIdx);
+        if(!std::isnan(distance))
+        {
+            return distance;
+        }
+    }
+    // Unknown location or undefined distance (which throws)
+    return Location::getDistance(*from, *to);
+}
+
+void DistanceMatrix::computeSphericalDistances(double sinColatitude, double cosColatitude, double longitude,
+        size_t n, const double* sinColatitudes, const double* cosColatitudes, const double* longitudes,
+        double radius, double* distances)
+{
+    // Branch-free loop over contiguous arrays to allow vectorization
+    for(size_t j = 0; j < n; ++j)
+    {
+        double C = (longitude - longitudes[j])*M_PI/180.0;
+        double cosine = cosColatitude*cosColatitudes[j] + sinColatitude*sinColatitudes[j]*std::cos(C);
+        // limit to the domain of acos, which might be exceeded due to
+        // rounding
+        cosine = std::min(1.0, std::max(-1.0, cosine));
+        double distance = std::acos(cosine)*radius;
+        bool identical = longitude == longitudes[j] && cosColatitude == cosColatitudes[j] && sinColatitude == sinColatitudes[j];
+        distances[j] = identical ? 0.0 : distance;
+    }
+}
+
+void DistanceMatrix::computeCartesianDistances(double x, double y, double z,
+        size_t n, const double* xs, const double* ys, const double* zs,
+        double* distances)
+{
+    for(size_t j = 0; j < n; ++j)
+    {
+        double dx = x - xs[j];
+        double dy = y - ys[j];
+        double dz = z - zs[j];
+        distances[j] = std::sqrt(dx*dx + dy*dy + dz*dz);
+    }
+}
+
+} // end namespace solvers
+} // end namespace templ
@@ -0,0 +1,107 @@
+#ifndef TEMPL_SOLVERS_DISTANCE_MATRIX_HPP
+#define TEMPL_SOLVERS_DISTANCE_MATRIX_HPP
+
+#include <unordered_map>
+#include <vector>
+#include "../SharedPtr.hpp"
+#include "../symbols/constants/Location.hpp"
+
+namespace templ {
+namespace solvers {
+
+/**
+ * \class DistanceMatrix
+ * \brief Precomputed distances between all locations of a mission
+ * \details The distances are computed once, row by row, using batch kernels
+ * for spherical (LATLONG) and cartesian coordinates, which operate on
+ * contiguous coordinate arrays.
+ * The matrix is stored in a flat array, where each row starts at a cache line
+ * boundary. The location index corresponds to the position in the list of
+ * locations the matrix has been created with.
+ */
+class DistanceMatrix
+{
+public:
+    typedef shared_ptr<DistanceMatrix> Ptr;
+
+    /**
+     * Compute the distances between all given locations
+     */
+    DistanceMatrix(const symbols::constants::Location::PtrList& locations);
+
+    ~DistanceMatrix();
+
+    DistanceMatrix(const DistanceMatrix& other) = delete;
+    DistanceMatrix& operator=(const DistanceMatrix& other) = delete;
+
+    /**
+     * Get the number of locations
+     */
+    size_t size() const { return mLocations.size(); }
+
+    const symbols::constants::Location::PtrList& getLocations() const { return mLocations; }
+
+    /**
+     * Get the index of a location
+     * \return index of the location, or -1 if the location is not part of
+     * this matrix
+     */
+    int getIndex(const symbols::constants::Location::Ptr& location) const;
+
+    /**
+     * Get the distance between two locations by index
+     * \return distance, or NaN if no distance is defined for these locations
+     * (mismatching coordinate types)
+     */
+    double getDistance(size_t from, size_t to) const { return mpDistances[from*mStride + to]; }
+
+    /**
+     * Get the distance between two locations
+     * \details Falls back to symbols::constants::Location::getDistance for
+     * locations that are not part of the matrix
+     * \throws std::runtime_error if no distance is defined for these
+     * locations
+     */
+    double getDistance(const symbols::constants::Location::Ptr& from,
+            const symbols::constants::Location::Ptr& to) const;
+
+    /**
+     * Get the distances from one location to all others
+     * \return row of size() entries
+     */
+    const double* getRow(size_t from) const { return mpDistances + from*mStride; }
+
+    /**
+     * Compute the spherical distances (spherical law of cosines) from one
+     * location to a batch of locations
+     * \details The sine and cosine of the colatitudes are precomputed per
+     * location, so that only one cosine and one arc cosine remain per pair
+     * \param n Number of locations in the batch
+     * \param sinColatitudes Sine of the colatitudes of the batch
+     * \param cosColatitudes Cosine of the colatitudes of the batch
+     * \param longitudes Longitudes of the batch in degrees
+     */
+    static void computeSphericalDistances(double sinColatitude, double cosColatitude, double longitude,
+            size_t n, const double* sinColatitudes, const double* cosColatitudes, const double* longitudes,
+            double radius, double* distances);
+
+    /**
+     * Compute the euclidean distances from one location to a batch of
+     * locations
+     */
+    static void computeCartesianDistances(double x, double y, double z,
+            size_t n, const double* xs, const double* ys, const double* zs,
+            double* distances);
+
+private:
+    symbols::constants::Location::PtrList mLocations;
+    std::unordered_map<const symbols::constants::Location*, size_t> mIndices;
+
+    // Number of entries per row (including padding to the cache line size)
+    size_t mStride;
+    double* mpDistances;
+};
+
+} // end namespace solvers
+} // end namespace templ
+#endif // TEMPL_SOLVERS_DISTANCE_MATRIX_HPP
@@ -3,8 +3,11 @@
 #include <base-logging/Logging.hpp>
 #include <numeric/Combinatorics.hpp>
 #include "../utils/Index.hpp"
+#include "../utils/Hash.hpp"
 #include <iostream>
 #include <algorithm>
+#include <tuple>
+#include <unordered_map>
 
 namespace templ {
 namespace solvers {
@@ -12,7 +15,11 @@ namespace solvers {
 FluentTimeResource::FluentTimeResource()
     : mOrganizationModelAsk()
     , mFluentIdx(0)
-{}
+    , mRequirementIdx(0)
+    , mHash(0)
+{
+    updateHash();
+}
 
 FluentTimeResource::FluentTimeResource(
         const moreorg::OrganizationModelAsk& ask,
@@ -22,6 +29,8 @@ FluentTimeResource::FluentTimeResource(
         const moreorg::ModelPool& availableModels)
     : mOrganizationModelAsk(ask)
     , mFluentIdx(0)
+    , mRequirementIdx(0)
+    , mHash(0)
     , mpLocation(location)
     , mTimeInterval(timeInterval)
     , mMaxCardinalities(availableModels)
@@ -106,6 +115,7 @@ void FluentTimeResource::setFluent(const Symbol::Ptr& symbol)
 {
     symbols::constants::Location::Ptr location = dynamic_pointer_cast<symbols::constants::Location>(symbol);
     mpLocation = location;
+    updateHash();
 }
 
 symbols::constants::Location::Ptr FluentTimeResource::getLocation() const
@@ -184,6 +194,100 @@ std::vector<FluentTimeResource::List> FluentTimeResource::getMutualExclusive(con
 }
 
 
+std::vector<FluentTimeResource::List> FluentTimeResource::getMaximalMutualExclusive(const List& requirements,
+        const temporal::point_algebra::TimePoint::PtrList& sortedTimepoints,
+        temporal::point_algebra::TimePointComparator tpc
+        )
+{
+    using namespace temporal::point_algebra;
+
+    std::unordered_map<const TimePoint*, size_t> ranks;
+    for(size_t i = 0; i < sortedTimepoints.size(); ++i)
+    {
+        ranks.insert(std::make_pair(sortedTimepoints[i].get(), i));
+    }
+    auto getRank = [&ranks, &sortedTimepoints, &tpc](const TimePoint::Ptr& t) -> size_t
+    {
+        std::unordered_map<const TimePoint*, size_t>::const_iterator cit = ranks.find(t.get());
+        if(cit != ranks.end())
+        {
+            return cit->second;
+        }
+        for(size_t i = 0; i < sortedTimepoints.size(); ++i)
+        {
+            if(tpc.equals(sortedTimepoints[i], t))
+            {
+                ranks[t.get()] = i;
+                return i;
+            }
+        }
+        throw std::invalid_argument("templ::solvers::FluentTimeResource::getMaximalMutualExclusive: timepoint '"
+                + t->toString() + "' is not part of the sorted timepoints");
+    };
+
+    // Events as (rank, type, requirement index), where starts (type 0)
+    // precede ends (type 1) at the same timepoint, since intervals which
+    // share a timepoint are concurrent
+    typedef std::tuple<size_t, int, size_t> Event;
+    std::vector<Event> events;
+    events.reserve(2*requirements.size());
+    for(size_t i = 0; i < requirements.size(); ++i)
+    {
+        const temporal::Interval& interval = requirements[i].getInterval();
+        events.push_back(Event(getRank(interval.getFrom()), 0, i));
+        events.push_back(Event(getRank(interval.getTo()), 1, i));
+    }
+    std::sort(events.begin(), events.end());
+
+    std::vector<List> mutualExclusive;
+    std::set<size_t> active;
+    bool extended = false;
+    for(const Event& event : events)
+    {
+        size_t idx = std::get<2>(event);
+        if(std::get<1>(event) == 0)
+        {
+            active.insert(idx);
+            extended = true;
+            continue;
+        }
+
+        if(extended)
+        {
+            // The active set is a maximal clique, since it cannot be extended
+            // by any later start
+            List concurrent;
+            for(size_t a : active)
+            {
+                concurrent.push_back(requirements[a]);
+            }
+            mutualExclusive.push_back(concurrent);
+            extended = false;
+        }
+        active.erase(idx);
+    }
+    return mutualExclusive;
+}
+
+std::vector<FluentTimeResource::List> FluentTimeResource::groupByLocation(const List& requirements)
+{
+    std::vector<List> groups;
+    std::map<const symbols::constants::Location*, size_t> groupIdx;
+    for(const FluentTimeResource& ftr : requirements)
+    {
+        const symbols::constants::Location* location = ftr.mpLocation.get();
+        std::map<const symbols::constants::Location*, size_t>::const_iterator cit = groupIdx.find(location);
+        if(cit == groupIdx.end())
+        {
+            groupIdx[location] = groups.size();
+            groups.push_back({ ftr });
+        } else {
+            groups[cit->second].push_back(ftr);
+        }
+    }
+    return groups;
+}
+
 std::vector<FluentTimeResource::Set> FluentTimeResource::getOverlapping(const List& _requirements,
         temporal::point_algebra::TimePointComparator tpc
         )
@@ -316,6 +420,7 @@ moreorg::Resource::Set FluentTimeResource::getRequiredResources() const
 void FluentTimeResource::addRequiredResource(const moreorg::Resource& resource)
 {
     mResources.insert(resource.getModel());
+    updateHash();
     if(mOrganizationModelAsk.ontology().isSubClassOf(resource.getModel(),
                     moreorg::vocabulary::OM::Functionality()))
     {
@@ -326,26 +431,34 @@ void FluentTimeResource::addRequiredResource(const moreorg::Resource& resource)
 
 void FluentTimeResource::compact(std::vector<FluentTimeResource>& requirements)
 {
-    std::vector<FluentTimeResource>::iterator it = requirements.begin();
-    for(; it != requirements.end(); ++it)
-    {
-        FluentTimeResource& fts = *it;
+    std::vector<FluentTimeResource> compacted;
+    compacted.reserve(requirements.size());
 
-        std::vector<FluentTimeResource>::iterator compareIt = it + 1;
-        for(; compareIt != requirements.end();)
+    // Only requirements at the same location can be merged, so that the
+    // intervals have to be compared only within the same location
+    std::unordered_map<const symbols::constants::Location*, std::vector<size_t> > locationIndex;
+    for(const FluentTimeResource& fts : requirements)
+    {
+        std::vector<size_t>& candidates = locationIndex[fts.mpLocation.get()];
+        bool merged = false;
+        for(size_t idx : candidates)
         {
-            FluentTimeResource& otherFts = *compareIt;
-
-            if(fts.mTimeInterval == otherFts.mTimeInterval &&
-                    fts.mpLocation == otherFts.mpLocation)
+            FluentTimeResource& other = compacted[idx];
+            if(other.mTimeInterval == fts.mTimeInterval)
             {
-                fts.merge(otherFts);
-                requirements.erase(compareIt);
-            } else {
-                ++compareIt;
+                other.merge(fts);
+                merged = true;
+                break;
             }
         }
+
+        if(!merged)
+        {
+            candidates.push_back(compacted.size());
+            compacted.push_back(fts);
+        }
     }
+    requirements.swap(compacted);
 }
 
 void FluentTimeResource::merge(const FluentTimeResource& otherFtr)
@@ -359,6 +472,7 @@ void FluentTimeResource::merge(const FluentTimeResource& otherFtr)
             otherFtr.mMinCardinalities);
     mMaxCardinalities = moreorg::Algebra::min(mMaxCardinalities,
             otherFtr.mMaxCardinalities);
+    updateHash();
 }
 
 moreorg::ModelPool::Set FluentTimeResource::getDomain() const
@@ -406,23 +520,24 @@ moreorg::ModelPool::Set FluentTimeResource::getDomain() const
 
 size_t FluentTimeResource::getIndex(const List& list, const FluentTimeResource& fluent)
 {
+    if(fluent.mRequirementIdx < list.size())
+    {
+        const FluentTimeResource& ftr = list[fluent.mRequirementIdx];
+        if(ftr.mHash == fluent.mHash || ftr.includes(fluent))
+        {
+            return fluent.mRequirementIdx;
+        }
+    }
+
+    // The fluent has not been derived from this list, or has been modified
+    // since
     size_t index = 0;
     for(const FluentTimeResource& ftr : list)
     {
-        if(ftr.mTimeInterval == fluent.mTimeInterval &&
-                ftr.mpLocation == fluent.mpLocation)
+        if(ftr.includes(fluent))
         {
-            owlapi::model::IRISet intersect;
-            std::set_intersection(ftr.mResources.begin(), ftr.mResources.end(),
-                    fluent.mResources.begin(), fluent.mResources.end(),
-                    std::inserter(intersect, intersect.begin()) );
-
-            if(intersect == fluent.mResources)
-            {
-                return index;
-            }
+            return index;
         }
-
         ++index;
     }
 
@@ -430,10 +545,42 @@ size_t FluentTimeResource::getIndex(const List& list, const FluentTimeResource&
             + FluentTimeResource::toString(list,4) +"'");
 }
 
+void FluentTimeResource::updateRequirementIndices(List& requirements)
+{
+    for(size_t i = 0; i < requirements.size(); ++i)
+    {
+        requirements[i].mRequirementIdx = i;
+    }
+}
+
+bool FluentTimeResource::includes(const FluentTimeResource& other) const
+{
+    return mpLocation == other.mpLocation
+        && mTimeInterval == other.mTimeInterval
+        && std::includes(mResources.begin(), mResources.end(),
+                other.mResources.begin(), other.mResources.end());
+}
+
+void FluentTimeResource::updateHash()
+{
+    using namespace templ::utils;
+
+    uint64_t h = hash::FNV_OFFSET_BASIS;
+    for(const owlapi::model::IRI& resource : mResources)
+    {
+        h = hash::fnv1a(resource.toString(), h);
+    }
+    h = hash::combine(h, reinterpret_cast<uintptr_t>(mpLocation.get()));
+    h = hash::combine(h, reinterpret_cast<uintptr_t>(mTimeInterval.getFrom().get()));
+    h = hash::combine(h, reinterpret_cast<uintptr_t>(mTimeInterval.getTo().get()));
+    mHash = h;
+}
+
 void FluentTimeResource::incrementResourceMinCardinality(const owlapi::model::IRI& model, size_t number)
 {
     mResources.insert(model);
     mMinCardinalities[model] += number;
+    updateHash();
 }
 
 bool FluentTimeResource::areMutualExclusive(const FluentTimeResource& ftrA,
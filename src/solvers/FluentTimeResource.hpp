@@ -108,7 +108,7 @@ public:
      * \param interval
      * \throws std::invalid_argument if interval cannot be found in the mission
      */
-    void setInterval(const solvers::temporal::Interval& interval) { mTimeInterval = interval; }
+    void setInterval(const solvers::temporal::Interval& interval) { mTimeInterval = interval; updateHash(); }
 
     /**
      * Get the associated fluent (here: location)
@@ -139,7 +139,7 @@ public:
      * mission
      */
     void setLocation(const symbols::constants::Location::Ptr& location) {
-        mpLocation = location; }
+        mpLocation = location; updateHash(); }
 
     /**
      * Get the minimum cardinalities for a number of resources
@@ -198,6 +198,34 @@ public:
             temporal::point_algebra::TimePointComparator tpc
             );
 
+    /**
+     * Get the maximal sets of concurrent requirements, i.e. the maximal sets
+     * of requirements whose time intervals overlap pairwise
+     * \details Sweeps over the interval endpoints ordered by the given list
+     * of sorted timepoints to identify the maximal sets of concurrent
+     * requirements (maximal cliques of the interval graph), where each set
+     * is returned once.
+     * Concurrent requirements at the same location are not mutually
+     * exclusive, but they are part of the same set: use groupByLocation to
+     * account for them, e.g. by the maximum usage per location
+     * \param requirements List of requirements
+     * \param sortedTimepoints Timepoints fully temporally ordered
+     * \param tpc TimePointComparator which is used to identify timepoints
+     * which are not part of the sorted list by instance
+     * \throws std::invalid_argument if an interval refers to a timepoint
+     * which is not part of the sorted timepoints
+     */
+    static std::vector<List> getMaximalMutualExclusive(const List& requirements,
+            const temporal::point_algebra::TimePoint::PtrList& sortedTimepoints,
+            temporal::point_algebra::TimePointComparator tpc
+            );
+
+    /**
+     * Group the requirements by their location
+     * \return groups in the order of the first occurrence of a location
+     */
+    static std::vector<List> groupByLocation(const List& requirements);
+
     /**
      * Get overlapping requirement,
      * requirements overlap, when they refer to the same location
@@ -271,11 +299,38 @@ public:
 
     /**
      * Get the index of a fluent in a list of fluents
+     * \details Resolves in constant time when the fluent carries its index in
+     * the list, i.e., the list has been indexed with updateRequirementIndices
      * \param list List of FluentTimeResource
      * \param fluent
      */
     static size_t getIndex(const List& list, const FluentTimeResource& fluent);
 
+    /**
+     * Get the index of this requirement in the list of all requirements
+     * \see Mission::getResourceRequirements
+     */
+    size_t getRequirementIdx() const { return mRequirementIdx; }
+
+    /**
+     * Set the index of this requirement in the list of all requirements
+     */
+    void setRequirementIdx(size_t idx) { mRequirementIdx = idx; }
+
+    /**
+     * Assign the requirement index for all requirements according to their
+     * position in the list
+     */
+    static void updateRequirementIndices(List& requirements);
+
+    /**
+     * Get the hash of this requirement, which is computed from the required
+     * resource models, the location and the timepoints of the interval
+     * \details The hash is identical for requirements which refer to the
+     * same location and timepoint instances, and the same set of resource models
+     */
+    uint64_t getHash() const { return mHash; }
+
     /**
      * Increment the min cardinality for a resource requirement for a given
      * increment, adds the resource model to the required resources if not
@@ -305,11 +360,23 @@ public:
             const symbols::constants::Location::PtrList& locations);
 
 private:
+    /**
+     * Check if this requirement refers to the same location and interval,
+     * and includes all resources of the other requirement
+     */
+    bool includes(const FluentTimeResource& other) const;
+
+    void updateHash();
+
     /// Allow to map between indexes and symbols
     moreorg::OrganizationModelAsk mOrganizationModelAsk;
 
     /// Location idx for processing in CSP
     size_t mFluentIdx;
+    /// Index in the list of all requirements
+    size_t mRequirementIdx;
+    /// Hash of resources, location and interval
+    uint64_t mHash;
 
     /// involved resource types
     owlapi::model::IRISet mResources;
@@ -0,0 +1,147 @@
+#include "Reachability.hpp"
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
+#include "temporal/IntervalConstraint.hpp"
+
+namespace templ {
+namespace solvers {
+
+using namespace temporal;
+
+Reachability::Reachability(const point_algebra::TimePoint::PtrList& sortedTimepoints,
+        const Constraint::PtrList& constraints)
+{
+    if(sortedTimepoints.empty())
+    {
+        return;
+    }
+
+    size_t numberOfSteps = sortedTimepoints.size() - 1;
+    mMaxStepDurations.resize(numberOfSteps, std::numeric_limits<double>::max());
+
+    std::unordered_map<const point_algebra::TimePoint*, size_t> indices;
+    for(size_t i = 0; i < sortedTimepoints.size(); ++i)
+    {
+        indices[sortedTimepoints[i].get()] = i;
+    }
+    auto getIndex = [&sortedTimepoints, &indices](const point_algebra::TimePoint::Ptr& timepoint) -> int
+    {
+        std::unordered_map<const point_algebra::TimePoint*, size_t>::const_iterator cit = indices.find(timepoint.get());
+        if(cit != indices.end())
+        {
+            return static_cast<int>(cit->second);
+        }
+        for(size_t i = 0; i < sortedTimepoints.size(); ++i)
+        {
+            const point_algebra::TimePoint::Ptr& other = sortedTimepoints[i];
+            if(other->getType() == timepoint->getType() && other->equals(timepoint))
+            {
+                return static_cast<int>(i);
+            }
+        }
+        return -1;
+    };
+
+    // Bounds of quantitative timepoints
+    for(size_t t = 0; t < numberOfSteps; ++t)
+    {
+        const point_algebra::TimePoint::Ptr& from = sortedTimepoints[t];
+        const point_algebra::TimePoint::Ptr& to = sortedTimepoints[t+1];
+        if(from->getType() != point_algebra::TimePoint::QUANTITATIVE
+                || to->getType() != point_algebra::TimePoint::QUANTITATIVE
+                || to->getUpperBound() == std::numeric_limits<uint64_t>::max())
+        {
+            continue;
+        }
+
+        double maxDuration = 0;
+        if(to->getUpperBound() > from->getLowerBound())
+        {
+            maxDuration = static_cast<double>(to->getUpperBound() - from->getLowerBound());
+        }
+        mMaxStepDurations[t] = std::min(mMaxStepDurations[t], maxDuration);
+    }
+
+    // Interval constraints bound all steps they cover
+    for(const Constraint::Ptr& constraint : constraints)
+    {
+        IntervalConstraint::Ptr intervalConstraint = dynamic_pointer_cast<IntervalConstraint>(constraint);
+        if(!intervalConstraint || intervalConstraint->getIntervals().empty())
+        {
+            continue;
+        }
+
+        double upperBound = intervalConstraint->getUpperBound();
+        if(upperBound == std::numeric_limits<double>::max())
+        {
+            continue;
+        }
+
+        int fromIdx = getIndex(intervalConstraint->getSourceTimePoint());
+        int toIdx = getIndex(intervalConstraint->getTargetTimePoint());
+        if(fromIdx < 0 || toIdx < 0 || fromIdx >= toIdx)
+        {
+            continue;
+        }
+
+        for(int t = fromIdx; t < toIdx; ++t)
+        {
+            mMaxStepDurations[t] = std::min(mMaxStepDurations[t], std::max(0.0, upperBound));
+        }
+    }
+}
+
+bool Reachability::isBounded() const
+{
+    for(double maxDuration : mMaxStepDurations)
+    {
+        if(maxDuration != std::numeric_limits<double>::max())
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool Reachability::isBounded(size_t timepointIdx) const
+{
+    return timepointIdx < mMaxStepDurations.size()
+        && mMaxStepDurations[timepointIdx] != std::numeric_limits<double>::max();
+}
+
+bool Reachability::isReachable(const TravelTimes& travelTimes,
+        size_t numberOfLocations,
+        size_t timepointIdx,
+        size_t fromLocationIdx,
+        size_t toLocationIdx) const
+{
+    if(fromLocationIdx == toLocationIdx || !isBounded(timepointIdx))
+    {
+        return true;
+    }
+    // allow for rounding of the travel time estimate
+    return travelTimes[fromLocationIdx*numberOfLocations + toLocationIdx] <= mMaxStepDurations[timepointIdx] + 1E-06;
+}
+
+Reachability::TravelTimes Reachability::computeTravelTimes(Cost& cost,
+        const symbols::constants::Location::PtrList& locations,
+        const Coalition& coalition)
+{
+    size_t n = locations.size();
+    TravelTimes travelTimes(n*n, 0.0);
+    for(size_t i = 0; i < n; ++i)
+    {
+        for(size_t j = 0; j < n; ++j)
+        {
+            if(i != j)
+            {
+                travelTimes[i*n + j] = cost.estimateTravelTime(locations[i], locations[j], coalition);
+            }
+        }
+    }
+    return travelTimes;
+}
+
+} // end namespace solvers
+} // end namespace templ
@@ -0,0 +1,87 @@
+#ifndef TEMPL_SOLVERS_REACHABILITY_HPP
+#define TEMPL_SOLVERS_REACHABILITY_HPP
+
+#include <vector>
+#include "../Constraint.hpp"
+#include "../Role.hpp"
+#include "../symbols/constants/Location.hpp"
+#include "temporal/point_algebra/TimePoint.hpp"
+#include "Cost.hpp"
+
+namespace templ {
+namespace solvers {
+
+/**
+ * \class Reachability
+ * \brief Identify the transitions of the space time network, which cannot be
+ * travelled between two consecutive timepoints
+ * \details The maximum duration between two consecutive timepoints is
+ * derived from the temporal bounds of the mission, i.e. the interval
+ * constraints and the bounds of quantitative timepoints. An interval
+ * constraint between t_a and t_b also bounds all steps between these
+ * timepoints, since timepoints are ordered.
+ * A transition from one location to another is reachable if the estimated
+ * travel time does not exceed the maximum duration of the step.
+ */
+class Reachability
+{
+public:
+    /// Travel times between all pairs of locations (row major, from x to)
+    typedef std::vector<double> TravelTimes;
+
+    /**
+     * Compute the maximum step durations
+     * \param sortedTimepoints Sorted timepoints of the mission
+     * \param constraints Constraints of the mission (only interval
+     * constraints are considered)
+     */
+    Reachability(const temporal::point_algebra::TimePoint::PtrList& sortedTimepoints,
+            const Constraint::PtrList& constraints);
+
+    /**
+     * Check if at least one step has a bounded duration, i.e. if pruning can
+     * be applied at all
+     */
+    bool isBounded() const;
+
+    /**
+     * Check if a step has a bounded duration
+     * \param timepointIdx Index of the start timepoint of the step
+     */
+    bool isBounded(size_t timepointIdx) const;
+
+    /**
+     * Get the maximum duration from the timepoint at the given index to
+     * the next
+     * \return maximum duration, or the maximum double value if unbounded
+     */
+    double getMaxStepDuration(size_t timepointIdx) const { return mMaxStepDurations.at(timepointIdx); }
+
+    /**
+     * Check if the target location can be reached from the source location
+     * in the step starting at the given timepoint
+     * \param travelTimes Travel times as computed by computeTravelTimes
+     * \param numberOfLocations Number of locations
+     */
+    bool isReachable(const TravelTimes& travelTimes,
+            size_t numberOfLocations,
+            size_t timepointIdx,
+            size_t fromLocationIdx,
+            size_t toLocationIdx) const;
+
+    /**
+     * Compute the travel times between all locations for a coalition
+     * \see Cost::estimateTravelTime
+     */
+    static TravelTimes computeTravelTimes(Cost& cost,
+            const symbols::constants::Location::PtrList& locations,
+            const Coalition& coalition);
+
+private:
+    /// Maximum duration per step, indexed by the start timepoint
+    std::vector<double> mMaxStepDurations;
+};
+
+} // end namespace solvers
+} // end namespace templ
+#endif // TEMPL_SOLVERS_REACHABILITY_HPP
@@ -456,33 +456,47 @@ void SolutionAnalysis::analyse()
 
 void SolutionAnalysis::save(const std::string& _filename) const
 {
+    // Filenames and the row have to be resolved here, since the
+    // session id might change until the artifacts are written
     std::string planFilename = _filename;
     if(planFilename.empty())
     {
         planFilename = mpMission->getLogger()->filename("final_plan.gexf");
     }
-    graph_analysis::io::GraphIO::write(planFilename, mPlan.getGraph());
 
     std::string solutionNetworkFilename = _filename;
     if(solutionNetworkFilename.empty())
     {
         solutionNetworkFilename = mpMission->getLogger()->filename("final_solution_network.gexf");
     }
-    graph_analysis::io::GraphIO::write(solutionNetworkFilename, mSolutionNetwork.getGraph());
 
     // stats to string
     std::string filename = mpMission->getLogger()->getBasePath() +
         "solution_analysis.log";
-    std::ofstream outfile;
-    if(!boost::filesystem::exists(filename))
-    {
-        outfile.open(filename);
-        outfile << getRowDescriptor() << std::endl;
-        outfile << toRow() << std::endl;
-    } else {
-        outfile.open(filename, std::ios_base::app);
-        outfile << toRow() << std::endl;
-    }
+    std::string rowDescriptor = getRowDescriptor();
+    std::string row = toRow();
+
+    // Snapshot the graphs (vertices and edges included), since this
+    // analysis might change while the artifacts are written
+    graph_analysis::BaseGraph::Ptr plan = mPlan.getGraph()->clone();
+    graph_analysis::BaseGraph::Ptr solutionNetwork = mSolutionNetwork.getGraph()->clone();
+
+    mpMission->getLogger()->getArtifactWriter()->enqueue([=]()
+        {
+            graph_analysis::io::GraphIO::write(planFilename, plan);
+            graph_analysis::io::GraphIO::write(solutionNetworkFilename, solutionNetwork);
+
+            std::ofstream outfile;
+            if(!boost::filesystem::exists(filename))
+            {
+                outfile.open(filename);
+                outfile << rowDescriptor << std::endl;
+                outfile << row << std::endl;
+            } else {
+                outfile.open(filename, std::ios_base::app);
+                outfile << row << std::endl;
+            }
+        });
 }
 
 void SolutionAnalysis::saveRow(const std::string& filename, size_t sessionId) const
@@ -566,11 +580,7 @@ double SolutionAnalysis::degreeOfFulfillment(const solvers::FluentTimeResource&
     SpaceTime::Network::tuple_t::PtrList tuples = getTuples(ftr);
     for(const SpaceTime::Network::tuple_t::Ptr& roleInfo : tuples)
     {
-        std::set<Role> assigned = roleInfo->getRoles(RoleInfo::ASSIGNED);
-        std::set<Role> required = roleInfo->getRoles(RoleInfo::REQUIRED);
-
-        if(!std::includes(assigned.begin(), assigned.end(), required.begin(),
-                required.end()))
+        if(!roleInfo->includes(RoleInfo::ASSIGNED, RoleInfo::REQUIRED))
         {
             return 0.0;
         }
@@ -721,6 +731,7 @@ void SolutionAnalysis::quantifyTime()
     using namespace solvers::temporal;
     TemporalConstraintNetwork tcn;
     Cost cost(mpMission->getOrganizationModelAsk());
+    cost.setDistanceMatrix(mpMission->getDistanceMatrix());
 
     double travelDistanceInM = 0.0;
     double minTaskTime = mConfiguration.getValueAs<double>("TransportNetwork/task-time/min", 1800.0);
@@ -771,7 +782,7 @@ void SolutionAnalysis::quantifyTime()
             tcn.addIntervalConstraint(intervalConstraint);
             continue;
         } else {
-            double distanceInM = cost.getTravelDistance({sourceLocation, targetLocation});
+            double distanceInM = Cost::getTravelDistance({sourceLocation, targetLocation}, mpMission->getDistanceMatrix());
             double minTravelTime = cost.estimateTravelTime(sourceLocation, targetLocation, roles);
             LOG_INFO_S << "Estimated travelTime: " << minTravelTime << " for " << Role::toString(roles)
                 << "    from: " << sourceLocation->toString() << "/" << sourceTuple->second()->toString() << std::endl
@@ -56,6 +56,11 @@ public:
 
     void analyse();
 
+    /**
+     * Save the plan, the solution network and the analysis results
+     * The files are written asynchronously by the logger's artifact writer
+     * \see utils::ArtifactWriter::flush
+     */
     void save(const std::string& filename = "") const;
     void saveRow(const std::string& filename, size_t sessionId = 0) const;
     void saveModelPool(const std::string& filename) const;
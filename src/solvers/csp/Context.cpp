@@ -1,6 +1,12 @@
 #include "Context.hpp"
+#include <set>
+#include <limits>
+#include <functional>
 #include <moreorg/Algebra.hpp>
 #include <moreorg/vocabularies/OM.hpp>
+#include <base-logging/Logging.hpp>
+#include "../temporal/point_algebra/QualitativeTimePointConstraint.hpp"
+#include "../../constraints/SimpleConstraint.hpp"
 
 namespace templ {
 namespace solvers {
@@ -14,9 +20,307 @@ Context::Context(const templ::Mission::Ptr& mission, const qxcfg::Configuration&
     , mLocations(mission->getLocations())
     , mIntervals(mission->getTimeIntervals())
     , mConfiguration(configuration)
-    , mNumberOfTimepoints(mission->getUnorderedTimepoints().size())
+    , mNumberOfTimepoints(0)
     , mNumberOfFluents(mLocations.size())
+    , mpDistanceMatrix(mission->getDistanceMatrix())
 {
+    using namespace solvers::temporal::point_algebra;
+    TimePoint::PtrList timepoints = mission->getUnorderedTimepoints();
+    std::string merging = mConfiguration.getValue("TransportNetwork/search/options/timepoint-merging","none");
+    if(merging == "none")
+    {
+        mTimepoints = timepoints;
+    } else if(merging == "equal" || merging == "equal-and-unused")
+    {
+        std::map<TimePoint::Ptr, TimePoint::Ptr> layerTimepoints = mergeTimepoints(timepoints,
+                mission->getConstraints(),
+                mIntervals,
+                merging == "equal-and-unused");
+        for(const TimePoint::Ptr& timepoint : timepoints)
+        {
+            const TimePoint::Ptr& layerTimepoint = layerTimepoints[timepoint];
+            if(layerTimepoint == timepoint)
+            {
+                mTimepoints.push_back(timepoint);
+            } else {
+                mLayerTimepoints[timepoint] = layerTimepoint;
+            }
+        }
+        LOG_INFO_S << "Timepoint merging: using " << mTimepoints.size() << " of "
+            << timepoints.size() << " timepoints";
+    } else {
+        throw std::invalid_argument("templ::solvers::csp::Context: unknown timepoint merging '"
+                + merging + "' -- use 'none', 'equal' or 'equal-and-unused'");
+    }
+    mNumberOfTimepoints = mTimepoints.size();
+
+    mpFlowSolutionCache = make_shared<FlowSolutionCache>(mLocations,
+            mTimepoints,
+            mConfiguration.getValueAs<size_t>("TransportNetwork/search/options/lp/cache-size",1000));
+}
+
+solvers::temporal::point_algebra::TimePoint::Ptr Context::getLayerTimepoint(const solvers::temporal::point_algebra::TimePoint::Ptr& timepoint) const
+{
+    std::map<solvers::temporal::point_algebra::TimePoint::Ptr, solvers::temporal::point_algebra::TimePoint::Ptr>::const_iterator cit = mLayerTimepoints.find(timepoint);
+    if(cit != mLayerTimepoints.end())
+    {
+        return cit->second;
+    }
+    return timepoint;
+}
+
+std::map<solvers::temporal::point_algebra::TimePoint::Ptr, solvers::temporal::point_algebra::TimePoint::Ptr> Context::mergeTimepoints(
+        const solvers::temporal::point_algebra::TimePoint::PtrList& timepoints,
+        const Constraint::PtrList& constraints,
+        const std::vector<solvers::temporal::Interval>& intervals,
+        bool dropUnused)
+{
+    using namespace solvers::temporal::point_algebra;
+
+    std::map<TimePoint::Ptr, size_t> indices;
+    for(size_t i = 0; i < timepoints.size(); ++i)
+    {
+        indices[ timepoints[i] ] = i;
+    }
+
+    // LessOrEqual relations as adjacency list (a <= b), an Equal constraint
+    // adds both directions
+    std::vector< std::vector<size_t> > lessOrEqual(timepoints.size());
+    std::set<TimePoint::Ptr> used;
+    for(const Constraint::Ptr& constraint : constraints)
+    {
+        if(constraint->getCategory() == Constraint::TEMPORAL_QUANTITATIVE)
+        {
+            // Timepoints of quantitative constraints, e.g. interval
+            // constraints, have to remain part of the network
+            templ::constraints::SimpleConstraint::Ptr simpleConstraint = dynamic_pointer_cast<templ::constraints::SimpleConstraint>(constraint);
+            if(simpleConstraint)
+            {
+                used.insert( dynamic_pointer_cast<TimePoint>(simpleConstraint->getSourceVertex()) );
+                used.insert( dynamic_pointer_cast<TimePoint>(simpleConstraint->getTargetVertex()) );
+            }
+            continue;
+        }
+        if(constraint->getCategory() != Constraint::TEMPORAL_QUALITATIVE)
+        {
+            continue;
+        }
+
+        QualitativeTimePointConstraint::Ptr qtpc = dynamic_pointer_cast<QualitativeTimePointConstraint>(constraint);
+        if(!qtpc)
+        {
+            continue;
+        }
+        std::map<TimePoint::Ptr, size_t>::const_iterator lit = indices.find(qtpc->getLVal());
+        std::map<TimePoint::Ptr, size_t>::const_iterator rit = indices.find(qtpc->getRVal());
+        if(lit == indices.end() || rit == indices.end())
+        {
+            continue;
+        }
+        size_t a = lit->second;
+        size_t b = rit->second;
+
+        switch(qtpc->getType())
+        {
+            case QualitativeTimePointConstraint::Equal:
+                lessOrEqual[a].push_back(b);
+                lessOrEqual[b].push_back(a);
+                break;
+            case QualitativeTimePointConstraint::LessOrEqual:
+                lessOrEqual[a].push_back(b);
+                break;
+            case QualitativeTimePointConstraint::GreaterOrEqual:
+                lessOrEqual[b].push_back(a);
+                break;
+            default:
+                break;
+        }
+    }
+
+    // Timepoints within a strongly connected component of the LessOrEqual
+    // relations are equal (Tarjan's algorithm, components are identified by
+    // their root index)
+    const size_t undefined = std::numeric_limits<size_t>::max();
+    std::vector<size_t> components(timepoints.size(), undefined);
+    std::vector<size_t> order(timepoints.size(), undefined);
+    std::vector<size_t> lowlink(timepoints.size(), 0);
+    std::vector<bool> onStack(timepoints.size(), false);
+    std::vector<size_t> stack;
+    size_t nextOrder = 0;
+    std::function<void(size_t)> strongConnect = [&](size_t v)
+    {
+        order[v] = nextOrder;
+        lowlink[v] = nextOrder;
+        ++nextOrder;
+        stack.push_back(v);
+        onStack[v] = true;
+
+        for(size_t w : lessOrEqual[v])
+        {
+            if(order[w] == undefined)
+            {
+                strongConnect(w);
+                lowlink[v] = std::min(lowlink[v], lowlink[w]);
+            } else if(onStack[w])
+            {
+                lowlink[v] = std::min(lowlink[v], order[w]);
+            }
+        }
+
+        if(lowlink[v] == order[v])
+        {
+            size_t w;
+            do {
+                w = stack.back();
+                stack.pop_back();
+                onStack[w] = false;
+                components[w] = v;
+            } while(w != v);
+        }
+    };
+    for(size_t i = 0; i < timepoints.size(); ++i)
+    {
+        if(order[i] == undefined)
+        {
+            strongConnect(i);
+        }
+    }
+    auto find = [&components](size_t i) -> size_t
+    {
+        return components[i];
+    };
+
+    for(const TimePoint::Ptr& timepoint : timepoints)
+    {
+        if(timepoint->getType() == TimePoint::QUANTITATIVE)
+        {
+            // Bounds of quantitative timepoints are temporal constraints
+            used.insert(timepoint);
+        }
+    }
+    // Requirements refer to the timepoints of their intervals
+    for(const solvers::temporal::Interval& interval : intervals)
+    {
+        used.insert(interval.getFrom());
+        used.insert(interval.getTo());
+    }
+
+    // The first used timepoint of a set of equal timepoints represents the
+    // set, sets without any used timepoint are dropped (if requested)
+    std::map<size_t, TimePoint::Ptr> representatives;
+    for(size_t i = 0; i < timepoints.size(); ++i)
+    {
+        if(used.count(timepoints[i]) && !representatives.count( find(i) ))
+        {
+            representatives[ find(i) ] = timepoints[i];
+        }
+    }
+    if(!dropUnused)
+    {
+        for(size_t i = 0; i < timepoints.size(); ++i)
+        {
+            if(!representatives.count( find(i) ))
+            {
+                representatives[ find(i) ] = timepoints[i];
+            }
+        }
+    }
+
+    std::map<TimePoint::Ptr, TimePoint::Ptr> layerTimepoints;
+    for(size_t i = 0; i < timepoints.size(); ++i)
+    {
+        std::map<size_t, TimePoint::Ptr>::const_iterator cit = representatives.find( find(i) );
+        if(cit != representatives.end())
+        {
+            layerTimepoints[ timepoints[i] ] = cit->second;
+        } else {
+            layerTimepoints[ timepoints[i] ] = TimePoint::Ptr();
+        }
+    }
+    return layerTimepoints;
+}
+
+templ::utils::Hash128 Context::getDomainSignature(const FluentTimeResource& ftr)
+{
+    templ::utils::Hash128 signature;
+    for(const moreorg::Resource& resource : ftr.getRequiredResources())
+    {
+        signature.update(resource.toString());
+    }
+    // separate the sections
+    signature.update(0xffffffffffffffffULL);
+    for(const moreorg::ModelPool::value_type& p : ftr.getMinCardinalities())
+    {
+        signature.update(p.first.toString());
+        signature.update(p.second);
+    }
+    signature.update(0xffffffffffffffffULL);
+    for(const moreorg::ModelPool::value_type& p : ftr.getMaxCardinalities())
+    {
+        signature.update(p.first.toString());
+        signature.update(p.second);
+    }
+    return signature;
+}
+
+bool Context::getExtensionalDomain(const templ::utils::Hash128& signature, ExtensionalDomain& domain) const
+{
+    std::lock_guard<std::mutex> lock(mExtensionalDomainsMutex);
+    std::unordered_map<templ::utils::Hash128, ExtensionalDomain>::const_iterator cit = mExtensionalDomains.find(signature);
+    if(cit == mExtensionalDomains.end())
+    {
+        return false;
+    }
+    // TupleSet is reference counted, so this does not copy the tuples
+    domain = cit->second;
+    return true;
+}
+
+void Context::putExtensionalDomain(const templ::utils::Hash128& signature, const ExtensionalDomain& domain)
+{
+    std::lock_guard<std::mutex> lock(mExtensionalDomainsMutex);
+    mExtensionalDomains[signature] = domain;
+}
+
+const Reachability::TravelTimes& Context::getTravelTimes(const Role& role)
+{
+    std::lock_guard<std::mutex> lock(mTravelTimesMutex);
+    std::map<owlapi::model::IRI, Reachability::TravelTimes>::const_iterator cit = mTravelTimes.find(role.getModel());
+    if(cit != mTravelTimes.end())
+    {
+        return cit->second;
+    }
+
+    Cost cost(mAsk, moreorg::vocabulary::OM::resolve("MoveTo"),
+            1000*mConfiguration.getValueAs<double>("TransportNetwork/search/options/coalition-feasibility/timeout_in_s",1));
+    cost.setDistanceMatrix(mpDistanceMatrix);
+
+    Coalition coalition;
+    coalition.insert(role);
+    Reachability::TravelTimes& travelTimes = mTravelTimes[role.getModel()];
+    travelTimes = Reachability::computeTravelTimes(cost, mLocations, coalition);
+    return travelTimes;
+}
+
+transshipment::IncrementalFlowGraph::Ptr Context::acquireIncrementalFlowGraph()
+{
+    {
+        std::lock_guard<std::mutex> lock(mIncrementalFlowGraphsMutex);
+        if(!mIdleIncrementalFlowGraphs.empty())
+        {
+            // most recently released graph first
+            transshipment::IncrementalFlowGraph::Ptr flowGraph = mIdleIncrementalFlowGraphs.back();
+            mIdleIncrementalFlowGraphs.pop_back();
+            return flowGraph;
+        }
+    }
+    return make_shared<transshipment::IncrementalFlowGraph>();
+}
+
+void Context::releaseIncrementalFlowGraph(const transshipment::IncrementalFlowGraph::Ptr& flowGraph)
+{
+    std::lock_guard<std::mutex> lock(mIncrementalFlowGraphsMutex);
+    mIdleIncrementalFlowGraphs.push_back(flowGraph);
 }
 
 } // end namespace csp
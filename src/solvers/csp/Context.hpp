@@ -1,18 +1,45 @@
 #ifndef TEMPL_SOLVERS_CSP_CONTEXT_HPP
 #define TEMPL_SOLVERS_CSP_CONTEXT_HPP
 
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include <gecode/int.hh>
 #include "../../Mission.hpp"
+#include "../../utils/Hash.hpp"
+#include "../FluentTimeResource.hpp"
+#include "../Cost.hpp"
+#include "../Reachability.hpp"
+#include "../transshipment/IncrementalFlowGraph.hpp"
+#include "FlowSolutionCache.hpp"
 #include <qxcfg/Configuration.hpp>
 
 namespace templ {
 namespace solvers {
 namespace csp {
 
+/**
+ * \class Context
+ * \details Mission related data which is shared between all spaces (including
+ * clones and restarts) of a search
+ */
 class Context
 {
 public:
     typedef shared_ptr<Context> Ptr;
 
+    /**
+     * The domain of a requirement, i.e. the allowed model combinations, and
+     * the corresponding finalized tuple set for the extensional constraint
+     */
+    struct ExtensionalDomain
+    {
+        moreorg::ModelPool::Set combinations;
+        /// Finalized tuple set (only if combinations are available)
+        Gecode::TupleSet tupleSet;
+    };
+
     Context(const Mission::Ptr& mission, const qxcfg::Configuration& configuration = qxcfg::Configuration());
 
     moreorg::OrganizationModelAsk& ask() { return mAsk; }
@@ -21,12 +48,106 @@ public:
 
     const std::vector<solvers::temporal::Interval>& intervals() const { return mIntervals; }
 
+    /**
+     * Get the (unordered) timepoints which form the layers of the time
+     * expanded network
+     * \details Without timepoint merging these are all timepoints of the
+     * mission
+     * \see mergeTimepoints
+     */
+    const solvers::temporal::point_algebra::TimePoint::PtrList& timepoints() const { return mTimepoints; }
+
+    /**
+     * Get the timepoint of the time expanded network which represents a
+     * timepoint of the mission
+     * \return representing timepoint, the timepoint itself if it has not
+     * been merged, or an empty pointer if the timepoint has been dropped
+     */
+    solvers::temporal::point_algebra::TimePoint::Ptr getLayerTimepoint(const solvers::temporal::point_algebra::TimePoint::Ptr& timepoint) const;
+
+    /**
+     * Check if timepoints have been merged or dropped
+     */
+    bool hasMergedTimepoints() const { return !mLayerTimepoints.empty(); }
+
+    /**
+     * Map of the merged (or dropped) timepoints to their representing
+     * timepoint
+     */
+    const std::map<solvers::temporal::point_algebra::TimePoint::Ptr, solvers::temporal::point_algebra::TimePoint::Ptr>& getMergedTimepoints() const { return mLayerTimepoints; }
+
+    /**
+     * Collapse timepoints which are equal in all solutions of the
+     * qualitative temporal constraint network, i.e. which are related by
+     * Equal constraints, or which form a cycle of LessOrEqual constraints.
+     * Optionally, timepoints which are neither the start or end of any
+     * interval, nor part of a quantitative constraint (or a quantitative
+     * timepoint) are dropped, since they do not affect any requirement
+     * \param timepoints Timepoints of the mission
+     * \param constraints Constraints of the mission
+     * \param intervals Intervals of the requirements
+     * \param dropUnused Drop the timepoints which are not used by intervals
+     * or quantitative constraints
+     * \return representing timepoint for each timepoint (the timepoint itself
+     * for representatives), or an empty pointer for dropped timepoints
+     */
+    static std::map<solvers::temporal::point_algebra::TimePoint::Ptr, solvers::temporal::point_algebra::TimePoint::Ptr> mergeTimepoints(
+            const solvers::temporal::point_algebra::TimePoint::PtrList& timepoints,
+            const Constraint::PtrList& constraints,
+            const std::vector<solvers::temporal::Interval>& intervals,
+            bool dropUnused);
+
     size_t getNumberOfTimepoints() const { return mNumberOfTimepoints; }
     size_t getNumberOfFluents() const { return mNumberOfFluents; }
 
     const qxcfg::Configuration& configuration() const { return mConfiguration; }
 
-
+    /**
+     * Compute the signature of a requirement, which identifies its domain
+     * \details Accounts for the required resources as well as the min and max
+     * cardinalities, i.e., requirements at different locations or
+     * intervals can share the same domain
+     */
+    static templ::utils::Hash128 getDomainSignature(const FluentTimeResource& ftr);
+
+    /**
+     * Lookup the domain for a requirement signature
+     * \return true if the domain is available, false otherwise
+     */
+    bool getExtensionalDomain(const templ::utils::Hash128& signature, ExtensionalDomain& domain) const;
+
+    /**
+     * Store the domain for a requirement signature
+     */
+    void putExtensionalDomain(const templ::utils::Hash128& signature, const ExtensionalDomain& domain);
+
+    /**
+     * Get the travel times between all locations for the model of a role
+     * \details The travel times are computed once per model, the returned
+     * reference remains valid for the lifetime of the context
+     * \see Reachability::computeTravelTimes
+     */
+    const Reachability::TravelTimes& getTravelTimes(const Role& role);
+
+    /**
+     * Get the cache for min cost flow solutions of this mission
+     */
+    FlowSolutionCache& flowSolutionCache() { return *mpFlowSolutionCache; }
+
+    /**
+     * Acquire an incremental flow graph for exclusive use
+     * \details Flow graphs (and their LP) live as long as this context and
+     * are reused across min cost flow runs; a released graph is handed out
+     * again, so that the number of graphs is bounded by the number of
+     * concurrent runs, independent of the threads performing them
+     * \return an idle flow graph, or a new one if none is idle
+     */
+    transshipment::IncrementalFlowGraph::Ptr acquireIncrementalFlowGraph();
+
+    /**
+     * Release a flow graph acquired with acquireIncrementalFlowGraph
+     */
+    void releaseIncrementalFlowGraph(const transshipment::IncrementalFlowGraph::Ptr& flowGraph);
 
 private:
     moreorg::OrganizationModelAsk mAsk;
@@ -39,8 +160,32 @@ private:
     /// Configuration object
     qxcfg::Configuration mConfiguration;
 
+    /// Timepoints forming the layers of the time expanded network
+    solvers::temporal::point_algebra::TimePoint::PtrList mTimepoints;
+    /// Representing timepoint of merged and dropped timepoints
+    std::map<solvers::temporal::point_algebra::TimePoint::Ptr, solvers::temporal::point_algebra::TimePoint::Ptr> mLayerTimepoints;
+
     size_t mNumberOfTimepoints;
     size_t mNumberOfFluents;
+
+    /// Domains of requirements by signature (accessed concurrently by the
+    /// spaces of a portfolio search)
+    mutable std::mutex mExtensionalDomainsMutex;
+    std::unordered_map<templ::utils::Hash128, ExtensionalDomain> mExtensionalDomains;
+
+    /// Distances between the mission's locations
+    DistanceMatrix::Ptr mpDistanceMatrix;
+    /// Travel times by model (accessed concurrently by the spaces of a
+    /// portfolio search)
+    std::mutex mTravelTimesMutex;
+    std::map<owlapi::model::IRI, Reachability::TravelTimes> mTravelTimes;
+
+    /// Min cost flow solutions (thread-safe)
+    shared_ptr<FlowSolutionCache> mpFlowSolutionCache;
+
+    /// Persistent flow graphs which are currently not in use
+    std::mutex mIncrementalFlowGraphsMutex;
+    std::vector<transshipment::IncrementalFlowGraph::Ptr> mIdleIncrementalFlowGraphs;
 };
 
 } // end namespace csp
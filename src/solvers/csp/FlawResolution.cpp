@@ -5,6 +5,10 @@
 #include "MissionConstraintManager.hpp"
 #include <moreorg/PropertyConstraint.hpp>
 #include "../../constraints/ModelConstraint.hpp"
+#include <thread>
+#include <limits>
+#include <algorithm>
+#include <cmath>
 
 namespace ga = graph_analysis::algorithms;
 
@@ -27,11 +31,12 @@ FlawResolution::FlawResolution(const FlawResolution& other)
 
 void FlawResolution::prepare(const std::vector<transshipment::Flaw>& flaws)
 {
-    mResolutionOptions.clear();
-    mDraws.clear();
+    ResolutionOptions resolutionOptions;
 
     if(flaws.empty())
     {
+        mResolutionOptions = resolutionOptions;
+        mDraws = templ::utils::Combinations();
         return;
     }
 
@@ -42,7 +47,7 @@ void FlawResolution::prepare(const std::vector<transshipment::Flaw>& flaws)
         {
             case ga::ConstraintViolation::TransFlow:
             case ga::ConstraintViolation::TotalTransFlow:
-                mResolutionOptions.push_back(ResolutionOption(flaw,0) );
+                resolutionOptions.push_back(ResolutionOption(flaw,0) );
                 break;
             case ga::ConstraintViolation::MinFlow:
             case ga::ConstraintViolation::TotalMinFlow:
@@ -57,30 +62,27 @@ void FlawResolution::prepare(const std::vector<transshipment::Flaw>& flaws)
         }
     }
 
-    Draw indices;
-    for(size_t i = 0; i < mResolutionOptions.size(); ++i)
+    // Enumerating the combinations of more options is infeasible either way
+    // (2^n - 1 draws), while dropping options would silently ignore flaws
+    if(resolutionOptions.size() > templ::utils::Combinations::MAX_ITEMS)
     {
-        indices.push_back(i);
+        throw std::invalid_argument("templ::solvers::csp::FlawResolution::prepare: "
+                + std::to_string(resolutionOptions.size()) + " resolution options exceed the supported maximum of "
+                + std::to_string(templ::utils::Combinations::MAX_ITEMS));
     }
 
-    if(!indices.empty())
-    {
-        numeric::Combination<size_t> combinations(indices, 1, numeric::MAX);
-        do {
-            Draw combination = combinations.current();
-            mDraws.push_back(combination);
-        } while(combinations.next());
-    }
+    mResolutionOptions = resolutionOptions;
+    mDraws = templ::utils::Combinations(resolutionOptions.size());
 }
 
 FlawResolution::ResolutionOptions FlawResolution::current() const
 {
     if(TransportNetwork::msInteractive)
     {
-        std::cout << "Resolutions options: " << mResolutionOptions.size() << " draw:" << toString(mCurrentDraw);
+        std::cout << "Resolutions options: " << mResolutionOptions->size() << " draw:" << toString(mCurrentDraw);
         std::cin.ignore( std::numeric_limits<std::streamsize>::max(), '\n' );
     }
-    return select<ResolutionOption>(mResolutionOptions, mCurrentDraw);
+    return select<ResolutionOption>(*mResolutionOptions, mCurrentDraw);
 }
 
 std::string FlawResolution::toString(const ResolutionOptions& options)
@@ -112,24 +114,43 @@ std::string FlawResolution::toString(const Draw& draw)
 
 bool FlawResolution::next(bool random) const
 {
-    if(mDraws.empty())
-    {
-        return false;
-    }
+    return mDraws.next(mCurrentDraw, random, mGenerator);
+}
 
-    if(!random)
-    {
-        mCurrentDraw = mDraws.back();
-        mDraws.pop_back();
-    } else {
-        size_t optionsSize = mDraws.size();
-        std::uniform_int_distribution<> dis(0,optionsSize-1);
-        size_t idx = dis(mGenerator);
-        mCurrentDraw = mDraws.at(idx);
-        mDraws.erase( mDraws.begin() + idx);
-        mDraws.resize(optionsSize-1);
-    }
-    return true;
+FlawResolution::Stop::Stop(double costBound, bool tightenBound)
+    : Gecode::Search::Stop()
+    , mBestCost(costBound)
+    , mTightenBound(tightenBound)
+{}
+
+void FlawResolution::Stop::update(double cost)
+{
+    double currentBest = mBestCost.load();
+    while(cost < currentBest && !mBestCost.compare_exchange_weak(currentBest, cost))
+    {}
+}
+
+bool FlawResolution::Stop::cancelled(double bound) const
+{
+    double bestCost = mBestCost.load();
+    return bestCost == 0 || (mTightenBound && bestCost < bound);
+}
+
+bool FlawResolution::Stop::stop(const Gecode::Search::Statistics& s, const Gecode::Search::Options& o)
+{
+    return mBestCost.load() == 0;
+}
+
+FlawResolution::EvaluationStop::EvaluationStop(const Stop& shared, double bound, double timeoutInMs)
+    : Gecode::Search::Stop()
+    , mShared(shared)
+    , mBound(bound)
+    , mTimeStop(timeoutInMs)
+{}
+
+bool FlawResolution::EvaluationStop::stop(const Gecode::Search::Statistics& s, const Gecode::Search::Options& o)
+{
+    return mShared.cancelled(mBound) || mTimeStop.stop(s,o);
 }
 
 Constraint::PtrList FlawResolution::selectBestResolution(Gecode::Space& space,
@@ -145,54 +166,166 @@ Constraint::PtrList FlawResolution::selectBestResolution(Gecode::Space& space,
     }
 
     const TransportNetwork& transportNetwork = dynamic_cast<const TransportNetwork&>(lastSolution);
+    const qxcfg::Configuration& configuration = transportNetwork.mpContext->configuration();
+    double timeoutInMs = 1000*configuration.getValueAs<double>("TransportNetwork/search/options/flaw-resolution/timeout_in_s",30);
+    // Concurrent evaluation relies on thread-safe organization model queries,
+    // see selectBestResolution
+    int numberOfThreads = configuration.getValueAs<int>("TransportNetwork/search/options/flaw-resolution/threads",1);
+    if(numberOfThreads <= 0)
+    {
+        numberOfThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
 
     double cost = transportNetwork.cost().val();
-    double improvedCost = cost;
 
-    EvaluationList evaluationList;
-    Constraint::PtrList testGroup;
-    for(size_t a = 0; a < constraints.size(); ++a)
+    // Evaluate each candidate on its own
+    std::vector<Constraint::PtrList> groups;
+    for(const Constraint::Ptr& candidate : constraints)
     {
-        testGroup.push_back( constraints[a] );
+        groups.push_back( Constraint::PtrList({ candidate }) );
+    }
+    EvaluationList evaluations = evaluate(space, groups, numberOfThreads, timeoutInMs, cost, false);
 
-        Evaluation eval = evaluate(space, lastSolution, testGroup);
-        if(eval.second >= improvedCost)
+    // Order the improving candidates by their cost
+    std::vector<size_t> improving;
+    for(size_t i = 0; i < evaluations.size(); ++i)
+    {
+        if(evaluations[i].second < cost)
         {
-            // remove constraint that deteriorated/did not improve the solution
-            testGroup.pop_back();
-            continue;
-        } else {
-            evaluationList.push_back(eval);
-            improvedCost = eval.second;
+            improving.push_back(i);
         }
+    }
+    if(improving.empty())
+    {
+        return Constraint::PtrList();
+    }
+    std::stable_sort(improving.begin(), improving.end(), [&evaluations](size_t a, size_t b)
+            {
+                return evaluations[a].second < evaluations[b].second;
+            });
 
-        if(improvedCost == 0)
+    Evaluation best = evaluations[ improving.front() ];
+    if(best.second == 0 || improving.size() == 1)
+    {
+        return best.first;
+    }
+
+    // Evaluate the growing prefixes of the ordered candidates, where the
+    // prefix of size one has already been evaluated
+    std::vector<Constraint::PtrList> prefixes;
+    Constraint::PtrList prefix = best.first;
+    for(size_t i = 1; i < improving.size(); ++i)
+    {
+        prefix.push_back( constraints[ improving[i] ] );
+        prefixes.push_back(prefix);
+    }
+    evaluations = evaluate(space, prefixes, numberOfThreads, timeoutInMs, best.second, true);
+    for(const Evaluation& evaluation : evaluations)
+    {
+        if(evaluation.second < best.second)
         {
-            return testGroup;
+            best = evaluation;
         }
     }
+    return best.first;
+}
+
+FlawResolution::Evaluation FlawResolution::evaluate(Gecode::Space& space,
+        const Constraint::PtrList& constraints,
+        double timeoutInMs)
+{
+    Stop shared(std::numeric_limits<double>::max(), false);
+    EvaluationStop stop(shared, shared.getBestCost(), timeoutInMs);
+    double cost = search(createCandidate(space, constraints), &stop);
+    return Evaluation(constraints, cost);
+}
+
+FlawResolution::EvaluationList FlawResolution::evaluate(Gecode::Space& space,
+        const std::vector<Constraint::PtrList>& groups,
+        size_t numberOfThreads,
+        double timeoutInMs,
+        double costBound,
+        bool tightenBound)
+{
+    // Cloning is not thread-safe with respect to the original space, so
+    // create all candidates before distributing the search
+    std::vector< std::unique_ptr<Gecode::Space> > candidates;
+    for(const Constraint::PtrList& group : groups)
+    {
+        candidates.push_back( createCandidate(space, group) );
+    }
 
-    std::sort(evaluationList.begin(), evaluationList.end(), [](const Evaluation& a, const Evaluation& b)
+    std::vector<double> costs(candidates.size(), std::numeric_limits<double>::max());
+    std::atomic<size_t> nextCandidate(0);
+    Stop shared(costBound, tightenBound);
+
+    auto worker = [&candidates, &costs, &nextCandidate, &shared, costBound, tightenBound, timeoutInMs]()
+    {
+        size_t idx;
+        while( (idx = nextCandidate++) < candidates.size())
+        {
+            std::unique_ptr<Gecode::Space> candidate = std::move(candidates[idx]);
+            double bound = tightenBound ? shared.getBestCost() : costBound;
+            // No candidate can improve upon a zero-cost solution
+            if(bound == 0 || shared.cancelled(bound))
             {
-                return a.second < b.second;
-            });
+                continue;
+            }
+
+            try {
+                if(bound < std::numeric_limits<int>::max())
+                {
+                    TransportNetwork* transportNetwork = dynamic_cast<TransportNetwork*>(candidate.get());
+                    Gecode::rel(*transportNetwork, transportNetwork->cost(), Gecode::IRT_LE, static_cast<int>(std::ceil(bound)));
+                }
+
+                EvaluationStop stop(shared, bound, timeoutInMs);
+                costs[idx] = search(std::move(candidate), &stop);
+            } catch(const std::exception& e)
+            {
+                LOG_WARN_S << "Evaluation of resolution candidate failed: " << e.what();
+            }
+            shared.update(costs[idx]);
+        }
+    };
 
-    if(evaluationList.empty())
+    numberOfThreads = std::min(numberOfThreads, candidates.size());
+    if(numberOfThreads <= 1)
     {
-        return Constraint::PtrList();
+        worker();
+    } else {
+        std::vector<std::thread> workers;
+        for(size_t i = 0; i < numberOfThreads; ++i)
+        {
+            workers.push_back( std::thread(worker) );
+        }
+        for(std::thread& t : workers)
+        {
+            t.join();
+        }
     }
 
-    return evaluationList.front().first;
+    EvaluationList evaluations;
+    for(size_t i = 0; i < groups.size(); ++i)
+    {
+        evaluations.push_back( Evaluation(groups[i], costs[i]) );
+    }
+    return evaluations;
 }
 
-FlawResolution::Evaluation FlawResolution::evaluate(Gecode::Space& space,
-        const Gecode::Space& lastSolution,
+std::unique_ptr<Gecode::Space> FlawResolution::createCandidate(Gecode::Space& space,
         const Constraint::PtrList& constraints)
 {
-    Gecode::Space* master = space.clone();
-    TransportNetwork* transportNetwork = dynamic_cast<TransportNetwork*>(master);
+    std::unique_ptr<Gecode::Space> candidate(space.clone());
+    TransportNetwork* transportNetwork = dynamic_cast<TransportNetwork*>(candidate.get());
     MissionConstraintManager::apply(constraints, *transportNetwork);
+    transportNetwork->setUseMasterSlave(false);
+    return candidate;
+}
 
+double FlawResolution::search(std::unique_ptr<Gecode::Space> candidate, Gecode::Search::Stop* stop)
+{
+    TransportNetwork* transportNetwork = dynamic_cast<TransportNetwork*>(candidate.get());
     Gecode::Search::Options options;
     options.threads = 1;
     Gecode::Search::Cutoff * c = Gecode::Search::Cutoff::constant(1);
@@ -209,20 +342,19 @@ FlawResolution::Evaluation FlawResolution::evaluate(Gecode::Space& space,
     // options.node =
     // default failure cutoff
     // options.fail
-    options.stop = Gecode::Search::Stop::time(30000);
-    transportNetwork->setUseMasterSlave(false);
+    options.stop = stop;
     Gecode::RBS<TransportNetwork, Gecode::DFS> searchEngine(transportNetwork, options);
+    // the search engine operates on its own clone of the candidate
+    candidate.reset();
+
     TransportNetwork* solution = searchEngine.next();
     double cost = std::numeric_limits<double>::max();
-
     if(solution)
     {
         cost = solution->cost().val();
         delete solution;
-        delete master;
     }
-
-    return Evaluation(constraints, cost);
+    return cost;
 }
 
 FluentTimeResource::List FlawResolution::getAffectedRequirements(const SpaceTime::Point& spacetime,
@@ -273,7 +405,7 @@ Constraint::Ptr FlawResolution::translate(Gecode::Space& space,
 
     ga::ConstraintViolation::Type violationType = flaw.getViolation().getType();
     FluentTimeResource::List ftrs = getAffectedRequirements(flaw.getSpaceTime(),
-            violationType, lastSpace.mResourceRequirements);
+            violationType, *lastSpace.mResourceRequirements);
 
     switch(violationType)
     {
@@ -285,8 +417,8 @@ Constraint::Ptr FlawResolution::translate(Gecode::Space& space,
                     case 0:
                     {
                             std::set<Role> uniqueRoles = MissionConstraints::getUniqueRoles(lastSpace.mRoleUsage,
-                                    currentSpace.mRoles,
-                                    currentSpace.mResourceRequirements,
+                                    *currentSpace.mRoles,
+                                    *currentSpace.mResourceRequirements,
                                     ftrs,
                                     flaw.affectedRole().getModel());
 
@@ -300,7 +432,7 @@ Constraint::Ptr FlawResolution::translate(Gecode::Space& space,
                     case 1:
                     {
                         FluentTimeResource::List ftrs = getAffectedRequirements(flaw.getSpaceTime(),
-                            violationType, lastSpace.mResourceRequirements);
+                            violationType, *lastSpace.mResourceRequirements);
 
                         constraints::ModelConstraint::Ptr constraint = make_shared<constraints::ModelConstraint>(
                                 constraints::ModelConstraint::MIN_FUNCTION,
@@ -323,7 +455,7 @@ Constraint::Ptr FlawResolution::translate(Gecode::Space& space,
             {
                 case 0:
                     FluentTimeResource::List ftrs = getAffectedRequirements(flaw.getSpaceTime(),
-                        violationType, lastSpace.mResourceRequirements);
+                        violationType, *lastSpace.mResourceRequirements);
 
                     constraints::ModelConstraint::Ptr constraint = make_shared<constraints::ModelConstraint>(
                             constraints::ModelConstraint::MIN_PROPERTY,
@@ -3,8 +3,11 @@
 
 #include <vector>
 #include <random>
-#include <numeric/Combinatorics.hpp>
+#include <atomic>
+#include <memory>
 #include "../transshipment/Flaw.hpp"
+#include "../../utils/CopyOnWrite.hpp"
+#include "../../utils/Combinations.hpp"
 #include <gecode/search.hh>
 //#include <graph_analysis/algorithms/ConstraintViolation.hpp>
 
@@ -39,6 +42,9 @@ public:
     /**
      * Prepare the flaw resolution for an array of the
      * given size
+     * \details The combinations of resolution options are enumerated lazily
+     * \throws std::invalid_argument if the number of resolution options
+     * exceeds templ::utils::Combinations::MAX_ITEMS
      */
     void prepare(const std::vector<transshipment::Flaw>& flaws);
 
@@ -55,9 +61,13 @@ public:
     /**
      * Return the list of resolution options
      */
-    const ResolutionOptions& getResolutionOptions() const { return mResolutionOptions; }
+    const ResolutionOptions& getResolutionOptions() const { return *mResolutionOptions; }
 
-    const DrawList& remainingDraws() const { return mDraws; }
+    /**
+     * Return the combinations of resolution options that have not been drawn
+     * yet
+     */
+    const templ::utils::Combinations& remainingDraws() const { return mDraws; }
 
     bool exhausted() { return mDraws.empty(); }
 
@@ -78,15 +88,140 @@ public:
     static std::string toString(const ResolutionOptions& options);
     static std::string toString(const Draw& draw);
 
+    /**
+     * Stop object which is shared by all evaluations of a set of resolution
+     * candidates
+     * \details Holds the best cost found by any of the candidates, and stops
+     * once a zero-cost candidate has been found, since no other candidate can
+     * improve upon it. If the bound is tightened, an evaluation is also
+     * cancelled once another candidate has improved upon the bound the
+     * evaluation was started with: the first solution of the cancelled
+     * search might still have been cheaper, but is not guaranteed to be, so
+     * the time budget is left to the remaining candidates
+     *
+     * All members can be accessed concurrently
+     */
+    class Stop : public Gecode::Search::Stop
+    {
+    public:
+        /**
+         * \param costBound Cost which has to be improved upon
+         * \param tightenBound Cancel evaluations once the best cost has
+         * been improved upon by another candidate
+         */
+        Stop(double costBound, bool tightenBound);
+
+        /**
+         * Update the best cost with the cost of an evaluated candidate
+         */
+        void update(double cost);
+
+        double getBestCost() const { return mBestCost.load(); }
+
+        /**
+         * Check whether an evaluation which has been started with the given
+         * bound can be cancelled
+         */
+        bool cancelled(double bound) const;
+
+        virtual bool stop(const Gecode::Search::Statistics& s, const Gecode::Search::Options& o);
+
+    private:
+        std::atomic<double> mBestCost;
+        bool mTightenBound;
+    };
+
+    /**
+     * Stop object for the evaluation of a single resolution candidate, which
+     * combines a time limit with the shared Stop object
+     */
+    class EvaluationStop : public Gecode::Search::Stop
+    {
+    public:
+        EvaluationStop(const Stop& shared, double bound, double timeoutInMs);
+
+        virtual bool stop(const Gecode::Search::Statistics& s, const Gecode::Search::Options& o);
+
+    private:
+        const Stop& mShared;
+        double mBound;
+        Gecode::Search::TimeStop mTimeStop;
+    };
+
+    /**
+     * Select the best group of resolution constraints
+     * \details The selection requires at most two evaluations per candidate
+     * constraint:
+     * first, each candidate is evaluated on its own and the candidates which
+     * improve the existing solution are ordered by their cost. Then, the
+     * groups formed by the growing prefixes of this order are evaluated
+     * and the best group is selected.
+     *
+     * The maximum number of worker threads and the time budget per evaluation are set
+     * by TransportNetwork/search/options/flaw-resolution/threads (default: 1) and
+     * TransportNetwork/search/options/flaw-resolution/timeout_in_s.
+     * With more than one thread the candidates are searched concurrently,
+     * which assumes that the propagation of a TransportNetwork only
+     * accesses the shared Context through its thread-safe caches, and that
+     * the organization model queries (Context::ask) are safe for concurrent
+     * read access -- the latter is not guaranteed by moreorg
+     * \return best group of constraints, or an empty list if no group improves
+     * the existing solution
+     */
     static Constraint::PtrList selectBestResolution(Gecode::Space& space,
             const Gecode::Space& lastSolution,
             uint32_t existingCost,
             const FlawResolution::ResolutionOptions& resolutionOptions);
 
+    /**
+     * Evaluate a single group of constraints, i.e. search for the first
+     * solution of the space with the constraints applied
+     * \return evaluation with the cost of the solution, or the maximum double
+     * value if no solution has been found
+     */
     static Evaluation evaluate(Gecode::Space& space,
-            const Gecode::Space& lastSolution,
+            const Constraint::PtrList& constraints,
+            double timeoutInMs = 30000.0);
+
+    /**
+     * Evaluate the groups of constraints using the given number of worker
+     * threads
+     * \details Each candidate is constrained to a cost below the cost bound,
+     * so that candidates which cannot improve upon it fail early.
+     * If tightenBound is set, the bound is lowered to the best cost found so
+     * far before a candidate is searched, and running evaluations are
+     * cancelled once another candidate improves upon their bound (\see Stop).
+     * When a zero-cost group has been found, all other evaluations are
+     * cancelled
+     * \param costBound Cost which has to be improved upon
+     * \return evaluations in the order of the groups, where groups that were
+     * cancelled or did not improve upon the bound have the maximum double
+     * value as cost
+     */
+    static EvaluationList evaluate(Gecode::Space& space,
+            const std::vector<Constraint::PtrList>& groups,
+            size_t numberOfThreads,
+            double timeoutInMs,
+            double costBound,
+            bool tightenBound);
+
+    /**
+     * Create a clone of the space with the constraints applied
+     * \details Cloning modifies the original space, so that this function
+     * must not be called concurrently for the same space
+     */
+    static std::unique_ptr<Gecode::Space> createCandidate(Gecode::Space& space,
             const Constraint::PtrList& constraints);
 
+    /**
+     * Search the first solution of a candidate space
+     * \param candidate Candidate space
+     * \param stop Stop object for the search
+     * \return cost of the solution, or the maximum double value if no solution
+     * has been found
+     */
+    static double search(std::unique_ptr<Gecode::Space> candidate, Gecode::Search::Stop* stop);
+
     static Constraint::Ptr translate(Gecode::Space& space,
             const Gecode::Space& lastSolution,
             const ResolutionOption& resolutionOption);
@@ -98,10 +233,13 @@ public:
 private:
     mutable std::mt19937 mGenerator;
 
-    mutable DrawList mDraws;
+    // Draws are enumerated lazily (with O(n) state), and resolution options
+    // are shared between copies of the flaw resolution (and thus between
+    // clones of a space) until they are modified
+    mutable templ::utils::Combinations mDraws;
     mutable Draw mCurrentDraw;
 
-    mutable ResolutionOptions mResolutionOptions;
+    templ::utils::CopyOnWrite<ResolutionOptions> mResolutionOptions;
 
 };
 } // end namespace csp
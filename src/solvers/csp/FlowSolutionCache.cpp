@@ -0,0 +1,207 @@
+#include "FlowSolutionCache.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace templ {
+namespace solvers {
+namespace csp {
+
+FlowSolutionCache::FlowSolutionCache(const symbols::constants::Location::PtrList& locations,
+        const temporal::point_algebra::TimePoint::PtrList& timepoints,
+        size_t maxSize,
+        size_t numberOfShards)
+    : mLocations(locations)
+    , mTimepoints(timepoints)
+    , mMaxSize(maxSize)
+    , mHits(0)
+    , mMisses(0)
+    , mEvictions(0)
+{
+    for(size_t i = 0; i < mLocations.size(); ++i)
+    {
+        mLocationIndices[ mLocations[i].get() ] = i;
+    }
+    for(size_t i = 0; i < mTimepoints.size(); ++i)
+    {
+        mTimepointIndices[ mTimepoints[i].get() ] = i;
+    }
+
+    numberOfShards = std::max(numberOfShards, static_cast<size_t>(1));
+    for(size_t i = 0; i < numberOfShards; ++i)
+    {
+        mShards.push_back(make_shared<Shard>(i));
+    }
+}
+
+void FlowSolutionCache::updateKey(Key& key, const std::map<Role, RoleTimeline>& timelines) const
+{
+    key.update(timelines.size());
+    for(const std::pair<const Role, RoleTimeline>& p : timelines)
+    {
+        const Role& role = p.first;
+        key.update(role.getModel().toString());
+        key.update(role.getId());
+
+        const SpaceTime::Timeline& timeline = p.second.getTimeline();
+        key.update(timeline.size());
+        for(const SpaceTime::Point& point : timeline)
+        {
+            std::unordered_map<const symbols::constants::Location*, size_t>::const_iterator lit = mLocationIndices.find(point.first.get());
+            if(lit == mLocationIndices.end())
+            {
+                throw std::invalid_argument("templ::solvers::csp::FlowSolutionCache::computeKey: unknown location '"
+                        + point.first->toString() + "'");
+            }
+            std::unordered_map<const temporal::point_algebra::TimePoint*, size_t>::const_iterator tit = mTimepointIndices.find(point.second.get());
+            if(tit == mTimepointIndices.end())
+            {
+                throw std::invalid_argument("templ::solvers::csp::FlowSolutionCache::computeKey: unknown timepoint '"
+                        + point.second->toString() + "'");
+            }
+            key.update(lit->second);
+            key.update(tit->second);
+        }
+    }
+}
+
+FlowSolutionCache::Key FlowSolutionCache::computeKey(const std::map<Role, RoleTimeline>& expandedTimelines,
+        const std::map<Role, RoleTimeline>& minRequiredTimelines) const
+{
+    Key key;
+    updateKey(key, expandedTimelines);
+    // separate both maps
+    key.update(0xffffffffffffffffULL);
+    updateKey(key, minRequiredTimelines);
+    return key;
+}
+
+FlowSolutionCache::ValuePtr FlowSolutionCache::get(const Key& key)
+{
+    ValuePtr value;
+    {
+        Shard& shard = getShard(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        std::unordered_map<Key, Entry>::iterator it = shard.entries.find(key);
+        if(it == shard.entries.end())
+        {
+            ++mMisses;
+            return ValuePtr();
+        }
+        // mark as most recently used
+        shard.lru.splice(shard.lru.begin(), shard.lru, it->second.lruIt);
+        ++mHits;
+        value = it->second.value;
+    }
+    // cached entries are never modified, so that the copy does not require
+    // the lock
+    return clone(value);
+}
+
+void FlowSolutionCache::put(const Key& key, const ValuePtr& solution)
+{
+    ValuePtr value = clone(solution);
+
+    Shard& shard = getShard(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    std::unordered_map<Key, Entry>::iterator it = shard.entries.find(key);
+    if(it != shard.entries.end())
+    {
+        it->second.value = value;
+        shard.lru.splice(shard.lru.begin(), shard.lru, it->second.lruIt);
+        return;
+    }
+
+    shard.lru.push_front(key);
+    Entry entry;
+    entry.value = value;
+    entry.lruIt = shard.lru.begin();
+    shard.entries[key] = entry;
+
+    evict(shard);
+}
+
+void FlowSolutionCache::setMaxSize(size_t maxSize)
+{
+    mMaxSize = maxSize;
+    for(shared_ptr<Shard>& shard : mShards)
+    {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        evict(*shard);
+    }
+}
+
+size_t FlowSolutionCache::size() const
+{
+    size_t size = 0;
+    for(const shared_ptr<Shard>& shard : mShards)
+    {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        size += shard->entries.size();
+    }
+    return size;
+}
+
+void FlowSolutionCache::clear()
+{
+    for(shared_ptr<Shard>& shard : mShards)
+    {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        shard->entries.clear();
+        shard->lru.clear();
+    }
+    mHits = 0;
+    mMisses = 0;
+    mEvictions = 0;
+}
+
+FlowSolutionCache::Shard& FlowSolutionCache::getShard(const Key& key)
+{
+    return *mShards[ key.second % mShards.size() ];
+}
+
+void FlowSolutionCache::evict(Shard& shard)
+{
+    if(mMaxSize.load() == 0)
+    {
+        return;
+    }
+
+    size_t maxShardSize = getMaxShardSize(shard);
+    while(shard.entries.size() > maxShardSize)
+    {
+        shard.entries.erase(shard.lru.back());
+        shard.lru.pop_back();
+        ++mEvictions;
+    }
+}
+
+size_t FlowSolutionCache::getMaxShardSize(const Shard& shard) const
+{
+    size_t maxSize = mMaxSize.load();
+    if(maxSize == 0)
+    {
+        return 0;
+    }
+    // with fewer entries than shards, the last shards cannot hold any entry
+    size_t maxShardSize = maxSize / mShards.size();
+    if(shard.index < maxSize % mShards.size())
+    {
+        ++maxShardSize;
+    }
+    return maxShardSize;
+}
+
+FlowSolutionCache::ValuePtr FlowSolutionCache::clone(const ValuePtr& value)
+{
+    if(!value)
+    {
+        return value;
+    }
+    return make_shared<const Value>(value->first, value->second.clone());
+}
+
+} // end namespace csp
+} // end namespace solvers
+} // end namespace templ
@@ -0,0 +1,161 @@
+#ifndef TEMPL_SOLVERS_CSP_FLOW_SOLUTION_CACHE_HPP
+#define TEMPL_SOLVERS_CSP_FLOW_SOLUTION_CACHE_HPP
+
+#include <atomic>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "../../SpaceTime.hpp"
+#include "../../utils/Hash.hpp"
+#include "../transshipment/Flaw.hpp"
+#include "RoleTimeline.hpp"
+
+namespace templ {
+namespace solvers {
+namespace csp {
+
+/**
+ * \class FlowSolutionCache
+ * \details Thread-safe and size bounded cache for the results of the min cost
+ * flow optimization
+ *
+ * Entries are identified by a 128 bit content hash of the expanded and the
+ * minimal required timelines. Locations and timepoints enter the hash by
+ * their index in the mission, so that a cache is only valid for the mission
+ * it has been created for (see Context). The cache is split into a number of shards,
+ * which are locked independently, so that parallel search workers can share
+ * results. Each shard evicts its least recently used entries once the
+ * size bound has been reached; the size bound is split exactly between the
+ * shards.
+ *
+ * Solution networks share their tuples when being copied, while the solution
+ * analysis modifies tuple attributes. Hence, the cache stores a deep copy of a
+ * network and returns a deep copy for each hit, so that no network is shared
+ * between search spaces.
+ */
+class FlowSolutionCache
+{
+public:
+    typedef utils::Hash128 Key;
+    typedef std::pair< std::vector<transshipment::Flaw>, SpaceTime::Network> Value;
+    typedef shared_ptr<const Value> ValuePtr;
+
+    /**
+     * \param locations Locations of the mission
+     * \param timepoints Timepoints of the mission
+     * \param maxSize Maximum number of entries, 0 for no limit
+     * \param numberOfShards Number of independently locked shards
+     */
+    FlowSolutionCache(const symbols::constants::Location::PtrList& locations,
+            const temporal::point_algebra::TimePoint::PtrList& timepoints,
+            size_t maxSize = 1000,
+            size_t numberOfShards = 16);
+
+    /**
+     * Compute the key for a pair of expanded and minimal required timelines
+     * \throws std::invalid_argument if a timeline contains a location or
+     * timepoint which is not part of this cache's mission
+     */
+    Key computeKey(const std::map<Role, RoleTimeline>& expandedTimelines,
+            const std::map<Role, RoleTimeline>& minRequiredTimelines) const;
+
+    /**
+     * Lookup a cached solution
+     * \return a copy of the cached solution, or an empty pointer if none
+     * exists
+     */
+    ValuePtr get(const Key& key);
+
+    /**
+     * Add a copy of a solution to the cache (possibly evicting the least
+     * recently used entries)
+     */
+    void put(const Key& key, const ValuePtr& value);
+
+    /**
+     * Set the maximum number of entries, 0 for no limit
+     */
+    void setMaxSize(size_t maxSize);
+    size_t getMaxSize() const { return mMaxSize; }
+
+    /**
+     * Get the current number of entries
+     */
+    size_t size() const;
+
+    /**
+     * Remove all entries and reset statistics
+     */
+    void clear();
+
+    uint64_t getHits() const { return mHits.load(); }
+    uint64_t getMisses() const { return mMisses.load(); }
+    uint64_t getEvictions() const { return mEvictions.load(); }
+
+private:
+    typedef std::list<Key> LRUList;
+
+    struct Entry
+    {
+        ValuePtr value;
+        LRUList::iterator lruIt;
+    };
+
+    struct Shard
+    {
+        explicit Shard(size_t index)
+            : index(index)
+        {}
+
+        /// Position of this shard, which determines its share of the size bound
+        size_t index;
+        mutable std::mutex mutex;
+        /// Most recently used key at the front
+        LRUList lru;
+        std::unordered_map<Key, Entry> entries;
+    };
+
+    Shard& getShard(const Key& key);
+
+    void updateKey(Key& key, const std::map<Role, RoleTimeline>& timelines) const;
+
+    /**
+     * Evict entries from the shard until the size bound holds
+     * (shard has to be locked)
+     */
+    void evict(Shard& shard);
+
+    /**
+     * Get the maximum number of entries of a shard, 0 for no limit
+     * \return the size bound divided by the number of shards, where the first
+     * shards take the remainder
+     */
+    size_t getMaxShardSize(const Shard& shard) const;
+
+    /**
+     * Create a deep copy of a solution
+     */
+    static ValuePtr clone(const ValuePtr& value);
+
+    /// Locations and timepoints are kept, so that the index remains valid
+    symbols::constants::Location::PtrList mLocations;
+    temporal::point_algebra::TimePoint::PtrList mTimepoints;
+    std::unordered_map<const symbols::constants::Location*, size_t> mLocationIndices;
+    std::unordered_map<const temporal::point_algebra::TimePoint*, size_t> mTimepointIndices;
+
+    std::vector< shared_ptr<Shard> > mShards;
+    std::atomic<size_t> mMaxSize;
+
+    std::atomic<uint64_t> mHits;
+    std::atomic<uint64_t> mMisses;
+    std::atomic<uint64_t> mEvictions;
+};
+
+} // end namespace csp
+} // end namespace solvers
+} // end namespace templ
+#endif // TEMPL_SOLVERS_CSP_FLOW_SOLUTION_CACHE_HPP
@@ -0,0 +1,173 @@
+#include "Portfolio.hpp"
+#include <limits>
+#include <algorithm>
+#include <base-logging/Logging.hpp>
+
+namespace templ {
+namespace solvers {
+namespace csp {
+
+Portfolio::AssetConfiguration::AssetConfiguration()
+    : seed(0)
+    , modelUsageAfcDecay(0.95)
+    , roleUsageAfcDecay(0.95)
+    , timelineAfcDecay(0.95)
+    , cutoffType(GEOMETRIC)
+{}
+
+Portfolio::AssetStatistics::AssetStatistics()
+    : restarts(0)
+    , flowEvaluations(0)
+    , solutions(0)
+{}
+
+Portfolio::Stop::Stop(const Portfolio::Ptr& portfolio, double timeoutInMs)
+    : Gecode::Search::Stop()
+    , mpPortfolio(portfolio)
+    , mTimeStop(timeoutInMs)
+{}
+
+bool Portfolio::Stop::stop(const Gecode::Search::Statistics& s, const Gecode::Search::Options& o)
+{
+    return mpPortfolio->isTerminated() || mTimeStop.stop(s,o);
+}
+
+Portfolio::Portfolio(const qxcfg::Configuration& configuration)
+    : mIncumbentCost(std::numeric_limits<int>::max())
+    , mTerminated(false)
+{
+    size_t numberOfAssets = std::max(1, configuration.getValueAs<int>("TransportNetwork/search/options/portfolio/assets",1));
+    unsigned int seed = configuration.getValueAs<unsigned int>("TransportNetwork/search/options/portfolio/seed",0);
+    double afcDecayStep = configuration.getValueAs<double>("TransportNetwork/search/options/portfolio/afc-decay-step",0.02);
+
+    double modelAfcDecay = configuration.getValueAs<double>("TransportNetwork/search/options/model-usage/afc-decay",0.95);
+    double roleAfcDecay = configuration.getValueAs<double>("TransportNetwork/search/options/role-usage/afc-decay",0.95);
+    double timelineAfcDecay = configuration.getValueAs<double>("TransportNetwork/search/options/timeline-brancher/afc-decay",0.95);
+
+    // Gecode requires a decay in (0,1], so limit the variation to a sensible
+    // range
+    double minDecay = 0.5;
+    for(size_t asset = 0; asset < numberOfAssets; ++asset)
+    {
+        AssetConfiguration assetConfiguration;
+        assetConfiguration.seed = seed == 0 ? 0 : seed + asset;
+        assetConfiguration.modelUsageAfcDecay = std::max(minDecay, modelAfcDecay - asset*afcDecayStep);
+        assetConfiguration.roleUsageAfcDecay = std::max(minDecay, roleAfcDecay - asset*afcDecayStep);
+        assetConfiguration.timelineAfcDecay = std::max(minDecay, timelineAfcDecay - asset*afcDecayStep);
+        // The first asset corresponds to the default (single engine) search
+        assetConfiguration.cutoffType = static_cast<CutoffType>(asset % END_CUTOFF_TYPE);
+
+        LOG_INFO_S << "Portfolio asset #" << asset << ":" << std::endl
+            << "    seed: " << assetConfiguration.seed << std::endl
+            << "    model-usage/afc-decay: " << assetConfiguration.modelUsageAfcDecay << std::endl
+            << "    role-usage/afc-decay: " << assetConfiguration.roleUsageAfcDecay << std::endl
+            << "    timeline-brancher/afc-decay: " << assetConfiguration.timelineAfcDecay << std::endl
+            << "    cutoff: " << toString(assetConfiguration.cutoffType);
+
+        mAssetConfigurations.push_back(assetConfiguration);
+    }
+    mAssetStatistics.resize(numberOfAssets);
+}
+
+const Portfolio::AssetConfiguration& Portfolio::getAssetConfiguration(size_t asset) const
+{
+    if(asset < mAssetConfigurations.size())
+    {
+        return mAssetConfigurations[asset];
+    }
+    throw std::invalid_argument("templ::solvers::csp::Portfolio::getAssetConfiguration: asset index is out of bounds");
+}
+
+void Portfolio::initializeRnd(size_t asset, Gecode::Rnd& rnd) const
+{
+    unsigned int seed = getAssetConfiguration(asset).seed;
+    if(seed == 0)
+    {
+        rnd.hw();
+    } else {
+        rnd.seed(seed);
+    }
+}
+
+Gecode::Search::Cutoff* Portfolio::createCutoff(size_t asset, unsigned int scale) const
+{
+    switch(getAssetConfiguration(asset).cutoffType)
+    {
+        case GEOMETRIC:
+            //Cutoff::geometric: s*b^i, for i = 0,1,2,3,4
+            return Gecode::Search::Cutoff::geometric(scale,2);
+        case LUBY:
+            return Gecode::Search::Cutoff::luby(scale);
+        case LINEAR:
+            return Gecode::Search::Cutoff::linear(scale);
+        case CONSTANT:
+            return Gecode::Search::Cutoff::constant(scale);
+        default:
+            break;
+    }
+    throw std::invalid_argument("templ::solvers::csp::Portfolio::createCutoff: unknown cutoff type");
+}
+
+bool Portfolio::updateIncumbentCost(int cost)
+{
+    int current = mIncumbentCost.load();
+    while(cost < current)
+    {
+        if(mIncumbentCost.compare_exchange_weak(current, cost))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void Portfolio::reset()
+{
+    mTerminated = false;
+}
+
+void Portfolio::incrementRestarts(size_t asset)
+{
+    std::lock_guard<std::mutex> lock(mStatisticsMutex);
+    ++mAssetStatistics.at(asset).restarts;
+}
+
+void Portfolio::incrementFlowEvaluations(size_t asset)
+{
+    std::lock_guard<std::mutex> lock(mStatisticsMutex);
+    ++mAssetStatistics.at(asset).flowEvaluations;
+}
+
+void Portfolio::incrementSolutions(size_t asset)
+{
+    std::lock_guard<std::mutex> lock(mStatisticsMutex);
+    ++mAssetStatistics.at(asset).solutions;
+}
+
+Portfolio::AssetStatistics Portfolio::getStatistics(size_t asset) const
+{
+    std::lock_guard<std::mutex> lock(mStatisticsMutex);
+    return mAssetStatistics.at(asset);
+}
+
+std::string Portfolio::toString(CutoffType type)
+{
+    switch(type)
+    {
+        case GEOMETRIC:
+            return "geometric";
+        case LUBY:
+            return "luby";
+        case LINEAR:
+            return "linear";
+        case CONSTANT:
+            return "constant";
+        default:
+            break;
+    }
+    return "unknown";
+}
+
+} // end namespace csp
+} // end namespace solvers
+} // end namespace templ
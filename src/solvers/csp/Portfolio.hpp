@@ -0,0 +1,163 @@
+#ifndef TEMPL_SOLVERS_CSP_PORTFOLIO_HPP
+#define TEMPL_SOLVERS_CSP_PORTFOLIO_HPP
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <gecode/search.hh>
+#include <qxcfg/Configuration.hpp>
+#include "../../SharedPtr.hpp"
+
+namespace templ {
+namespace solvers {
+namespace csp {
+
+/**
+ * \class Portfolio
+ * \details Shared state of a portfolio search, where a number of assets
+ * (differently seeded and differently branching copies of the same space)
+ * are run concurrently
+ *
+ * All spaces that are cloned from the same root space share the same
+ * portfolio instance, so that the incumbent cost bound and the per-asset
+ * statistics are available to all assets
+ */
+class Portfolio
+{
+public:
+    typedef shared_ptr<Portfolio> Ptr;
+
+    /**
+     * The type of cutoff sequence used by the restart based search of an
+     * asset
+     */
+    enum CutoffType { GEOMETRIC = 0, LUBY, LINEAR, CONSTANT, END_CUTOFF_TYPE };
+
+    /**
+     * Search parameters of a single asset
+     */
+    struct AssetConfiguration
+    {
+        AssetConfiguration();
+
+        /// Seed for the random branchers (INT_VAL_RND, SET_VAL_RND_EXC, ...)
+        /// a seed of 0 uses hardware seeding
+        unsigned int seed;
+        double modelUsageAfcDecay;
+        double roleUsageAfcDecay;
+        double timelineAfcDecay;
+        CutoffType cutoffType;
+    };
+
+    /**
+     * Search statistics of a single asset
+     */
+    struct AssetStatistics
+    {
+        AssetStatistics();
+
+        /// Number of restarts of this asset
+        uint32_t restarts;
+        /// Number of min cost flow evaluations, i.e. full candidate solutions
+        uint32_t flowEvaluations;
+        /// Number of solutions found by this asset
+        uint32_t solutions;
+    };
+
+    /**
+     * Stop object for all assets of a portfolio, which combines a time limit
+     * with the termination of the portfolio
+     */
+    class Stop : public Gecode::Search::Stop
+    {
+    public:
+        Stop(const Portfolio::Ptr& portfolio, double timeoutInMs);
+
+        virtual bool stop(const Gecode::Search::Statistics& s, const Gecode::Search::Options& o);
+
+    private:
+        Portfolio::Ptr mpPortfolio;
+        Gecode::Search::TimeStop mTimeStop;
+    };
+
+    /**
+     * Create the portfolio from the configuration, i.e. using
+     * TransportNetwork/search/options/portfolio
+     */
+    Portfolio(const qxcfg::Configuration& configuration);
+
+    /**
+     * Get the number of assets
+     */
+    size_t getNumberOfAssets() const { return mAssetConfigurations.size(); }
+
+    /**
+     * Get the search parameters for the asset with the given index
+     */
+    const AssetConfiguration& getAssetConfiguration(size_t asset) const;
+
+    /**
+     * Initialize a random number generator for the given asset
+     */
+    void initializeRnd(size_t asset, Gecode::Rnd& rnd) const;
+
+    /**
+     * Create the cutoff sequence for the given asset
+     * \param scale scaling factor of the cutoff sequence
+     * \return cutoff object (ownership goes to the search engine)
+     */
+    Gecode::Search::Cutoff* createCutoff(size_t asset, unsigned int scale) const;
+
+    /**
+     * Get the current incumbent cost bound, i.e. the lowest cost of a
+     * solution found by any asset
+     */
+    int getIncumbentCost() const { return mIncumbentCost.load(); }
+
+    /**
+     * Update the incumbent cost bound
+     * \return true if the cost is an improvement, false otherwise
+     */
+    bool updateIncumbentCost(int cost);
+
+    /**
+     * Stop all assets, e.g., once the minimum number of required
+     * solutions has been found
+     */
+    void terminate() { mTerminated = true; }
+
+    /**
+     * Check if the portfolio has been terminated
+     */
+    bool isTerminated() const { return mTerminated.load(); }
+
+    /**
+     * Reset the termination flag, e.g. for a new epoch -- the incumbent cost
+     * bound is kept
+     */
+    void reset();
+
+    void incrementRestarts(size_t asset);
+    void incrementFlowEvaluations(size_t asset);
+    void incrementSolutions(size_t asset);
+
+    /**
+     * Get a snapshot of the statistics of a single asset
+     */
+    AssetStatistics getStatistics(size_t asset) const;
+
+    static std::string toString(CutoffType type);
+
+private:
+    std::vector<AssetConfiguration> mAssetConfigurations;
+    std::vector<AssetStatistics> mAssetStatistics;
+    mutable std::mutex mStatisticsMutex;
+
+    std::atomic<int> mIncumbentCost;
+    std::atomic<bool> mTerminated;
+};
+
+} // end namespace csp
+} // end namespace solvers
+} // end namespace templ
+#endif // TEMPL_SOLVERS_CSP_PORTFOLIO_HPP
@@ -88,7 +88,7 @@ double RoleTimeline::travelDistance() const
     {
         path.push_back(p.first);
     }
-    return Cost::getTravelDistance(path);
+    return Cost::getTravelDistance(path, mpDistanceMatrix);
 }
 
 double RoleTimeline::estimatedEnergyCost() const
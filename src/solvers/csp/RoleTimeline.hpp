@@ -5,6 +5,7 @@
 #include <moreorg/vocabularies/Robot.hpp>
 #include "../FluentTimeResource.hpp"
 #include "../../SpaceTime.hpp"
+#include "../DistanceMatrix.hpp"
 #include "../temporal/point_algebra/TimePointComparator.hpp"
 
 namespace templ {
@@ -44,6 +45,12 @@ public:
 
     void add(const SpaceTime::Point& point) { mTimeline.push_back(point); }
 
+    /**
+     * Set the distance matrix that should be used to compute the travel
+     * distance
+     */
+    void setDistanceMatrix(const DistanceMatrix::Ptr& distanceMatrix) { mpDistanceMatrix = distanceMatrix; }
+
     bool operator<(const RoleTimeline& other) const;
 
     size_t size() const { return mTimeline.size(); }
@@ -101,6 +108,7 @@ private:
     SpaceTime::Timeline mTimeline;
 
     moreorg::facades::Robot mRobot;
+    DistanceMatrix::Ptr mpDistanceMatrix;
 };
 
 } // end namespace csp
@@ -32,6 +32,7 @@
 #include "utils/Converter.hpp"
 #include "../../utils/CSVLogger.hpp"
 #include "MissionConstraints.hpp"
+#include "../CoalitionFeasibilityCache.hpp"
 #include "Search.hpp"
 #include "../SolutionAnalysis.hpp"
 #include "MissionConstraintManager.hpp"
@@ -45,7 +46,6 @@ namespace solvers {
 namespace csp {
 
 bool TransportNetwork::msInteractive = false;
-TransportNetwork::FlowSolutions TransportNetwork::msMinCostFlowSolutions;
 
 std::string TransportNetwork::Solution::toString(uint32_t indent) const
 {
@@ -103,10 +103,13 @@ bool TransportNetwork::master(const Gecode::MetaInfo& mi)
             {
                 constrain(*mi.last());
             }
+            constrainToIncumbent();
             mi.nogoods().post(*this);
             return true;
         case Gecode::MetaInfo::PORTFOLIO:
-            Gecode::BrancherGroup::all.kill(*this);
+            // Keep all branchers: the assets are differentiated by the
+            // asset specific configuration when the branchers are (lazily)
+            // posted, see slave()
             break;
         default:
             break;
@@ -132,7 +135,7 @@ void TransportNetwork::next(const TransportNetwork& lastSpace, const Gecode::Met
 
     breakpointStart()
         << "next():" << std::endl
-        << "    # flaws: " << mMinCostFlowFlaws.size() << std::endl
+        << "    # flaws: " << mMinCostFlowFlaws->size() << std::endl
         << "    # resolution options: " <<
         mFlawResolution.remainingDraws().size() << std::endl
         ;
@@ -180,7 +183,7 @@ void TransportNetwork::constrain(const Gecode::Space& lastSpace)
         << "constrain()" << std::endl
         << "Last state: " << std::endl
         << "    # cost: "<< lastTransportNetwork.mCost.val() << std::endl
-        << "    # flaws: "<< lastTransportNetwork.mMinCostFlowFlaws.size() << std::endl
+        << "    # flaws: "<< lastTransportNetwork.mMinCostFlowFlaws->size() << std::endl
         << "    # resolution options: " << lastTransportNetwork.mFlawResolution.remainingDraws().size() <<
         std::endl
         << "Current: " << std::endl
@@ -198,6 +201,22 @@ void TransportNetwork::constrain(const Gecode::Space& lastSpace)
     }
 }
 
+void TransportNetwork::constrainToIncumbent()
+{
+    bool hillClimbing = mpContext->configuration().getValueAs<bool>("TransportNetwork/search/options/hill-climbing",false);
+    if(!hillClimbing)
+    {
+        return;
+    }
+
+    // Use the best solution found by any asset of the portfolio
+    int incumbentCost = mpPortfolio->getIncumbentCost();
+    if(incumbentCost != std::numeric_limits<int>::max())
+    {
+        rel(*this, cost(), Gecode::IRT_LE, incumbentCost);
+    }
+}
+
 void TransportNetwork::constrainSlave(const Gecode::Space& lastSpace)
 {
     const TransportNetwork& lastTransportNetwork = static_cast<const TransportNetwork&>(lastSpace);
@@ -205,7 +224,7 @@ void TransportNetwork::constrainSlave(const Gecode::Space& lastSpace)
     breakpointStart()
          << "constrainSlave()" << std::endl
          << "Last state: " << std::endl
-         << "    # flaws: "<< lastTransportNetwork.mMinCostFlowFlaws.size() << std::endl
+         << "    # flaws: "<< lastTransportNetwork.mMinCostFlowFlaws->size() << std::endl
          << "    # resolution options: " << lastTransportNetwork.mFlawResolution.remainingDraws().size() << std::endl;
     breakpointEnd();
 
@@ -236,6 +255,15 @@ void TransportNetwork::constrainSlave(const Gecode::Space& lastSpace)
 // previous solution
 bool TransportNetwork::slave(const Gecode::MetaInfo& mi)
 {
+    if(mi.type() == Gecode::MetaInfo::PORTFOLIO)
+    {
+        // Each asset starts from a clone of the root space, so the asset
+        // index will be inherited by all spaces of this asset
+        mAssetIdx = mi.asset();
+        return true;
+    }
+    mpPortfolio->incrementRestarts(mAssetIdx);
+
     if(!mUseMasterSlave)
     {
         // using default implementation of slave, i.e. search is complete
@@ -293,8 +321,8 @@ TransportNetwork::Solution TransportNetwork::getSolution() const
         solution.mTimelines = getTimelines();
         solution.mLocations = mpContext->locations();
         solution.mTimepoints = mTimepoints;
-        solution.mMinCostFlowSolution = mMinCostFlowSolution;
-        solution.mSolutionAnalysis = mSolutionAnalysis;
+        solution.mMinCostFlowSolution = *mMinCostFlowSolution;
+        solution.mSolutionAnalysis = *mSolutionAnalysis;
     } catch(std::exception& e)
     {
         LOG_WARN_S << e.what();
@@ -304,26 +332,39 @@ TransportNetwork::Solution TransportNetwork::getSolution() const
 
 void TransportNetwork::saveSolution(const Solution& solution, const Mission::Ptr& mission)
 {
-    std::string filename;
     int i = mission->getLogger()->getSessionId();
-    try {
+    templ::utils::ArtifactWriter::Ptr writer = mission->getLogger()->getArtifactWriter();
+    // Snapshot the graph (vertices and edges included) once for all
+    // artifacts, since the solution might change while they are written
+    graph_analysis::BaseGraph::Ptr graph = solution.getMinCostFlowSolution().getGraph()->clone();
+    {
         std::stringstream ss;
         ss << "transport-network-solution-" << i << ".dot";
-        filename = mission->getLogger()->filename(ss.str());
-        graph_analysis::io::GraphIO::write(filename, solution.getMinCostFlowSolution().getGraph());
-    } catch(const std::exception& e)
-    {
-        LOG_WARN_S << "Saving file " << filename << " failed: -- " << e.what();
+        std::string filename = mission->getLogger()->filename(ss.str());
+        writer->enqueue([filename, graph]()
+            {
+                try {
+                    graph_analysis::io::GraphIO::write(filename, graph);
+                } catch(const std::exception& e)
+                {
+                    LOG_WARN_S << "Saving file " << filename << " failed: -- " << e.what();
+                }
+            });
     }
 
-    try {
+    {
         std::stringstream ss;
         ss << "transport-network-solution-" << i << ".gexf";
-        filename = mission->getLogger()->filename(ss.str());
-        solution.getMinCostFlowSolution().save(filename, "gexf");
-    } catch(const std::exception& e)
-    {
-        LOG_WARN_S << "Saving file " << filename << " failed: -- " << e.what();
+        std::string filename = mission->getLogger()->filename(ss.str());
+        writer->enqueue([filename, graph]()
+            {
+                try {
+                    graph_analysis::io::GraphIO::write(filename, graph, graph_analysis::representation::GEXF);
+                } catch(const std::exception& e)
+                {
+                    LOG_WARN_S << "Saving file " << filename << " failed: -- " << e.what();
+                }
+            });
     }
 
     try {
@@ -339,10 +380,10 @@ TransportNetwork::ModelDistribution TransportNetwork::getModelDistribution() con
     ModelDistribution solution;
 
     Gecode::Matrix<Gecode::IntVarArray> resourceDistribution(mModelUsage,
-            mpMission->getAvailableResources().size(), mResourceRequirements.size());
+            mpMission->getAvailableResources().size(), mResourceRequirements->size());
 
     // Check if resource requirements holds
-    for(size_t i = 0; i < mResourceRequirements.size(); ++i)
+    for(size_t i = 0; i < mResourceRequirements->size(); ++i)
     {
         moreorg::ModelPool modelPool;
         for(size_t mi = 0; mi < mpMission->getAvailableResources().size(); ++mi)
@@ -358,7 +399,7 @@ TransportNetwork::ModelDistribution TransportNetwork::getModelDistribution() con
             modelPool[ mpMission->getModels()[mi] ] = v.val();
         }
 
-        solution[ mResourceRequirements[i] ] = modelPool;
+        solution[ (*mResourceRequirements)[i] ] = modelPool;
     }
     return solution;
 }
@@ -367,29 +408,29 @@ TransportNetwork::RoleDistribution TransportNetwork::getRoleDistribution() const
 {
     RoleDistribution solution;
 
-    Gecode::Matrix<Gecode::IntVarArray> roleDistribution(mRoleUsage, /*width --> col*/ mRoles.size(), /*height --> row*/ mResourceRequirements.size());
+    Gecode::Matrix<Gecode::IntVarArray> roleDistribution(mRoleUsage, /*width --> col*/ mRoles->size(), /*height --> row*/ mResourceRequirements->size());
 
     // Check if resource requirements holds
-    for(size_t i = 0; i < mResourceRequirements.size(); ++i)
+    for(size_t i = 0; i < mResourceRequirements->size(); ++i)
     {
         Role::List roles;
-        for(size_t r = 0; r < mRoles.size(); ++r)
+        for(size_t r = 0; r < mRoles->size(); ++r)
         {
             Gecode::IntVar var = roleDistribution(r, i);
             if(!var.assigned())
             {
-                throw std::runtime_error("templ::solvers::csp::RoleDistribution::getSolution: value has not been assigned for role: '" + mRoles[r].toString() + "'");
+                throw std::runtime_error("templ::solvers::csp::RoleDistribution::getSolution: value has not been assigned for role: '" + (*mRoles)[r].toString() + "'");
             }
 
             Gecode::IntVarValues v( var );
 
             if( v.val() == 1 )
             {
-                roles.push_back( mRoles[r] );
+                roles.push_back( (*mRoles)[r] );
             }
         }
 
-        solution[ mResourceRequirements[i] ] = roles;
+        solution[ (*mResourceRequirements)[i] ] = roles;
     }
 
     return solution;
@@ -398,23 +439,38 @@ TransportNetwork::RoleDistribution TransportNetwork::getRoleDistribution() const
 std::map<Role, csp::RoleTimeline> TransportNetwork::getTimelines() const
 {
     std::map<Role, csp::RoleTimeline> roleTimelines;
-    for(size_t i = 0; i < mActiveRoleList.size(); ++i)
+    for(size_t i = 0; i < mActiveRoleList->size(); ++i)
     {
-        const Role& role = mActiveRoleList[i];
-        LOG_INFO_S << "Active role: " << i << " of " << mActiveRoleList.size() << " " << mActiveRoleList[i].toString() << std::endl
-            << Formatter::toString(mTimelines[i],
+        const Role& role = (*mActiveRoleList)[i];
+
+        SpaceTime::Timeline timeline;
+        if(mSuccessorTimelines.empty())
+        {
+            bool doThrow = false;
+            LOG_INFO_S << "Active role: " << i << " of " << mActiveRoleList->size() << " " << (*mActiveRoleList)[i].toString() << std::endl
+                << Formatter::toString(mTimelines[i],
+                        mpContext->locations(),
+                        mTimepoints)
+                << std::endl;
+
+            timeline = TypeConversion::toTimeline(mTimelines[i],
                     mpContext->locations(),
-                    mTimepoints)
-            << std::endl;
+                    mTimepoints,
+                    doThrow);
+        } else {
+            LOG_INFO_S << "Active role: " << i << " of " << mActiveRoleList->size() << " " << (*mActiveRoleList)[i].toString() << std::endl
+                << mSuccessorTimelines[i] << std::endl;
 
-        bool doThrow = false;
-        SpaceTime::Timeline timeline = TypeConversion::toTimeline(mTimelines[i],
-                mpContext->locations(),
-                mTimepoints,
-                doThrow);
+            // All sequences are assigned once the timelines have been
+            // branched (see postRoleAssignments)
+            timeline = TypeConversion::toTimeline(mSuccessorTimelines[i],
+                    mpContext->locations(),
+                    mTimepoints);
+        }
 
         csp::RoleTimeline roleTimeline(role, mpContext->ask());
         roleTimeline.setTimeline(timeline);
+        roleTimeline.setDistanceMatrix(mpMission->getDistanceMatrix());
 
         roleTimelines[role] = roleTimeline;
 
@@ -432,7 +488,9 @@ TransportNetwork::TransportNetwork(const templ::Mission::Ptr& mission, const qxc
     , Solver(Solver::CSP_TRANSPORT_NETWORK)
     , mpMission(mission)
     , mpContext(make_shared<Context>(mission, configuration))
-    , mTimepoints(mission->getUnorderedTimepoints())
+    , mpPortfolio(make_shared<Portfolio>(configuration))
+    , mAssetIdx(0)
+    , mTimepoints(mpContext->timepoints())
     , mResourceRequirements()
     , mQualitativeTimepoints(*this, mpMission->getQualitativeTemporalConstraintNetwork()->getTimepoints().size(), 0, mpMission->getQualitativeTemporalConstraintNetwork()->getTimepoints().size()-1)
     , mModelUsage()
@@ -451,7 +509,7 @@ TransportNetwork::TransportNetwork(const templ::Mission::Ptr& mission, const qxc
     LOG_INFO_S << "TransportNetwork CSP Problem Construction" << std::endl
     << "    requested resources: " << mpMission->getRequestedResources() << std::endl
     << "    intervals: " << mpContext->intervals().size() << std::endl
-    << "    # requirements: " << mResourceRequirements.size() << std::endl;
+    << "    # requirements: " << mResourceRequirements->size() << std::endl;
 
     initializeTemporalConstraintNetwork();
 }
@@ -480,7 +538,7 @@ void TransportNetwork::initializeTemporalConstraintNetwork()
 
 void TransportNetwork::initializeMinMaxConstraints()
 {
-    Gecode::Matrix<Gecode::IntVarArray> resourceDistribution(mModelUsage, /*width --> col*/ mpMission->getAvailableResources().size(), /*height --> row*/ mResourceRequirements.size());
+    Gecode::Matrix<Gecode::IntVarArray> resourceDistribution(mModelUsage, /*width --> col*/ mpMission->getAvailableResources().size(), /*height --> row*/ mResourceRequirements->size());
 
 
     const IRIList& availableModels = mpMission->getModels();
@@ -490,13 +548,13 @@ void TransportNetwork::initializeMinMaxConstraints()
     // For debugging purposes
     ConstraintMatrix constraintMatrix(availableModels);
     using namespace solvers::temporal;
-    std::vector<FluentTimeResource>::const_iterator fit = mResourceRequirements.begin();
-    for(; fit != mResourceRequirements.end(); ++fit)
+    std::vector<FluentTimeResource>::const_iterator fit = mResourceRequirements->begin();
+    for(; fit != mResourceRequirements->end(); ++fit)
     {
         const FluentTimeResource& fts = *fit;
         // row: index of requirement
         // col: index of model type
-        size_t requirementIndex = fit - mResourceRequirements.begin();
+        size_t requirementIndex = fit - mResourceRequirements->begin();
         for(size_t mi = 0; mi < availableModels.size(); ++mi)
         {
             Gecode::IntVar v = resourceDistribution(mi, requirementIndex);
@@ -540,8 +598,8 @@ void TransportNetwork::initializeMinMaxConstraints()
     }
 
     std::vector<std::string> rowNames =
-        FluentTimeResource::toQualificationStringList(mResourceRequirements.begin(),
-            mResourceRequirements.end());
+        FluentTimeResource::toQualificationStringList(mResourceRequirements->begin(),
+            mResourceRequirements->end());
     LOG_INFO_S << constraintMatrix.toString(rowNames);
 
     breakpointStart()
@@ -554,28 +612,43 @@ void TransportNetwork::addExtensionalConstraints()
     size_t availableResourceCount = mpMission->getAvailableResources().size();
     Gecode::Matrix<Gecode::IntVarArray> resourceDistribution(mModelUsage,
             /*width --> col*/ availableResourceCount,
-            /*height --> row*/ mResourceRequirements.size());
+            /*height --> row*/ mResourceRequirements->size());
 
    size_t requirementIndex = 0;
-   for(const FluentTimeResource& ftr: mResourceRequirements)
+   for(const FluentTimeResource& ftr: *mResourceRequirements)
    {
         // Prepare the extensional constraints, i.e. specifying the allowed
         // combinations for each requirement
-        moreorg::ModelPool::Set allowedCombinations = ftr.getDomain();
-        if(allowedCombinations.empty())
+        //
+        // The domains are shared via the context, so that the organization
+        // model is only queried once per requirement signature and not again
+        // for restarts or other spaces
+        templ::utils::Hash128 signature = Context::getDomainSignature(ftr);
+        Context::ExtensionalDomain domain;
+        if(!mpContext->getExtensionalDomain(signature, domain))
+        {
+            domain.combinations = ftr.getDomain();
+            if(!domain.combinations.empty())
+            {
+                LOG_INFO_S << "Adding extensional constraint:\n" << ftr.toString(4);
+
+                // A tuple set is a fully expanded vector describing the cardinality for
+                // all available resources
+                Gecode::TupleSet tupleSet(availableResourceCount);
+                appendToTupleSet(tupleSet, domain.combinations);
+                tupleSet.finalize();
+                domain.tupleSet = tupleSet;
+            }
+            mpContext->putExtensionalDomain(signature, domain);
+        }
+
+        if(domain.combinations.empty())
         {
             LOG_WARN_S << "No allowed combinations available with the given constraints: failing this space";
             this->fail();
             return;
         }
-        LOG_INFO_S << "Adding extensional constraint:\n" << ftr.toString(4);
-
-        // A tuple set is a fully expanded vector describing the cardinality for
-        // all available resources
-        Gecode::TupleSet tupleSet(availableResourceCount);
-        appendToTupleSet(tupleSet, allowedCombinations);
-        tupleSet.finalize();
-        extensional(*this, resourceDistribution.row(requirementIndex), tupleSet);
+        extensional(*this, resourceDistribution.row(requirementIndex), domain.tupleSet);
         if(this->failed())
         {
             LOG_WARN_S  << "Adding extensional constraint lead to failed space"
@@ -588,7 +661,7 @@ void TransportNetwork::addExtensionalConstraints()
 
 void TransportNetwork::setUpperBoundForConcurrentRequirements()
 {
-    Gecode::Matrix<Gecode::IntVarArray> resourceDistribution(mModelUsage, /*width --> col*/ mpMission->getAvailableResources().size(), /*height --> row*/ mResourceRequirements.size());
+    Gecode::Matrix<Gecode::IntVarArray> resourceDistribution(mModelUsage, /*width --> col*/ mpMission->getAvailableResources().size(), /*height --> row*/ mResourceRequirements->size());
 
     // - identify overlapping fts, limit resources for these
     std::vector< std::vector<FluentTimeResource> > concurrentRequirements;
@@ -596,15 +669,16 @@ void TransportNetwork::setUpperBoundForConcurrentRequirements()
 
     if(nooverlap)
     {
-        for(const FluentTimeResource& ftr : mResourceRequirements)
+        for(const FluentTimeResource& ftr : *mResourceRequirements)
         {
             concurrentRequirements.push_back( { ftr } );
         }
     } else {
         // Make sure the correct constraints network is used for comparison
         temporal::point_algebra::TimePointComparator tpc(mpQualitativeTemporalConstraintNetwork);
-        // Make sure the assignments are within resource bounds for concurrent requirements
-        concurrentRequirements = FluentTimeResource::getMutualExclusive(mResourceRequirements, tpc);
+        // Make sure the assignments are within resource bounds for concurrent requirements:
+        // one constraint per maximal set of concurrent requirements
+        concurrentRequirements = FluentTimeResource::getMaximalMutualExclusive(*mResourceRequirements, mTimepoints, tpc);
     }
 
     const moreorg::ModelPool& modelPool = mpMission->getAvailableResources();
@@ -613,18 +687,16 @@ void TransportNetwork::setUpperBoundForConcurrentRequirements()
     for(const std::vector<FluentTimeResource>& concurrentFluents :
             concurrentRequirements)
     {
+        std::vector<FluentTimeResource::List> locationGroups = FluentTimeResource::groupByLocation(concurrentFluents);
+        if(!nooverlap && locationGroups.size() < 2)
+        {
+            continue;
+        }
+
         for(size_t mi = 0; mi < availableModels.size(); ++mi)
         {
             const IRI& model = availableModels[mi];
-            Gecode::IntVarArgs args;
-
-            std::vector<FluentTimeResource>::const_iterator fit = concurrentFluents.begin();
-            for(; fit != concurrentFluents.end(); ++fit)
-            {
-                size_t fluentIdx = FluentTimeResource::getIndex(mResourceRequirements, *fit);
-                Gecode::IntVar v = resourceDistribution(mi,fluentIdx);
-                args << v;
-            }
+            Gecode::IntVarArgs args = getConcurrentUsage(resourceDistribution, mi, locationGroups);
 
             uint32_t maxCardinality = modelPool.at(model);
             LOG_DEBUG_S << "Add general resource usage constraint: " << std::endl
@@ -643,8 +715,8 @@ void TransportNetwork::initializeRoleDistributionConstraints()
     bool immobileBoundedRoleUsage = mpContext->configuration().getValueAs<bool>("TransportNetwork/search/options/role-usage/immobile/bounded",false);
 
     // Role distribution
-    Gecode::Matrix<Gecode::IntVarArray> resourceDistribution(mModelUsage, /*width --> col*/ mpMission->getAvailableResources().size(), /*height --> row*/ mResourceRequirements.size());
-    Gecode::Matrix<Gecode::IntVarArray> roleDistribution(mRoleUsage, /*width --> col*/ mRoles.size(), /*height --> row*/ mResourceRequirements.size());
+    Gecode::Matrix<Gecode::IntVarArray> resourceDistribution(mModelUsage, /*width --> col*/ mpMission->getAvailableResources().size(), /*height --> row*/ mResourceRequirements->size());
+    Gecode::Matrix<Gecode::IntVarArray> roleDistribution(mRoleUsage, /*width --> col*/ mRoles->size(), /*height --> row*/ mResourceRequirements->size());
     {
         Gecode::IntVarArgs mobileModelBounds;
         Gecode::IntVarArgs immobileModelBounds;
@@ -671,11 +743,11 @@ void TransportNetwork::initializeRoleDistributionConstraints()
             uint32_t maxCardinality = modelPool.at(model);
 
             // Enforce bound per requirement
-            for(uint32_t requirementIndex = 0; requirementIndex < mResourceRequirements.size(); ++requirementIndex)
+            for(uint32_t requirementIndex = 0; requirementIndex < mResourceRequirements->size(); ++requirementIndex)
             {
                 Gecode::IntVar modelCount = resourceDistribution(modelIndex,requirementIndex);
                 Gecode::IntVarArgs args;
-                for(uint32_t roleIndex = 0; roleIndex < mRoles.size(); ++roleIndex)
+                for(uint32_t roleIndex = 0; roleIndex < mRoles->size(); ++roleIndex)
                 {
                     if(isRoleForModel(roleIndex, modelIndex))
                     {
@@ -773,8 +845,7 @@ void TransportNetwork::applyExtraConstraints()
     }
 }
 
-void TransportNetwork::applyAccessConstraints(ListOfAdjacencyLists& timelines,
-        size_t numberOfTimepoints,
+void TransportNetwork::applyAccessConstraints(size_t numberOfTimepoints,
         size_t numberOfLocations,
         const Role::List& roles)
 {
@@ -860,7 +931,7 @@ void TransportNetwork::applyAccessConstraints(ListOfAdjacencyLists& timelines,
 
     for(const LocationConstraints::value_type& locationConstraint : locationMinMax)
     {
-        ListOfAdjacencyLists selectedTimelines;
+        std::vector<size_t> selectedTimelines;
         const symbols::constants::Location::Ptr& location = locationConstraint.first;
         const ModelPool& minPool = locationConstraint.second.first;
         const ModelPool& maxPool = locationConstraint.second.second;
@@ -874,7 +945,7 @@ void TransportNetwork::applyAccessConstraints(ListOfAdjacencyLists& timelines,
             {
                 if(mpContext->ask().ontology().isSubClassOf( roles[i].getModel(), model ))
                 {
-                    selectedTimelines.push_back(timelines[i]);
+                    selectedTimelines.push_back(i);
                 }
             }
 
@@ -889,61 +960,196 @@ void TransportNetwork::applyAccessConstraints(ListOfAdjacencyLists& timelines,
             size_t min = minPool.at(model);
             size_t max = maxPool.at(model);
 
-            propagators::restrictInEdges(*this,
-                    selectedTimelines,
-                    numberOfTimepoints,
-                    numberOfLocations,
-                    locationIdx,
-                    min,
-                    max,
-                    location->toString() + "-" + model.toString());
+            if(mSuccessorTimelines.empty())
+            {
+                ListOfAdjacencyLists timelines;
+                for(size_t i : selectedTimelines)
+                {
+                    timelines.push_back(mTimelines[i]);
+                }
+                propagators::restrictInEdges(*this,
+                        timelines,
+                        numberOfTimepoints,
+                        numberOfLocations,
+                        locationIdx,
+                        min,
+                        max,
+                        location->toString() + "-" + model.toString());
+            } else {
+                // Count the arrivals at the location, i.e. the transitions from
+                // another location (entering the network is no transition)
+                int l = static_cast<int>(locationIdx);
+                int inactive = static_cast<int>(numberOfLocations);
+                Gecode::BoolVarArgs arrivals;
+                for(size_t i : selectedTimelines)
+                {
+                    const LocationSequence& sequence = mSuccessorTimelines[i];
+                    for(size_t t = 0; t + 1 < numberOfTimepoints; ++t)
+                    {
+                        arrivals << Gecode::expr(*this, sequence[t] != l && sequence[t] != inactive && sequence[t+1] == l);
+                    }
+                }
+                Gecode::linear(*this, arrivals, Gecode::IRT_GQ, static_cast<int>(min));
+                if(max < static_cast<size_t>(Gecode::Int::Limits::max))
+                {
+                    Gecode::linear(*this, arrivals, Gecode::IRT_LQ, static_cast<int>(max));
+                }
+            }
+        }
+    }
+}
+
+void TransportNetwork::applyReachabilityConstraints(size_t numberOfTimepoints,
+        size_t numberOfLocations,
+        const Role::List& roles)
+{
+    Constraint::PtrList constraints = mpMission->getConstraints();
+    constraints.insert(constraints.begin(),mConstraints.begin(), mConstraints.end());
+
+    Reachability reachability(mTimepoints, constraints);
+    if(!reachability.isBounded())
+    {
+        return;
+    }
+
+    size_t numberOfPrunedTransitions = 0;
+    for(size_t i = 0; i < roles.size(); ++i)
+    {
+        const Role& role = roles[i];
+        // Immobile roles are transported, so that their transitions depend
+        // on the mobile roles
+        using namespace moreorg::facades;
+        Robot robot = Robot::getInstance(role.getModel(), mpContext->ask());
+        if(!robot.isMobile())
+        {
+            continue;
+        }
+
+        const Reachability::TravelTimes& travelTimes = mpContext->getTravelTimes(role);
+        for(size_t t = 0; t + 1 < numberOfTimepoints; ++t)
+        {
+            if(!reachability.isBounded(t))
+            {
+                continue;
+            }
+
+            // Successor encoding: allowed transitions from t to t+1, indexed by
+            // from*(numberOfLocations+1) + to, where the last value of each
+            // dimension is the inactive value
+            size_t numberOfValues = numberOfLocations + 1;
+            std::vector<int> allowedTransitions(numberOfValues*numberOfValues, 1);
+            size_t numberOfDisallowedTransitions = 0;
+            for(size_t from = 0; from < numberOfLocations; ++from)
+            {
+                for(size_t to = 0; to < numberOfLocations; ++to)
+                {
+                    if(reachability.isReachable(travelTimes, numberOfLocations, t, from, to))
+                    {
+                        continue;
+                    }
+
+                    ++numberOfPrunedTransitions;
+                    if(mSuccessorTimelines.empty())
+                    {
+                        size_t row = FluentTimeIndex::toRowOrColumnIndex(from, t, numberOfLocations, numberOfTimepoints);
+                        size_t col = FluentTimeIndex::toRowOrColumnIndex(to, t + 1, numberOfLocations, numberOfTimepoints);
+                        Gecode::Set::SetView v(mTimelines[i][row]);
+                        if(Gecode::me_failed(v.exclude(*this, col, col)))
+                        {
+                            LOG_INFO_S << "Reachability: required transition cannot be travelled -- space failed";
+                            this->fail();
+                            return;
+                        }
+                    } else {
+                        allowedTransitions[from*numberOfValues + to] = 0;
+                        ++numberOfDisallowedTransitions;
+                    }
+                }
+            }
+
+            if(!mSuccessorTimelines.empty() && numberOfDisallowedTransitions > 0)
+            {
+                // Link the pair of successive locations to the table of
+                // allowed transitions
+                const LocationSequence& sequence = mSuccessorTimelines[i];
+                Gecode::IntVar transition = Gecode::expr(*this, static_cast<int>(numberOfValues)*sequence[t] + sequence[t+1]);
+                Gecode::element(*this, Gecode::IntArgs(allowedTransitions), transition, 1);
+            }
         }
     }
+
+    LOG_INFO_S << "Reachability: removed " << numberOfPrunedTransitions << " transitions of mobile roles";
 }
 
 void TransportNetwork::enforceUnaryResourceUsage()
 {
     // Role distribution
-    Gecode::Matrix<Gecode::IntVarArray> roleDistribution(mRoleUsage, /*width --> col*/ mRoles.size(), /*height --> row*/ mResourceRequirements.size());
+    Gecode::Matrix<Gecode::IntVarArray> roleDistribution(mRoleUsage, /*width --> col*/ mRoles->size(), /*height --> row*/ mResourceRequirements->size());
 
     // Set of available models: mModelPool
     // Make sure the assignments are within resource bounds for concurrent requirements
     temporal::point_algebra::TimePointComparator tpc(mpQualitativeTemporalConstraintNetwork);
     std::vector< std::vector<FluentTimeResource> > concurrentRequirements =
-        FluentTimeResource::getMutualExclusive(mResourceRequirements, tpc);
+        FluentTimeResource::getMaximalMutualExclusive(*mResourceRequirements, mTimepoints, tpc);
 
     for(const FluentTimeResource::List& concurrentFluents : concurrentRequirements)
     {
-        if(mRoles.size() < concurrentFluents.size())
+        std::vector<FluentTimeResource::List> locationGroups = FluentTimeResource::groupByLocation(concurrentFluents);
+        if(locationGroups.size() < 2)
+        {
+            continue;
+        }
+
+        if(mRoles->size() < locationGroups.size())
         {
             std::stringstream ss;
-            ss << "The number for agent instances (" << mRoles.size() << ") is too low,"
+            ss << "The number for agent instances (" << mRoles->size() << ") is too low,"
                << " to resolve the concurrent requirements ("
-               << concurrentFluents.size() << ") " << std::endl;
+               << locationGroups.size() << ") " << std::endl;
 
             throw std::runtime_error("templ::solvers::csp::TransportNetwork::enforceUnaryResourceUsage: "
                         + ss.str());
         }
 
-        for(size_t roleIndex = 0; roleIndex < mRoles.size(); ++roleIndex)
+        for(size_t roleIndex = 0; roleIndex < mRoles->size(); ++roleIndex)
         {
-            Gecode::IntVarArgs args;
-            for(const FluentTimeResource& fts : concurrentFluents)
-            {
-                size_t row = FluentTimeResource::getIndex(mResourceRequirements, fts);
-                Gecode::IntVar v = roleDistribution(roleIndex, row);
-                args << v;
-            }
-            // A role can only be available for one of the concurrent
-            // constraints
+            // A role can only be available at one of the locations of the
+            // concurrent requirements
+            Gecode::IntVarArgs args = getConcurrentUsage(roleDistribution, roleIndex, locationGroups);
             rel(*this, sum(args) <= 1);
         }
     }
 }
 
+Gecode::IntVarArgs TransportNetwork::getConcurrentUsage(Gecode::Matrix<Gecode::IntVarArray>& distribution,
+        size_t column,
+        const std::vector<FluentTimeResource::List>& locationGroups)
+{
+    Gecode::IntVarArgs usage;
+    for(const FluentTimeResource::List& group : locationGroups)
+    {
+        Gecode::IntVarArgs groupUsage;
+        for(const FluentTimeResource& ftr : group)
+        {
+            size_t row = FluentTimeResource::getIndex(*mResourceRequirements, ftr);
+            groupUsage << distribution(column, row);
+        }
+
+        if(groupUsage.size() == 1)
+        {
+            usage << groupUsage[0];
+        } else {
+            // Concurrent requirements at the same location can share
+            // resources
+            usage << Gecode::expr(*this, Gecode::max(groupUsage));
+        }
+    }
+    return usage;
+}
+
 Gecode::Symmetries TransportNetwork::identifySymmetries()
 {
-    Gecode::Matrix<Gecode::IntVarArray> roleDistribution(mRoleUsage, /*width --> col*/ mRoles.size(), /*height --> row*/ mResourceRequirements.size());
+    Gecode::Matrix<Gecode::IntVarArray> roleDistribution(mRoleUsage, /*width --> col*/ mRoles->size(), /*height --> row*/ mResourceRequirements->size());
 
     Gecode::Symmetries symmetries;
     // define interchangeable columns for roles of the same model type
@@ -953,9 +1159,9 @@ Gecode::Symmetries TransportNetwork::identifySymmetries()
         Gecode::IntVarArgs sameModelColumns;
         for(int c = 0; c < roleDistribution.width(); ++c)
         {
-            if( mRoles[c].getModel() == currentModel)
+            if( (*mRoles)[c].getModel() == currentModel)
             {
-                LOG_DEBUG_S << "Adding column of " << mRoles[c].toString() << " for symmetry";
+                LOG_DEBUG_S << "Adding column of " << (*mRoles)[c].toString() << " for symmetry";
                 sameModelColumns << roleDistribution.col(c);
             }
         }
@@ -968,6 +1174,8 @@ TransportNetwork::TransportNetwork(TransportNetwork& other)
     : Gecode::Space(other)
     , mpMission(other.mpMission)
     , mpContext(other.mpContext)
+    , mpPortfolio(other.mpPortfolio)
+    , mAssetIdx(other.mAssetIdx)
     , mResourceRequirements(other.mResourceRequirements)
     , mTemporalConstraintNetwork(other.mTemporalConstraintNetwork)
     , mTimepoints(other.mTimepoints)
@@ -1007,6 +1215,12 @@ TransportNetwork::TransportNetwork(TransportNetwork& other)
         mTimelines.push_back(array);
         mTimelines[i].update(*this, other.mTimelines[i]);
     }
+    for(size_t i = 0; i < other.mSuccessorTimelines.size(); ++i)
+    {
+        LocationSequence array;
+        mSuccessorTimelines.push_back(array);
+        mSuccessorTimelines[i].update(*this, other.mSuccessorTimelines[i]);
+    }
 
     //mCapacities.update(*this, other.mCapacities);
 }
@@ -1025,7 +1239,7 @@ std::vector<TransportNetwork::Solution> TransportNetwork::solve(const templ::Mis
     assert(!mission->getTimeIntervals().empty());
 
     /// Allow to log the final results into a csv file
-    CSVLogger csvLogger({"session",
+    CSVLogger::ColumnDescription columns({"session",
             "alpha",
             "beta",
             "sigma",
@@ -1048,22 +1262,53 @@ std::vector<TransportNetwork::Solution> TransportNetwork::solve(const templ::Mis
             "restart",
             "nogood",
             "flaws",
-            "cost"});
+            "cost",
+            "lp-cache-hits",
+            "lp-cache-misses",
+            "asset"});
 
     std::string baseDir = configuration.getValue("TransportNetwork/logging/basedir","/tmp");
     mission->getLogger()->setBaseDirectory(baseDir);
+    mission->getLogger()->setArtifactPolicy(
+            templ::utils::Logger::getArtifactPolicyFromTxt( configuration.getValue("TransportNetwork/logging/artifacts","all") ),
+            configuration.getValueAs<uint32_t>("TransportNetwork/logging/artifacts-interval",100));
 
     if( configuration.getValueAs<bool>("TransportNetwork/use-transfer-location"))
     {
         mission->enableTransferLocation();
     }
 
+    // The overrides have been applied to the organization model and change
+    // the results of the feasibility checks
+    CoalitionFeasibilityCache::getInstance().registerOrganizationModel(mission->getOrganizationModel(),
+            mission->getDataPropertyAssignments());
+
+    // Reuse the results of coalition feasibility checks from previous runs
+    std::string feasibilityCacheFile = configuration.getValue("TransportNetwork/search/options/coalition-feasibility/cache-file","");
+    if(!feasibilityCacheFile.empty())
+    {
+        CoalitionFeasibilityCache::getInstance().load(feasibilityCacheFile);
+    }
+
     /// Check if interactive mode should be used during the solution process
     TransportNetwork::msInteractive = configuration.getValueAs<bool>("TransportNetwork/search/interactive",false);
 
     TransportNetwork* distribution = new TransportNetwork(mission, configuration);
     distribution->mUseMasterSlave = configuration.getValueAs<bool>("TransportNetwork/search/options/master-slave",false);
 
+    // Per-asset statistics of the portfolio
+    Portfolio::Ptr portfolio = distribution->mpPortfolio;
+    size_t numberOfAssets = portfolio->getNumberOfAssets();
+    for(size_t asset = 0; asset < numberOfAssets; ++asset)
+    {
+        std::stringstream ss;
+        ss << "asset-" << asset << "-";
+        columns.push_back(ss.str() + "restarts");
+        columns.push_back(ss.str() + "flow-evaluations");
+        columns.push_back(ss.str() + "solutions");
+    }
+    CSVLogger csvLogger(columns);
+
     // Search options: Gecode 9.3.1
     // threads (double) number of parallel threads to use
     // c_d (unsigned int) commit recomputation distance
@@ -1076,6 +1321,10 @@ std::vector<TransportNetwork::Solution> TransportNetwork::solve(const templ::Mis
     // share_pbs     (bool) whether AFC is shared between assets
     // stop                 Stop object   (NULL if none)
     // cutoff               cutoff object (NULL if none)
+    //
+    // If more than one asset is configured (portfolio/assets) a portfolio
+    // search will be performed, where each asset runs a restart based search
+    // with an asset specific cutoff sequence (and branching configuration)
     int threads = distribution->mpContext->configuration().getValueAs<int>("TransportNetwork/search/options/threads",1);
 
     int cutoff = distribution->mpContext->configuration().getValueAs<int>("TransportNetwork/search/options/cutoff",10);
@@ -1102,12 +1351,31 @@ std::vector<TransportNetwork::Solution> TransportNetwork::solve(const templ::Mis
     while(!stop)
     {
         ++numberOfEpochs;
-        //Cutoff::geometric: s*b^i, for i = 0,1,2,3,4
-        // when the corresponding number of failure has been reached
-        // restart and continue
-        options.cutoff = Gecode::Search::Cutoff::geometric(cutoff,2);
-        options.stop = Gecode::Search::Stop::time(epochTimeoutInS*1000.0);
-        Gecode::RBS< TransportNetwork, Gecode::DFS > searchEngine(distribution, options);
+        portfolio->reset();
+
+        // The stop object is shared by all assets, so that all of them
+        // will be stopped once the minimum number of solutions has been found
+        Portfolio::Stop epochStop(portfolio, epochTimeoutInS*1000.0);
+        options.stop = &epochStop;
+
+        shared_ptr< Gecode::Search::Base<TransportNetwork> > searchEngine;
+        if(numberOfAssets > 1)
+        {
+            Gecode::SEBs sebs(numberOfAssets);
+            for(size_t asset = 0; asset < numberOfAssets; ++asset)
+            {
+                Gecode::Search::Options assetOptions = options;
+                assetOptions.cutoff = portfolio->createCutoff(asset, cutoff);
+                sebs[asset] = Gecode::rbs<TransportNetwork, Gecode::DFS>(assetOptions);
+            }
+            searchEngine = make_shared< Gecode::PBS<TransportNetwork, Gecode::DFS> >(distribution, sebs, options);
+        } else {
+            //Cutoff::geometric: s*b^i, for i = 0,1,2,3,4
+            // when the corresponding number of failure has been reached
+            // restart and continue
+            options.cutoff = portfolio->createCutoff(0, cutoff);
+            searchEngine = make_shared< Gecode::RBS<TransportNetwork, Gecode::DFS> >(distribution, options);
+        }
 
         //Gecode::TemplRBS< TransportNetwork, Gecode::DFS > searchEngine(distribution, options);
 
@@ -1118,7 +1386,7 @@ std::vector<TransportNetwork::Solution> TransportNetwork::solve(const templ::Mis
         base::Time allElapsed;
         base::Time elapsed;
         numeric::Stats<double> stats;
-        while(TransportNetwork* current = searchEngine.next())
+        while(TransportNetwork* current = searchEngine->next())
         {
             allElapsed = (base::Time::now() - allStart);
             elapsed = (base::Time::now() - start);
@@ -1136,38 +1404,65 @@ std::vector<TransportNetwork::Solution> TransportNetwork::solve(const templ::Mis
             std::cout << std::endl;
 
             csvLogger.addToRow(current->mpMission->getLogger()->getSessionId(),"session");
-            csvLogger.addToRow(current->mSolutionAnalysis.getAlpha(), "alpha");
-            csvLogger.addToRow(current->mSolutionAnalysis.getBeta(), "beta");
-            csvLogger.addToRow(current->mSolutionAnalysis.getSigma(), "sigma");
-            csvLogger.addToRow(current->mSolutionAnalysis.getEfficacy(), "efficacy");
-            csvLogger.addToRow(current->mSolutionAnalysis.getEfficiency(), "efficiency");
-            csvLogger.addToRow(current->mSolutionAnalysis.getSafety(), "safety");
-            csvLogger.addToRow(current->mSolutionAnalysis.getTimeHorizon(), "timehorizon");
-            csvLogger.addToRow(current->mSolutionAnalysis.getTravelledDistance(),"travel-distance");
-            csvLogger.addToRow(current->mSolutionAnalysis.getReconfigurationCost(),"reconfiguration-cost");
+            csvLogger.addToRow(current->mSolutionAnalysis->getAlpha(), "alpha");
+            csvLogger.addToRow(current->mSolutionAnalysis->getBeta(), "beta");
+            csvLogger.addToRow(current->mSolutionAnalysis->getSigma(), "sigma");
+            csvLogger.addToRow(current->mSolutionAnalysis->getEfficacy(), "efficacy");
+            csvLogger.addToRow(current->mSolutionAnalysis->getEfficiency(), "efficiency");
+            csvLogger.addToRow(current->mSolutionAnalysis->getSafety(), "safety");
+            csvLogger.addToRow(current->mSolutionAnalysis->getTimeHorizon(), "timehorizon");
+            csvLogger.addToRow(current->mSolutionAnalysis->getTravelledDistance(),"travel-distance");
+            csvLogger.addToRow(current->mSolutionAnalysis->getReconfigurationCost(),"reconfiguration-cost");
             csvLogger.addToRow(allElapsed.toSeconds(), "overall-runtime");
             csvLogger.addToRow(elapsed.toSeconds(), "solution-runtime");
             csvLogger.addToRow(stats.mean(), "solution-runtime-mean");
             csvLogger.addToRow(stats.stdev(), "solution-runtime-stdev");
-            csvLogger.addToRow(searchEngine.stopped(), "solution-stopped");
-            csvLogger.addToRow(searchEngine.statistics().propagate, "propagate");
-            csvLogger.addToRow(searchEngine.statistics().fail, "fail");
-            csvLogger.addToRow(searchEngine.statistics().node, "node");
-            csvLogger.addToRow(searchEngine.statistics().depth, "depth");
-            csvLogger.addToRow(searchEngine.statistics().restart, "restart");
-            csvLogger.addToRow(searchEngine.statistics().nogood, "nogood");
+            csvLogger.addToRow(searchEngine->stopped(), "solution-stopped");
+            csvLogger.addToRow(searchEngine->statistics().propagate, "propagate");
+            csvLogger.addToRow(searchEngine->statistics().fail, "fail");
+            csvLogger.addToRow(searchEngine->statistics().node, "node");
+            csvLogger.addToRow(searchEngine->statistics().depth, "depth");
+            csvLogger.addToRow(searchEngine->statistics().restart, "restart");
+            csvLogger.addToRow(searchEngine->statistics().nogood, "nogood");
             csvLogger.addToRow(1.0, "solution-found");
-            csvLogger.addToRow(best->mMinCostFlowFlaws.size(), "flaws");
+            csvLogger.addToRow(best->mMinCostFlowFlaws->size(), "flaws");
             csvLogger.addToRow(best->cost().val(), "cost");
+            csvLogger.addToRow(best->mpContext->flowSolutionCache().getHits(), "lp-cache-hits");
+            csvLogger.addToRow(best->mpContext->flowSolutionCache().getMisses(), "lp-cache-misses");
+
+            portfolio->incrementSolutions(current->mAssetIdx);
+            portfolio->updateIncumbentCost(current->cost().val());
+            csvLogger.addToRow(current->mAssetIdx, "asset");
+            for(size_t asset = 0; asset < numberOfAssets; ++asset)
+            {
+                Portfolio::AssetStatistics assetStatistics = portfolio->getStatistics(asset);
+                std::stringstream ss;
+                ss << "asset-" << asset << "-";
+                csvLogger.addToRow(assetStatistics.restarts, ss.str() + "restarts");
+                csvLogger.addToRow(assetStatistics.flowEvaluations, ss.str() + "flow-evaluations");
+                csvLogger.addToRow(assetStatistics.solutions, ss.str() + "solutions");
+            }
             csvLogger.commitRow();
 
             std::string filename =
                 mission->getLogger()->getBasePath() + "search-statistics.log";
             std::cout << "Saving stats in: " << filename << std::endl;
-            csvLogger.save(filename);
+            // Append row by row instead of rewriting the whole file
+            size_t rowIdx = csvLogger.getNumberOfRows() - 1;
+            if(rowIdx == 0)
+            {
+                mission->getLogger()->getArtifactWriter()->write(filename,
+                        csvLogger.columnDescriptionToString() + csvLogger.rowToString(rowIdx));
+            } else {
+                mission->getLogger()->getArtifactWriter()->append(filename,
+                        csvLogger.rowToString(rowIdx));
+            }
 
             Solution solution = current->getSolution();
-            saveSolution(solution, mission);
+            if(mission->getLogger()->logSolutionArtifacts())
+            {
+                saveSolution(solution, mission);
+            }
             // TODO: use serialization to filesystem for later retrieval
             solutions.push_back(solution);
             ++solutionCount;
@@ -1177,6 +1472,7 @@ std::vector<TransportNetwork::Solution> TransportNetwork::solve(const templ::Mis
                 if(solutionCount >= minNumberOfSolutions)
                 {
                     LOG_INFO_S << "Found minimum required number of solutions: " << solutions.size();
+                    portfolio->terminate();
                     stop = true;
                     break;
                 }
@@ -1188,7 +1484,7 @@ std::vector<TransportNetwork::Solution> TransportNetwork::solve(const templ::Mis
 
         std::cout << "Solution Search (epoch: " << numberOfEpochs << ")" << std::endl;
         std::cout << "    was stopped (e.g. timeout): ";
-        if(searchEngine.stopped())
+        if(searchEngine->stopped())
         {
             std::cout << " yes" << std::endl;
         } else {
@@ -1204,6 +1500,16 @@ std::vector<TransportNetwork::Solution> TransportNetwork::solve(const templ::Mis
     } // end while all
 
     delete distribution;
+    // Make sure all artifacts of this run have been written
+    mission->getLogger()->getArtifactWriter()->flush();
+
+    if(!feasibilityCacheFile.empty())
+    {
+        CoalitionFeasibilityCache& feasibilityCache = CoalitionFeasibilityCache::getInstance();
+        LOG_INFO_S << "Coalition feasibility cache: hits " << feasibilityCache.getHits()
+            << ", misses " << feasibilityCache.getMisses();
+        feasibilityCache.save(feasibilityCacheFile);
+    }
     return solutions;
 }
 
@@ -1227,13 +1533,13 @@ Constraint::PtrList TransportNetwork::getAssignmentsAsConstraints() const
 {
     using namespace moreorg;
     Constraint::PtrList constraints;
-    Gecode::Matrix<Gecode::IntVarArray> roleDistribution(mRoleUsage, /*width --> col*/ mRoles.size(), /*height --> row*/ mResourceRequirements.size());
+    Gecode::Matrix<Gecode::IntVarArray> roleDistribution(mRoleUsage, /*width --> col*/ mRoles->size(), /*height --> row*/ mResourceRequirements->size());
 
 
     // Min resource model constraints
-    for(size_t f = 0; f < mResourceRequirements.size(); ++f)
+    for(size_t f = 0; f < mResourceRequirements->size(); ++f)
     {
-        const FluentTimeResource& ftr = mResourceRequirements[f];
+        const FluentTimeResource& ftr = (*mResourceRequirements)[f];
 
         ModelPool modelPool = currentMinModelAssignment(ftr);
         for(const ModelPool::value_type& v : modelPool)
@@ -1248,15 +1554,15 @@ Constraint::PtrList TransportNetwork::getAssignmentsAsConstraints() const
         }
     }
 
-    for(size_t r = 0; r < mRoles.size(); ++r)
+    for(size_t r = 0; r < mRoles->size(); ++r)
     {
         FluentTimeResource::List presentAt;
-        for(size_t f = 0; f < mResourceRequirements.size(); ++f)
+        for(size_t f = 0; f < mResourceRequirements->size(); ++f)
         {
             Gecode::IntVar var = roleDistribution(r,f);
             if(var.assigned() && var.val() == 1)
             {
-                presentAt.push_back( mResourceRequirements[f] );
+                presentAt.push_back( (*mResourceRequirements)[f] );
             }
         }
 
@@ -1264,7 +1570,7 @@ Constraint::PtrList TransportNetwork::getAssignmentsAsConstraints() const
         {
             constraints::ModelConstraint::Ptr constraint = make_shared<constraints::ModelConstraint>(
                     constraints::ModelConstraint::MIN_EQUAL,
-                    mRoles[r].getModel(),
+                    (*mRoles)[r].getModel(),
                     MissionConstraintManager::mapToSpaceTime( presentAt ),
                     1
                     );
@@ -1346,23 +1652,23 @@ size_t TransportNetwork::getResourceModelMaxCardinality(size_t index) const
 
 bool TransportNetwork::isRoleForModel(uint32_t roleIndex, uint32_t modelIndex) const
 {
-    return mRoles.at(roleIndex).getModel() == mpMission->getModels().at(modelIndex);
+    return mRoles->at(roleIndex).getModel() == mpMission->getModels().at(modelIndex);
 }
 
 std::vector<uint32_t> TransportNetwork::computeActiveRoles() const
 {
     std::vector<uint32_t> activeRoles;
     // Identify active roles
-    Gecode::Matrix<Gecode::IntVarArray> roleDistribution(mRoleUsage, /*width --> col*/ mRoles.size(), /*height --> row*/ mResourceRequirements.size());
-    for(size_t r = 0; r < mRoles.size(); ++r)
+    Gecode::Matrix<Gecode::IntVarArray> roleDistribution(mRoleUsage, /*width --> col*/ mRoles->size(), /*height --> row*/ mResourceRequirements->size());
+    for(size_t r = 0; r < mRoles->size(); ++r)
     {
         size_t requirementCount = 0;
-        for(size_t i = 0; i < mResourceRequirements.size(); ++i)
+        for(size_t i = 0; i < mResourceRequirements->size(); ++i)
         {
             Gecode::IntVar var = roleDistribution(r,i);
             if(!var.assigned())
             {
-                throw std::runtime_error("templ::solvers::csp::TransportNetwork::postRoleAssignments: value has not been assigned for role: '" + mRoles[r].toString() + "'");
+                throw std::runtime_error("templ::solvers::csp::TransportNetwork::postRoleAssignments: value has not been assigned for role: '" + (*mRoles)[r].toString() + "'");
             }
             Gecode::IntVarValues v(var);
             if(v.val() == 1)
@@ -1385,16 +1691,16 @@ std::vector<uint32_t> TransportNetwork::computeActiveRoles() const
 moreorg::ModelPool TransportNetwork::currentMinModelAssignment(const FluentTimeResource& ftr) const
 {
     moreorg::ModelPool modelPool;
-    Gecode::Matrix<Gecode::IntVarArray> roleDistribution(mRoleUsage, /*width --> col*/ mRoles.size(), /*height --> row*/ mResourceRequirements.size());
+    Gecode::Matrix<Gecode::IntVarArray> roleDistribution(mRoleUsage, /*width --> col*/ mRoles->size(), /*height --> row*/ mResourceRequirements->size());
 
-    size_t ftrIdx = FluentTimeResource::getIndex(mResourceRequirements, ftr);
+    size_t ftrIdx = FluentTimeResource::getIndex(*mResourceRequirements, ftr);
 
-    for(size_t r = 0; r < mRoles.size(); ++r)
+    for(size_t r = 0; r < mRoles->size(); ++r)
     {
         Gecode::IntVar var = roleDistribution(r,ftrIdx);
         if(var.assigned() && var.val() == 1)
         {
-            modelPool[ mRoles[r].getModel() ] += 1;
+            modelPool[ (*mRoles)[r].getModel() ] += 1;
         }
     }
     return modelPool;
@@ -1416,31 +1722,52 @@ void TransportNetwork::postTemporalConstraints()
     TemporalConstraintNetworkBase::sort(*mpQualitativeTemporalConstraintNetwork, mTimepoints);
 
     mResourceRequirements = Mission::getResourceRequirements(mpMission);
-    if(mResourceRequirements.empty())
+    if(mResourceRequirements->empty())
     {
         throw std::invalid_argument("templ::solvers::csp::TransportNetwork: no resource requirements given");
     }
+    if(mpContext->hasMergedTimepoints())
+    {
+        // Requirements refer to the mission's timepoints, so map them to the
+        // timepoints representing the layers of the network
+        for(FluentTimeResource& ftr : mResourceRequirements.modify())
+        {
+            temporal::Interval interval = ftr.getInterval();
+            temporal::point_algebra::TimePoint::Ptr from = mpContext->getLayerTimepoint(interval.getFrom());
+            temporal::point_algebra::TimePoint::Ptr to = mpContext->getLayerTimepoint(interval.getTo());
+            if(!from || !to)
+            {
+                throw std::runtime_error("templ::solvers::csp::TransportNetwork::postTemporalConstraints: requirement refers to dropped timepoint");
+            }
+            if(from != interval.getFrom() || to != interval.getTo())
+            {
+                interval.setFrom(from);
+                interval.setTo(to);
+                ftr.setInterval(interval);
+            }
+        }
+    }
     breakpointStart()
         << "Requirements:" << std::endl
-        << FluentTimeResource::toString(mResourceRequirements, 4)
+        << FluentTimeResource::toString(*mResourceRequirements, 4)
         << "Timepoints: " << mTimepoints << std::endl
         << mQualitativeTimepoints << std::endl;
     breakpointEnd();
 
     // update timepoint comparator for intervals
-    FluentTimeResource::updateIndices(mResourceRequirements,
+    FluentTimeResource::updateIndices(mResourceRequirements.modify(),
             mpContext->locations());
 
     mModelUsage = Gecode::IntVarArray(*this,
             /*# of models*/ mpMission->getAvailableResources().size()*
-            /*# of fluent time services*/mResourceRequirements.size(), 0,
+            /*# of fluent time services*/mResourceRequirements->size(), 0,
             mpMission->getAvailableResources().getMaxResourceCount());
 
     mRoleUsage = Gecode::IntVarArray(*this,
-            /*width --> col */ mpMission->getRoles().size()* /*height --> row*/ mResourceRequirements.size(),
+            /*width --> col */ mpMission->getRoles().size()* /*height --> row*/ mResourceRequirements->size(),
             0, 1);// Domain 0,1 to represent activation
 
-    Gecode::Matrix<Gecode::IntVarArray> resourceDistribution(mModelUsage, /*width --> col*/ mpMission->getAvailableResources().size(), /*height --> row*/ mResourceRequirements.size());
+    Gecode::Matrix<Gecode::IntVarArray> resourceDistribution(mModelUsage, /*width --> col*/ mpMission->getAvailableResources().size(), /*height --> row*/ mResourceRequirements->size());
 
     // Limit roles to resource availability
     initializeRoleDistributionConstraints();
@@ -1463,14 +1790,16 @@ void TransportNetwork::postTemporalConstraints()
     // Allow only composite agents, i.e. combinations of models, that provide a particular functionality
     Gecode::branch(*this, &TransportNetwork::doPostExtensionalConstraints);
 
+    const Portfolio::AssetConfiguration& assetConfiguration =
+        mpPortfolio->getAssetConfiguration(mAssetIdx);
+
     Gecode::IntAFC modelUsageAfc(*this, mModelUsage, 0.99);
-    double modelAfcDecay = mpContext->configuration().getValueAs<double>("TransportNetwork/search/options/model-usage/afc-decay",0.95);
-    modelUsageAfc.decay(*this, modelAfcDecay);
+    modelUsageAfc.decay(*this, assetConfiguration.modelUsageAfcDecay);
     branch(*this, mModelUsage, Gecode::INT_VAR_AFC_MIN(modelUsageAfc), Gecode::INT_VAL_SPLIT_MIN());
     //Gecode::Gist::stopBranch(*this);
 
     Gecode::Rnd modelUsageRnd;
-    modelUsageRnd.hw();
+    mpPortfolio->initializeRnd(mAssetIdx, modelUsageRnd);
     branch(*this, mModelUsage, Gecode::INT_VAR_AFC_MIN(modelUsageAfc), Gecode::INT_VAL_RND(modelUsageRnd));
 
     branch(*this, mModelUsage, Gecode::tiebreak(Gecode::INT_VAR_DEGREE_MAX(),
@@ -1490,12 +1819,11 @@ void TransportNetwork::postTemporalConstraints()
     //branch(*this, mRoleUsage, Gecode::INT_VAR_MIN_MIN(), Gecode::INT_VAL_MIN(), symmetries);
 
     Gecode::IntAFC roleUsageAfc(*this, mRoleUsage, 0.99);
-    double roleAfcDecay = mpContext->configuration().getValueAs<double>("TransportNetwork/search/options/role-usage/afc-decay",0.95);
-    roleUsageAfc.decay(*this, roleAfcDecay);
+    roleUsageAfc.decay(*this, assetConfiguration.roleUsageAfcDecay);
     //branch(*this, mRoleUsage, Gecode::INT_VAR_AFC_MIN(roleUsageAfc), Gecode::INT_VAL_SPLIT_MIN());
 
     Gecode::Rnd rnd;
-    rnd.hw();
+    mpPortfolio->initializeRnd(mAssetIdx, rnd);
     branch(*this, mRoleUsage, Gecode::INT_VAR_AFC_MIN(roleUsageAfc), Gecode::INT_VAL_RND(rnd), symmetries);
     branch(*this, mRoleUsage, Gecode::INT_VAR_RND(rnd), Gecode::INT_VAL_RND(rnd), symmetries);
     branch(*this, mRoleUsage, Gecode::tiebreak(Gecode::INT_VAR_DEGREE_MAX(),
@@ -1549,7 +1877,7 @@ void TransportNetwork::postRoleAssignments()
         << modelUsageToString() << std::endl
         << roleUsageToString();
 
-    Gecode::Matrix<Gecode::IntVarArray> roleDistribution(mRoleUsage, /*width --> col*/ mRoles.size(), /*height --> row*/ mResourceRequirements.size());
+    Gecode::Matrix<Gecode::IntVarArray> roleDistribution(mRoleUsage, /*width --> col*/ mRoles->size(), /*height --> row*/ mResourceRequirements->size());
 
     //#############################################
     // construct timelines
@@ -1577,15 +1905,94 @@ void TransportNetwork::postRoleAssignments()
     }
 
     assert(mTimelines.empty());
+    assert(mSuccessorTimelines.empty());
+
+    std::string timelineEncoding = mpContext->configuration().getValueAs<std::string>("TransportNetwork/search/options/timeline-encoding","adjacency-list");
+    bool useSuccessorTimelines = false;
+    if(timelineEncoding == "successor")
+    {
+        useSuccessorTimelines = true;
+    } else if(timelineEncoding != "adjacency-list")
+    {
+        throw std::invalid_argument("templ::solvers::csp::TransportNetwork::postRoleAssignments: unknown timeline encoding '"
+                + timelineEncoding + "' -- use 'adjacency-list' or 'successor'");
+    }
 
     Role::List activeRoles;
+    // Successor encoding only: required locations per active role
+    std::vector< std::vector<int> > requiredSequences;
     std::vector<uint32_t>::const_iterator rit = mActiveRoles.begin();
     for(; rit != mActiveRoles.end(); ++rit)
     {
         uint32_t roleIndex = *rit;
-        const Role& role = mRoles[roleIndex];
+        const Role& role = (*mRoles)[roleIndex];
         activeRoles.push_back(role);
 
+        if(useSuccessorTimelines)
+        {
+            // A timeline is represented by the location of the role at each
+            // timepoint, or the value numberOfFluents if the role is inactive,
+            // i.e. not part of the space time network at this timepoint
+            int inactive = static_cast<int>(numberOfFluents);
+            LocationSequence timeline(*this, numberOfTimepoints, 0, inactive);
+            mSuccessorTimelines.push_back(timeline);
+
+            // Locations required by the role's requirements
+            std::vector<int> required(numberOfTimepoints, inactive);
+            for(uint32_t requirementIndex = 0; requirementIndex < mResourceRequirements->size(); ++requirementIndex)
+            {
+                Gecode::IntVar roleRequirement = roleDistribution(roleIndex, requirementIndex);
+                if(!roleRequirement.assigned())
+                {
+                    throw std::runtime_error("TransportNetwork: roleRequirement is not assigned");
+                }
+                if(roleRequirement.val() == 1)
+                {
+                    // The role has to stay at the requirement's location
+                    // for the whole interval
+                    const FluentTimeResource& fts = (*mResourceRequirements)[requirementIndex];
+                    uint32_t fromIndex = getTimepointIndex( fts.getInterval().getFrom() );
+                    uint32_t toIndex = getTimepointIndex( fts.getInterval().getTo() );
+                    for(uint32_t timeIndex = fromIndex; timeIndex <= toIndex; ++timeIndex)
+                    {
+                        rel(*this, timeline[timeIndex], Gecode::IRT_EQ, static_cast<int>(fts.getFluentIdx()));
+                        required[timeIndex] = static_cast<int>(fts.getFluentIdx());
+                    }
+                }
+            }
+            requiredSequences.push_back(required);
+
+            using namespace moreorg::facades;
+            Robot robot = Robot::getInstance(role.getModel(), mpContext->ask());
+            if(robot.isMobile())
+            {
+                // A mobile role enters the network once and leaves it once,
+                // and can move to any location from one timepoint to the next
+                // (unless restricted by reachability)
+                Gecode::IntArgs locations;
+                for(int l = 0; l < inactive; ++l)
+                {
+                    locations << l;
+                }
+                Gecode::REG inactiveExpr(inactive);
+                Gecode::REG locationExpr(locations);
+                Gecode::DFA activity(*inactiveExpr + (+locationExpr) + *inactiveExpr);
+                Gecode::extensional(*this, timeline, activity);
+            } else {
+                // Immobile roles are transported, so that the min cost flow
+                // decides their transitions: they are only part of the
+                // network where they are required, which assigns the sequence
+                for(size_t t = 0; t < numberOfTimepoints; ++t)
+                {
+                    if(required[t] == inactive)
+                    {
+                        rel(*this, timeline[t], Gecode::IRT_EQ, inactive);
+                    }
+                }
+            }
+            continue;
+        }
+
         // A timeline describes the transitions in space time for a given role
         // A timeline is represented by an adjacency list, pointing from the current node
         // to the next -- given some temporal constraints
@@ -1634,7 +2041,7 @@ void TransportNetwork::postRoleAssignments()
 
         // Link the edge activation to the role requirement, i.e. make sure that
         // for each requirement the interval is 'activated'
-        for(uint32_t requirementIndex = 0; requirementIndex < mResourceRequirements.size(); ++requirementIndex)
+        for(uint32_t requirementIndex = 0; requirementIndex < mResourceRequirements->size(); ++requirementIndex)
         {
             // Check if the current role (identified by roleIndex) is required to fulfil the
             // requirement
@@ -1648,7 +2055,7 @@ void TransportNetwork::postRoleAssignments()
             // then the assigned value is one
             if(var.val() == 1)
             {
-                const FluentTimeResource& fts = mResourceRequirements[requirementIndex];
+                const FluentTimeResource& fts = (*mResourceRequirements)[requirementIndex];
                 // index of the location is: fts.fluent
                 point_algebra::TimePoint::Ptr from = fts.getInterval().getFrom();
                 point_algebra::TimePoint::Ptr to = fts.getInterval().getTo();
@@ -1755,7 +2162,7 @@ void TransportNetwork::postRoleAssignments()
     } // for loop active roles
 
     mActiveRoleList = activeRoles;
-    if(mActiveRoleList.empty())
+    if(mActiveRoleList->empty())
     {
         throw
             std::runtime_error("templ::solvers::csp::TransportNetwork::getTimelines: "
@@ -1776,12 +2183,14 @@ void TransportNetwork::postRoleAssignments()
     //
     // Compute a network with proper activation
     //branch(*this, &TransportNetwork::postRoleTimelines);
+    bool supplyDemandBranching = mpContext->configuration().getValueAs<bool>("TransportNetwork/search/options/timeline-brancher/supply-demand",false);
+    bool transportCapacityPropagation = mpContext->configuration().getValueAs<bool>("TransportNetwork/search/options/transport-capacity-propagation",false);
     std::vector<int32_t> supplyDemand;
-    if( mpContext->configuration().getValueAs<bool>("TransportNetwork/search/options/timeline-brancher/supply-demand",false) )
+    if(supplyDemandBranching || transportCapacityPropagation)
     {
         for(uint32_t roleIdx = 0; roleIdx < mActiveRoles.size(); ++roleIdx)
         {
-            const Role& role = mRoles[ mActiveRoles[roleIdx] ];
+            const Role& role = (*mRoles)[ mActiveRoles[roleIdx] ];
             using namespace moreorg::facades;
             Robot robot = Robot::getInstance(role.getModel(), mpContext->ask());
             if(robot.isMobile())
@@ -1798,17 +2207,56 @@ void TransportNetwork::postRoleAssignments()
                 supplyDemand.push_back(-transportDemand);
             }
         }
-        mSupplyDemand = supplyDemand;
         assert(!supplyDemand.empty());
     }
+    if(supplyDemandBranching)
+    {
+        mSupplyDemand = supplyDemand;
+    }
 
     Gecode::Rnd rnd;
-    rnd.hw();
-    double timelineAfcDecay = mpContext->configuration().getValueAs<double>("TransportNetwork/search/options/timeline-brancher/afc-decay");
+    mpPortfolio->initializeRnd(mAssetIdx, rnd);
+    double timelineAfcDecay = mpPortfolio->getAssetConfiguration(mAssetIdx).timelineAfcDecay;
     size_t numberOfLocations = mpContext->locations().size();
+    if(transportCapacityPropagation && !useSuccessorTimelines)
+    {
+        // The transport capacity propagator can only prune the timelines of
+        // the mobile roles for a known transport demand, so branch the
+        // immobile timelines first (in temporal order, preferring to exclude
+        // transitions) instead of leaving them to the min cost flow
+        for(size_t i = 0; i < mActiveRoles.size(); ++i)
+        {
+            const Role& role = (*mActiveRoleList)[i];
+            using namespace moreorg::facades;
+            Robot robot = Robot::getInstance(role.getModel(), mpContext->ask());
+            if(!robot.isMobile())
+            {
+                branch(*this, mTimelines[i], Gecode::SET_VAR_NONE(), Gecode::SET_VAL_MIN_EXC());
+            }
+        }
+    }
     for(size_t i = 0; i < mActiveRoles.size(); ++i)
     {
-        const Role& role = mActiveRoleList[i];
+        const Role& role = (*mActiveRoleList)[i];
+
+        if(useSuccessorTimelines)
+        {
+            // Only branch on the mobile systems, since the sequences of
+            // immobile systems are already assigned
+            using namespace moreorg::facades;
+            Robot robot = Robot::getInstance(role.getModel(), mpContext->ask());
+            if(robot.isMobile())
+            {
+                Gecode::IntAFC timelineUsageAfc(*this, mSuccessorTimelines[i], timelineAfcDecay);
+                branch(*this, mSuccessorTimelines[i],Gecode::INT_VAR_AFC_MIN(timelineAfcDecay), Gecode::INT_VAL_RND(rnd));
+                branch(*this, mSuccessorTimelines[i],Gecode::INT_VAR_RND(rnd),Gecode::INT_VAL_RND(rnd));
+                branch(*this, mSuccessorTimelines[i], Gecode::tiebreak(
+                            Gecode::INT_VAR_DEGREE_MAX(),
+                            Gecode::INT_VAR_SIZE_MIN()),
+                        Gecode::INT_VAL_RND(rnd));
+            }
+            continue;
+        }
 
         propagators::isPath(*this, mTimelines[i], role.toString(),
                 numberOfTimepoints, numberOfLocations);
@@ -1830,14 +2278,50 @@ void TransportNetwork::postRoleAssignments()
 
     // Record the minimal required timeline for this role, before branching
     // expansion of the timeline takes place
-    mMinRequiredTimelines = getTimelines();
+    if(useSuccessorTimelines)
+    {
+        std::map<Role, csp::RoleTimeline> minRequiredTimelines;
+        for(size_t i = 0; i < requiredSequences.size(); ++i)
+        {
+            const Role& role = (*mActiveRoleList)[i];
+            csp::RoleTimeline roleTimeline(role, mpContext->ask());
+            roleTimeline.setTimeline(TypeConversion::toTimeline(requiredSequences[i],
+                        mpContext->locations(),
+                        mTimepoints));
+            roleTimeline.setDistanceMatrix(mpMission->getDistanceMatrix());
+            minRequiredTimelines[role] = roleTimeline;
+        }
+        mMinRequiredTimelines = minRequiredTimelines;
+    } else {
+        mMinRequiredTimelines = getTimelines();
+    }
 
     // BEGIN LOCATION ACCESS
-    applyAccessConstraints(mTimelines,
-            numberOfTimepoints,
+    applyAccessConstraints(numberOfTimepoints,
             numberOfLocations,
-            mActiveRoleList);
+            *mActiveRoleList);
     // END LOCATION ACCESS
+
+    if(mpContext->configuration().getValueAs<bool>("TransportNetwork/search/options/reachability-pruning",false))
+    {
+        applyReachabilityConstraints(numberOfTimepoints,
+                numberOfLocations,
+                *mActiveRoleList);
+    }
+
+    if(transportCapacityPropagation)
+    {
+        if(useSuccessorTimelines)
+        {
+            LOG_WARN_S << "Transport capacity propagation requires the adjacency-list timeline encoding -- not posted";
+        } else {
+            // Detect transitions of immobile roles which cannot be covered
+            // by the transport capacity of the mobile roles, while the
+            // timelines are branched and not only by the min cost flow
+            propagators::multiCommodityFlow(*this, supplyDemand, mTimelines,
+                    numberOfTimepoints, numberOfLocations);
+        }
+    }
     // Only the check whether a feasible approach is to use a heuristic
     // to draw system by supply demand
     //branchTimelines(*this, mTimelines, mSupplyDemand);
@@ -1853,11 +2337,16 @@ void TransportNetwork::doPostMinCostFlow(Gecode::Space& home)
 
 void TransportNetwork::postMinCostFlow()
 {
-    save();
+    bool writeArtifacts = mpMission->getLogger()->sampleIntermediateArtifacts();
+    if(writeArtifacts)
+    {
+        save();
+    }
+    mpPortfolio->incrementFlowEvaluations(mAssetIdx);
 
     try {
         breakpointStart()
-            << "Remaining flaws computation: " << mMinCostFlowFlaws.size() << std::endl
+            << "Remaining flaws computation: " << mMinCostFlowFlaws->size() << std::endl
             << "     cost: " << mCost << std::endl
             << "     flaws: " << mNumberOfFlaws << std::endl;
         breakpointEnd();
@@ -1883,41 +2372,71 @@ void TransportNetwork::postMinCostFlow()
 
 
         LOG_INFO_S << "Min required: " <<
-            RoleTimeline::toString(mMinRequiredTimelines,4,false);
+            RoleTimeline::toString(*mMinRequiredTimelines,4,false);
         LOG_INFO_S << "Expanded: " <<
             RoleTimeline::toString(expandedTimelines,4,false);
 
-        std::pair< std::map<Role, csp::RoleTimeline>, std::map<Role, csp::RoleTimeline> >
-            key(expandedTimelines, mMinRequiredTimelines);
-
-        transshipment::MinCostFlow minCostFlow(expandedTimelines,
-                mMinRequiredTimelines,
-                mpContext->locations(),
-                mTimepoints,
-                mpContext->ask(),
-                mpMission->getLogger(),
-                solverType,
-                feasibilityTimeoutInMs);
+        bool cacheSolution = mpContext->configuration().getValueAs<bool>("TransportNetwork/search/options/lp/cache-solution",
+                        false);
+        FlowSolutionCache::Key key;
+        FlowSolutionCache::ValuePtr cachedSolution;
+        if(cacheSolution)
+        {
+            key = mpContext->flowSolutionCache().computeKey(expandedTimelines, *mMinRequiredTimelines);
+            cachedSolution = mpContext->flowSolutionCache().get(key);
+        }
 
         breakpointStart()
             << "Min cost flow to start" << std::endl;
         breakpointEnd();
 
-        FlowSolutions::iterator it = msMinCostFlowSolutions.find(key);
-        if(it == msMinCostFlowSolutions.end())
+        if(!cachedSolution)
         {
+            transshipment::MinCostFlow minCostFlow(expandedTimelines,
+                    *mMinRequiredTimelines,
+                    mpContext->locations(),
+                    mTimepoints,
+                    mpContext->ask(),
+                    mpMission->getLogger(),
+                    solverType,
+                    feasibilityTimeoutInMs);
+
+            transshipment::IncrementalFlowGraph::Ptr incrementalFlowGraph;
+            if(mpContext->configuration().getValueAs<bool>("TransportNetwork/search/options/lp/incremental", false))
+            {
+                incrementalFlowGraph = mpContext->acquireIncrementalFlowGraph();
+                minCostFlow.setIncrementalFlowGraph(incrementalFlowGraph);
+            }
+            minCostFlow.setWriteArtifacts(writeArtifacts);
+
             std::vector<transshipment::Flaw> flaws = minCostFlow.run();
+            if(incrementalFlowGraph)
+            {
+                // The flows have been transferred to the space time network,
+                // so that the graph can be used by other runs
+                minCostFlow.setIncrementalFlowGraph(transshipment::IncrementalFlowGraph::Ptr());
+                mpContext->releaseIncrementalFlowGraph(incrementalFlowGraph);
+            }
 
             breakpointStart()
                 << "Min cost flow to start" << std::endl;
             breakpointEnd();
 
-            transshipment::FlowNetwork flowNetwork = minCostFlow.getFlowNetwork();
-            mMinCostFlowSolution = flowNetwork.getSpaceTimeNetwork();
+            const transshipment::FlowNetwork& flowNetwork = minCostFlow.getFlowNetwork();
+            SpaceTime::Network solutionNetwork = flowNetwork.getSpaceTimeNetwork();
+            // Allow to query the solution by the mission's timepoints
+            for(const std::pair<const temporal::point_algebra::TimePoint::Ptr, temporal::point_algebra::TimePoint::Ptr>& p : mpContext->getMergedTimepoints())
+            {
+                if(p.second)
+                {
+                    solutionNetwork.addTimepointAlias(p.first, p.second);
+                }
+            }
+            mMinCostFlowSolution = solutionNetwork;
 
             if(flaws.empty())
             {
-                if(propagateImmobileAgentConstraints(mMinCostFlowSolution) ==
+                if(propagateImmobileAgentConstraints(*mMinCostFlowSolution) ==
                         Gecode::ES_FAILED)
                 {
                     LOG_WARN_S << "Immobile agent constraints not maintained by"
@@ -1926,43 +2445,59 @@ void TransportNetwork::postMinCostFlow()
                 }
             }
 
-            flowNetwork.save();
+            if(writeArtifacts)
+            {
+                std::string filename = mpMission->getLogger()->filename("transhipment-flow-network.gexf");
+                // The solution network shares its tuples with this graph and
+                // is modified by the analysis (e.g. role safety attributes),
+                // so write a snapshot
+                graph_analysis::BaseGraph::Ptr graph = flowNetwork.getSpaceTimeNetwork().getGraph()->clone();
+                mpMission->getLogger()->getArtifactWriter()->enqueue([graph, filename]()
+                    {
+                        try {
+                            graph_analysis::io::GraphIO::write(filename, graph, graph_analysis::representation::GEXF);
+                        } catch(const std::exception& e)
+                        {
+                            LOG_WARN_S << "Saving file " << filename << " failed: -- " << e.what();
+                        }
+                    });
+            }
 
             // store all flaws
             mMinCostFlowFlaws = flaws;
 
-            if(mpContext->configuration().getValueAs<bool>("TransportNetwork/search/options/lp/cache-solution",
-                        false))
+            if(cacheSolution)
             {
-                msMinCostFlowSolutions[key] = FlowSolutionValue(flaws, mMinCostFlowSolution);
+                mpContext->flowSolutionCache().put(key,
+                        make_shared<FlowSolutionCache::Value>(flaws, *mMinCostFlowSolution));
             }
         } else {
             breakpointStart()
                 << "Found existing solution .. (skipping recomputation and taking from cache)" << std::endl;
             breakpointEnd();
 
-            mMinCostFlowFlaws = it->second.first;
-            mMinCostFlowSolution = it->second.second;
+            mMinCostFlowFlaws = cachedSolution->first;
+            mMinCostFlowSolution = cachedSolution->second;
         }
         // compute all feasible resolution that might allow
         // to improve the solution
-        mFlawResolution.prepare(mMinCostFlowFlaws);
+        mFlawResolution.prepare(*mMinCostFlowFlaws);
 
-        std::cout << "Session " << mpMission->getLogger()->getSessionId() << ": remaining flaws: " << mMinCostFlowFlaws.size() << std::endl;
+        std::cout << "Session " << mpMission->getLogger()->getSessionId() << ": remaining flaws: " << mMinCostFlowFlaws->size() << std::endl;
         breakpointStart()
-            << "Remaining flaws: " << mMinCostFlowFlaws.size() << std::endl;
+            << "Remaining flaws: " << mMinCostFlowFlaws->size() << std::endl;
         breakpointEnd();
 
         // Set flaws as current cost of this solution
-        rel(*this, mCost, Gecode::IRT_EQ, mMinCostFlowFlaws.size());
-        rel(*this, mNumberOfFlaws, Gecode::IRT_EQ, mMinCostFlowFlaws.size());
+        rel(*this, mCost, Gecode::IRT_EQ, mMinCostFlowFlaws->size());
+        rel(*this, mNumberOfFlaws, Gecode::IRT_EQ, mMinCostFlowFlaws->size());
 
-        mSolutionAnalysis = solvers::SolutionAnalysis(mpMission, mMinCostFlowSolution, mpContext->configuration());
-        mSolutionAnalysis.analyse();
+        mSolutionAnalysis = solvers::SolutionAnalysis(mpMission, *mMinCostFlowSolution, mpContext->configuration());
+        mSolutionAnalysis.modify().analyse();
 
         // Set flaws as well
         bool allowFlaws = mpContext->configuration().getValueAs<bool>("TransportNetwork/search/options/allow-flaws", true);
-        if(!mMinCostFlowFlaws.empty() && !allowFlaws)
+        if(!mMinCostFlowFlaws->empty() && !allowFlaws)
         {
             this->fail();
             return;
@@ -2001,29 +2536,29 @@ std::string TransportNetwork::toString() const
     ss << "TransportNetwork: #" << std::endl;
     ss << "    Timepoints: " << mQualitativeTimepoints << std::endl;
     Gecode::Matrix<Gecode::IntVarArray> resourceDistribution(mModelUsage,
-            modelPoolSize, mResourceRequirements.size());
+            modelPoolSize, mResourceRequirements->size());
     for(size_t m = 0; m < modelPoolSize; ++m)
     {
         const IRI& model = getResourceModelFromIndex(m);
         ss << std::setw(30) << std::left << model.getFragment() << ": ";
-        for(size_t i = 0; i < mResourceRequirements.size(); ++i)
+        for(size_t i = 0; i < mResourceRequirements->size(); ++i)
         {
             ss << std::setw(10) << std::left << resourceDistribution(m,i);
         }
         ss << std::endl;
     }
 
-    Gecode::Matrix<Gecode::IntVarArray> rolesDistribution(mRoleUsage, mRoles.size(), mResourceRequirements.size());
+    Gecode::Matrix<Gecode::IntVarArray> rolesDistribution(mRoleUsage, mRoles->size(), mResourceRequirements->size());
     size_t width = 30;
-    for(size_t m = 0; m < mRoles.size(); ++m)
+    for(size_t m = 0; m < mRoles->size(); ++m)
     {
-        width = std::min(mRoles[m].toString().size() + 5, width);
+        width = std::min((*mRoles)[m].toString().size() + 5, width);
     }
 
-    for(size_t m = 0; m < mRoles.size(); ++m)
+    for(size_t m = 0; m < mRoles->size(); ++m)
     {
-        ss << std::setw(width) << mRoles[m].toString() << ": ";
-        for(size_t i = 0; i < mResourceRequirements.size(); ++i)
+        ss << std::setw(width) << (*mRoles)[m].toString() << ": ";
+        for(size_t i = 0; i < mResourceRequirements->size(); ++i)
         {
             ss << std::setw(10) << std::left << rolesDistribution(m,i);
         }
@@ -2032,9 +2567,14 @@ std::string TransportNetwork::toString() const
     try {
         for(size_t i = 0; i < mTimelines.size(); ++i)
         {
-            ss << mActiveRoleList[i].toString() << std::endl;
+            ss << (*mActiveRoleList)[i].toString() << std::endl;
             ss << Formatter::toString(mTimelines[i], mpContext->locations(), mTimepoints) << std::endl;
         }
+        for(size_t i = 0; i < mSuccessorTimelines.size(); ++i)
+        {
+            ss << (*mActiveRoleList)[i].toString() << std::endl;
+            ss << mSuccessorTimelines[i] << std::endl;
+        }
 
     } catch(const std::exception& e)
     {
@@ -2057,9 +2597,9 @@ std::string TransportNetwork::modelUsageToString() const
     std::stringstream ss;
     ss << "Model usage:" << std::endl;
     ss << std::setw(firstcolumnwidth) << std::right << "    FluentTimeResource: ";
-    for(size_t r = 0; r < mResourceRequirements.size(); ++r)
+    for(size_t r = 0; r < mResourceRequirements->size(); ++r)
     {
-        const FluentTimeResource& fts = mResourceRequirements[r];
+        const FluentTimeResource& fts = (*mResourceRequirements)[r];
         /// construct string for proper alignment
         std::string s = fts.getFluent()->getInstanceName();
         s += "@[" + fts.getInterval().toString(0,true) + "]";
@@ -2076,7 +2616,7 @@ std::string TransportNetwork::modelUsageToString() const
     {
         const IRI& model = cit->first;
         ss << std::setw(firstcolumnwidth) << std::left << model.getFragment() << ": ";
-        for(size_t r = 0; r < mResourceRequirements.size(); ++r)
+        for(size_t r = 0; r < mResourceRequirements->size(); ++r)
         {
             ss << std::setw(columnwidth) << mModelUsage[r*modelPool.size() + modelIndex] << " ";
         }
@@ -2087,7 +2627,7 @@ std::string TransportNetwork::modelUsageToString() const
 
 std::string TransportNetwork::roleUsageToString() const
 {
-    return Formatter::toString(mRoleUsage, mRoles, mResourceRequirements);
+    return Formatter::toString(mRoleUsage, *mRoles, *mResourceRequirements);
 }
 
 std::string TransportNetwork::toString(const std::vector<Gecode::IntVarArray>& timelines) const
@@ -2096,7 +2636,7 @@ std::string TransportNetwork::toString(const std::vector<Gecode::IntVarArray>& t
     std::vector<std::string> labels;
     for(size_t i = 0; i < timelines.size(); ++i)
     {
-        labels.push_back( mRoles[ activeRoles[i] ] .toString());
+        labels.push_back( (*mRoles)[ activeRoles[i] ] .toString());
     }
     return Formatter::toString(timelines,
             toPtrList<Symbol,symbols::constants::Location>(mpContext->locations()),
@@ -2109,7 +2649,7 @@ uint32_t TransportNetwork::getTimepointIndex(const temporal::point_algebra::Time
     using namespace templ::solvers::temporal;
 
     std::vector<point_algebra::TimePoint::Ptr>::const_iterator timepointIt =
-        std::find(mTimepoints.begin(), mTimepoints.end(), timePoint);
+        std::find(mTimepoints.begin(), mTimepoints.end(), mpContext->getLayerTimepoint(timePoint));
     if(timepointIt != mTimepoints.end())
     {
         return timepointIt - mTimepoints.begin();
@@ -2145,10 +2685,7 @@ void TransportNetwork::save(const std::string& _filename) const
         base::Time timestamp = base::Time::now();
         filename = mpMission->getLogger()->filename(timestamp.toString(base::Time::Seconds) + "-transport-network.status");
     }
-    std::ofstream file;
-    file.open(filename );
-    file << toString();
-    file.close();
+    mpMission->getLogger()->getArtifactWriter()->write(filename, toString());
 }
 
 Gecode::ExecStatus TransportNetwork::propagateImmobileAgentConstraints(const SpaceTime::Network& network)
@@ -2168,9 +2705,9 @@ Gecode::ExecStatus TransportNetwork::propagateImmobileAgentConstraints(const Spa
 
     Role::List activeImmobileRoles;
     std::vector<size_t> activeImmobileRolesIdx;
-    for(size_t idx = 0; idx < mActiveRoleList.size(); ++idx)
+    for(size_t idx = 0; idx < mActiveRoleList->size(); ++idx)
     {
-        const Role& role = mActiveRoleList[idx];
+        const Role& role = (*mActiveRoleList)[idx];
         using namespace moreorg::facades;
         Robot robot = Robot::getInstance(role.getModel(), mpContext->ask());
         if(!robot.isMobile())
@@ -2220,6 +2757,22 @@ Gecode::ExecStatus TransportNetwork::updateTimeline(size_t timelineIdx,
         size_t numberOfLocations,
         size_t numberOfTimepoints)
 {
+    if(!mSuccessorTimelines.empty())
+    {
+        if(timepointIdx < numberOfTimepoints)
+        {
+            Gecode::Int::IntView view(mSuccessorTimelines[timelineIdx][timepointIdx]);
+            // The sequences of immobile roles are assigned upfront, where
+            // inactive refers to the role being transported
+            if(view.assigned() && view.val() == static_cast<int>(numberOfLocations))
+            {
+                return Gecode::ES_OK;
+            }
+            GECODE_ME_CHECK(view.eq(*this, static_cast<int>(locationIdx)));
+        }
+        return Gecode::ES_OK;
+    }
+
     if(timepointIdx == 0 || timelineIdx >= numberOfTimepoints)
     {
         return Gecode::ES_OK;
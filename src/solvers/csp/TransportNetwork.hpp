@@ -6,6 +6,7 @@
 #include <vector>
 #include <gecode/set.hh>
 #include <gecode/search.hh>
+#include <gecode/minimodel.hh>
 
 #include <moreorg/OrganizationModelAsk.hpp>
 #include <qxcfg/Configuration.hpp>
@@ -19,7 +20,10 @@
 #include "Types.hpp"
 #include "utils/FluentTimeIndex.hpp"
 #include "Context.hpp"
+#include "FlowSolutionCache.hpp"
+#include "Portfolio.hpp"
 #include "../SolutionAnalysis.hpp"
+#include "../../utils/CopyOnWrite.hpp"
 
 namespace templ {
 namespace solvers {
@@ -63,6 +67,7 @@ public:
     public:
         const ModelDistribution& getModelDistribution() const { return mModelDistribution; }
         const RoleDistribution& getRoleDistribution() const { return mRoleDistribution; }
+        const std::map<Role, csp::RoleTimeline>& getTimelines() const { return mTimelines; }
 
         std::string toString(uint32_t indent = 0) const;
         SpaceTime::Network toNetwork() const;
@@ -87,13 +92,18 @@ protected:
     Mission::Ptr mpMission;
     Context::Ptr mpContext;
 
+    /// Shared state of the portfolio search, i.e. of all assets
+    Portfolio::Ptr mpPortfolio;
+    /// Index of the portfolio asset this space belongs to
+    uint32_t mAssetIdx;
+
     /// Timepoints (will be sorted after postTemporalConstraints has been
     /// called)
     std::vector<solvers::temporal::point_algebra::TimePoint::Ptr> mTimepoints;
 
     /// List of FluentTimeResource which represents the functional
     /// requirements that arise from the mission scenario
-    std::vector<FluentTimeResource> mResourceRequirements;
+    templ::utils::CopyOnWrite< std::vector<FluentTimeResource> > mResourceRequirements;
 
     /// map timeslot to fluenttime service
     std::map<uint32_t, std::vector<FluentTimeResource> > mTimeIndexedRequirements;
@@ -141,10 +151,10 @@ protected:
     // per requirement/role: sum of same type roles <= model bound for fts
     //
     // model-based first stage guarantees conflict free solution on type basis
-    Role::List mRoles;
+    templ::utils::CopyOnWrite<Role::List> mRoles;
 
     std::vector<uint32_t> mActiveRoles;
-    Role::List mActiveRoleList;
+    templ::utils::CopyOnWrite<Role::List> mActiveRoleList;
 
     // ############################
     // Timelines
@@ -155,7 +165,12 @@ protected:
     //
     // Activation if edge is traversed by this item or not
     ListOfAdjacencyLists mTimelines;
-    std::map<Role, csp::RoleTimeline> mMinRequiredTimelines;
+    // Alternative timeline encoding (option timeline-encoding: successor):
+    // per role one variable per timepoint which represents the location of
+    // the role (|Timepoints|), where the path structure is implicit
+    // Only one of mTimelines and mSuccessorTimelines is used
+    ListOfLocationSequences mSuccessorTimelines;
+    templ::utils::CopyOnWrite< std::map<Role, csp::RoleTimeline> > mMinRequiredTimelines;
 
     std::vector<int32_t> mSupplyDemand;
     // Map the transport characteristic: (|Locations|*|Timepoints|)^2
@@ -176,8 +191,8 @@ protected:
 
     // row column access
     //MatrixXi mProviderCapacities;
-    SpaceTime::Network mMinCostFlowSolution;
-    std::vector<transshipment::Flaw> mMinCostFlowFlaws;
+    templ::utils::CopyOnWrite<SpaceTime::Network> mMinCostFlowSolution;
+    templ::utils::CopyOnWrite< std::vector<transshipment::Flaw> > mMinCostFlowFlaws;
     FlawResolution mFlawResolution;
     FlawResolution::ResolutionOptions mRequiredResolutionOptions;
 
@@ -188,15 +203,9 @@ protected:
     // The current master space
     TransportNetwork* mpCurrentMaster;
 
-    typedef std::pair< std::vector<transshipment::Flaw>, SpaceTime::Network> FlowSolutionValue;
-    typedef std::pair< std::map<Role, csp::RoleTimeline>, std::map<Role, csp::RoleTimeline> > FlowSolutionKey;
-    typedef std::map< FlowSolutionKey, FlowSolutionValue > FlowSolutions;
-
-    static FlowSolutions msMinCostFlowSolutions;
-
     /// List of extra constraints
     Constraint::PtrList mConstraints;
-    SolutionAnalysis mSolutionAnalysis;
+    templ::utils::CopyOnWrite<SolutionAnalysis> mSolutionAnalysis;
 
 private:
     std::stringstream mInteractiveMessageStream;
@@ -297,6 +306,12 @@ protected:
      */
     virtual void constrainSlave(const Gecode::Space& n);
 
+    /**
+     * Constrain this instance using the incumbent cost bound which is shared
+     * between all assets of a portfolio (only if hill-climbing is active)
+     */
+    void constrainToIncumbent();
+
 
     ModelDistribution getModelDistribution() const;
     RoleDistribution getRoleDistribution() const;
@@ -351,10 +366,19 @@ protected:
     void applyExtraConstraints();
 
     /**
-     * Apply access constraints
+     * Apply access constraints to the timelines of the given (active) roles
+     */
+    void applyAccessConstraints(size_t numberOfTimepoints,
+            size_t numberOfLocations,
+            const Role::List& roles);
+
+    /**
+     * Remove the transitions of mobile roles, which cannot be travelled
+     * between two consecutive timepoints given the temporal bounds of the
+     * mission
+     * \see Reachability
      */
-    void applyAccessConstraints(ListOfAdjacencyLists& timelines,
-            size_t numberOfTimepoints,
+    void applyReachabilityConstraints(size_t numberOfTimepoints,
             size_t numberOfLocations,
             const Role::List& roles);
 
@@ -365,6 +389,16 @@ protected:
      */
     void enforceUnaryResourceUsage();
 
+    /**
+     * Get the usage of a column of the distribution (model or role) for a
+     * set of concurrent requirements, i.e. one term per location, where
+     * requirements at the same location account for their maximum usage
+     * \param locationGroups Concurrent requirements grouped by location
+     */
+    Gecode::IntVarArgs getConcurrentUsage(Gecode::Matrix<Gecode::IntVarArray>& distribution,
+            size_t column,
+            const std::vector<FluentTimeResource::List>& locationGroups);
+
     Gecode::Symmetries identifySymmetries();
 
     Gecode::IntVar cost(void) const { return mCost; }
@@ -470,7 +504,7 @@ public:
     /**
      * Get the list of active role (as role list)
      */
-    Role::List getActiveRoleList() const { return mActiveRoleList; }
+    Role::List getActiveRoleList() const { return *mActiveRoleList; }
 
     void setCurrentMaster(TransportNetwork* master) { mpCurrentMaster = master; }
 
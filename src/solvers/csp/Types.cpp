@@ -53,7 +53,50 @@ SpaceTime::Timeline TypeConversion::toTimeline(const AdjacencyList& list,
     return timeline;
 }
 
+SpaceTime::Timeline TypeConversion::toTimeline(const LocationSequence& sequence,
+            const std::vector<symbols::constants::Location::Ptr>& locations,
+            const std::vector<solvers::temporal::point_algebra::TimePoint::Ptr>& timepoints)
+{
+    std::vector<int> values;
+    for(int t = 0; t < sequence.size(); ++t)
+    {
+        const Gecode::IntVar& var = sequence[t];
+        if(!var.assigned())
+        {
+            throw std::invalid_argument("templ::solvers::csp::TypeConversion::toTimeline: cannot compute timeline, value is not assigned");
+        }
+        values.push_back(var.val());
+    }
+    return toTimeline(values, locations, timepoints);
+}
 
+SpaceTime::Timeline TypeConversion::toTimeline(const std::vector<int>& sequence,
+            const std::vector<symbols::constants::Location::Ptr>& locations,
+            const std::vector<solvers::temporal::point_algebra::TimePoint::Ptr>& timepoints)
+{
+    if(sequence.size() > timepoints.size())
+    {
+        throw std::invalid_argument("templ::solvers::csp::TypeConversion::toTimeline: sequence is longer than the list of timepoints");
+    }
+
+    SpaceTime::Timeline timeline;
+    for(size_t t = 0; t < sequence.size(); ++t)
+    {
+        int locationIdx = sequence[t];
+        if(locationIdx < 0 || static_cast<size_t>(locationIdx) > locations.size())
+        {
+            throw std::invalid_argument("templ::solvers::csp::TypeConversion::toTimeline: location index "
+                    + std::to_string(locationIdx) + " out of range");
+        }
+        // inactive
+        if(static_cast<size_t>(locationIdx) == locations.size())
+        {
+            continue;
+        }
+        timeline.push_back(SpaceTime::Point(locations[locationIdx], timepoints[t]));
+    }
+    return timeline;
+}
 
 SpaceTime::Timelines TypeConversion::toTimelines(const Role::List& roles, const ListOfAdjacencyLists& lists,
             const std::vector<symbols::constants::Location::Ptr>& locations,
@@ -2,6 +2,7 @@
 #define TEMPL_SOLVERS_CSP_TYPES_HPP
 
 #include <vector>
+#include <gecode/int.hh>
 #include <gecode/set.hh>
 #include "../../SpaceTime.hpp"
 
@@ -17,6 +18,15 @@ typedef Gecode::SetVarArray AdjacencyList;
 /// ListOfAdjecencyLists, e.g., allows to represent a set of timelines in the CSP
 typedef std::vector<AdjacencyList> ListOfAdjacencyLists;
 
+/// A location sequence, i.e., one variable per timepoint whose value is the
+/// index of the location, which allows to represent a timeline in the CSP
+/// using successor variables; the value 'number of locations' marks a
+/// timepoint where the role is inactive, i.e. not part of the timeline
+typedef Gecode::IntVarArray LocationSequence;
+
+/// ListOfLocationSequences, e.g., allows to represent a set of timelines in the CSP
+typedef std::vector<LocationSequence> ListOfLocationSequences;
+
 /**
  * A conversion class from/to the CSP internal types
  */
@@ -35,6 +45,30 @@ public:
             bool doThrow = true
             );
 
+    /**
+     * Convert a location sequence to the SpaceTime timeline representation using
+     * the known locations and timepoints
+     * \throws std::invalid_argument if a variable is not assigned
+     * \return Timeline
+     */
+    static SpaceTime::Timeline toTimeline(const LocationSequence& sequence,
+            const std::vector<symbols::constants::Location::Ptr>& locations,
+            const std::vector<solvers::temporal::point_algebra::TimePoint::Ptr>& timepoints
+            );
+
+    /**
+     * Convert the location indices of a sequence to the SpaceTime timeline
+     * representation using the known locations and timepoints
+     * \param sequence Location index per timepoint, where the number of
+     * locations marks an inactive timepoint
+     * \throws std::invalid_argument if an index is out of range
+     * \return Timeline
+     */
+    static SpaceTime::Timeline toTimeline(const std::vector<int>& sequence,
+            const std::vector<symbols::constants::Location::Ptr>& locations,
+            const std::vector<solvers::temporal::point_algebra::TimePoint::Ptr>& timepoints
+            );
+
     /**
      * Convert a list of adjacency lists corresponding to individual roles
      * to the SpaceTime timeline representation using
@@ -54,13 +54,21 @@ IsPath::IsPath(Gecode::Space& home, ViewArray<Set::SetView>& xv,
 
     : NaryPropagator<Set::SetView, Set::PC_SET_NONE>(home, xv)
     , c(home)
-    , mTag(tag)
+    , mAssignedFluentIndices(home)
+    , mAssignedTimepointIndices(home)
+    , mTag(tag.size())
     , mNumberOfTimepoints(numberOfTimepoints)
     , mNumberOfFluents(numberOfFluents)
     , mMinPathLength(minPathLength)
     , mMaxPathLength(maxPathLength)
-    , mAssignedTimepoints(numberOfTimepoints, std::pair<int, bool>(-1, false) )
+    , mAssignedTimepoints(home.alloc< std::pair<int, bool> >(numberOfTimepoints))
 {
+    for(size_t i = 0; i < tag.size(); ++i)
+    {
+        mTag[i] = tag[i];
+    }
+    std::fill(mAssignedTimepoints, mAssignedTimepoints + mNumberOfTimepoints, std::pair<int, bool>(-1, false));
+
     if(mMaxPathLength < 0)
     {
         mMaxPathLength = mNumberOfTimepoints;
@@ -113,8 +121,8 @@ IsPath::IsPath(Gecode::Space& home, ViewArray<Set::SetView>& xv,
     {
         if(x[i].assigned())
         {
-            mAssignedTimepointIndices.push_back( i/mNumberOfFluents );
-            mAssignedFluentIndices.push_back( i%mNumberOfFluents );
+            mAssignedTimepointIndices.push( i/mNumberOfFluents );
+            mAssignedFluentIndices.push( i%mNumberOfFluents );
             doReschedule = true;
         }
     }
@@ -126,13 +134,16 @@ IsPath::IsPath(Gecode::Space& home, ViewArray<Set::SetView>& xv,
 
 IsPath::IsPath(Gecode::Space& home, IsPath& p)
     : NaryPropagator<Set::SetView, Set::PC_SET_NONE>(home, p)
+    , mAssignedFluentIndices(home)
+    , mAssignedTimepointIndices(home)
     , mTag(p.mTag)
     , mNumberOfTimepoints(p.mNumberOfTimepoints)
     , mNumberOfFluents(p.mNumberOfFluents)
     , mMinPathLength(p.mMinPathLength)
     , mMaxPathLength(p.mMaxPathLength)
-    , mAssignedTimepoints(p.mAssignedTimepoints)
+    , mAssignedTimepoints(home.alloc< std::pair<int, bool> >(p.mNumberOfTimepoints))
 {
+    std::copy(p.mAssignedTimepoints, p.mAssignedTimepoints + mNumberOfTimepoints, mAssignedTimepoints);
     x.update(home, p.x);
     c.update(home, p.c);
 }
@@ -183,11 +194,20 @@ bool IsPath::isValidWaypointSequence(const std::vector< std::pair<int,bool> >& w
         size_t& start,
         size_t& end,
         bool fullyAssigned)
+{
+    return isValidWaypointSequence(waypoints.data(), waypoints.size(), start, end, fullyAssigned);
+}
+
+bool IsPath::isValidWaypointSequence(const std::pair<int,bool>* waypoints,
+        size_t numberOfWaypoints,
+        size_t& start,
+        size_t& end,
+        bool fullyAssigned)
 {
     start = 0;
     end = 0;
 
-    if(waypoints.size() <= 1)
+    if(numberOfWaypoints <= 1)
     {
         return true;
     }
@@ -196,7 +216,7 @@ bool IsPath::isValidWaypointSequence(const std::vector< std::pair<int,bool> >& w
     bool finalized = false;
     size_t validWaypoints = 0;
 
-    for(size_t i = 0; i < waypoints.size(); ++i)
+    for(size_t i = 0; i < numberOfWaypoints; ++i)
     {
         const std::pair<int, bool>& current = waypoints[i];
         // Initialize start when full assignment of a row as indicated by the
@@ -320,6 +340,10 @@ size_t IsPath::dispose(Gecode::Space& home)
 {
     home.ignore(*this, AP_DISPOSE);
     c.dispose(home);
+    home.free< std::pair<int, bool> >(mAssignedTimepoints, mNumberOfTimepoints);
+    mAssignedFluentIndices.~IndexStack();
+    mAssignedTimepointIndices.~IndexStack();
+    mTag.~Tag();
     (void) NaryPropagator<Gecode::Set::SetView, Gecode::Set::PC_SET_NONE>::dispose(home);
     return sizeof(*this);
 }
@@ -349,9 +373,9 @@ Gecode::ExecStatus IsPath::advise(Gecode::Space& home, Gecode::Advisor& a, const
         int idx = advisor.idx();
         if(advisor.isTimepointIdx())
         {
-            mAssignedTimepointIndices.push_back( idx );
+            mAssignedTimepointIndices.push( idx );
         } else {
-            mAssignedFluentIndices.push_back( idx );
+            mAssignedFluentIndices.push( idx );
         }
 
         if(advisor.x.assigned())
@@ -374,10 +398,8 @@ Gecode::ExecStatus IsPath::propagate(Gecode::Space& home, const Gecode::ModEvent
     // process assignments
     while(!mAssignedTimepointIndices.empty())
     {
-        int timepoint = mAssignedTimepointIndices.back();
-        int fluent = mAssignedFluentIndices.back();
-        mAssignedTimepointIndices.pop_back();
-        mAssignedFluentIndices.pop_back();
+        int timepoint = mAssignedTimepointIndices.pop();
+        int fluent = mAssignedFluentIndices.pop();
 
         // Skip timepoint-row that have already been handled
         if( mAssignedTimepoints[timepoint].second)
@@ -434,7 +456,7 @@ Gecode::ExecStatus IsPath::propagate(Gecode::Space& home, const Gecode::ModEvent
     size_t start, end;
     if(x.assigned())
     {
-        if( !isValidWaypointSequence(mAssignedTimepoints, start, end, true) )
+        if( !isValidWaypointSequence(mAssignedTimepoints, mNumberOfTimepoints, start, end, true) )
         {
             return ES_FAILED;
         }
@@ -449,12 +471,23 @@ Gecode::ExecStatus IsPath::propagate(Gecode::Space& home, const Gecode::ModEvent
     }
 }
 
+std::string IsPath::getTag() const
+{
+    std::string tag;
+    for(int i = 0; i < mTag.size(); ++i)
+    {
+        tag += mTag[i];
+    }
+    return tag;
+}
+
 std::string IsPath::waypointsToString() const
 {
     std::stringstream ss;
     ss << "[";
-    for(auto pair : mAssignedTimepoints)
+    for(size_t i = 0; i < mNumberOfTimepoints; ++i)
     {
+        const std::pair<int, bool>& pair = mAssignedTimepoints[i];
         ss << "[" << pair.first << "," << pair.second << "]";
     }
     ss << "]";
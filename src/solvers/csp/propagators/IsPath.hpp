@@ -4,6 +4,7 @@
 #include <gecode/int.hh>
 #include <gecode/int/rel.hh>
 #include <gecode/minimodel.hh>
+#include <gecode/support.hh>
 #include <set>
 #include "Idx.hpp"
 
@@ -21,25 +22,31 @@ namespace propagators {
 class IsPath : public Gecode::NaryPropagator<Gecode::Set::SetView, Gecode::Set::PC_SET_NONE>
 {
 public:
+    typedef Gecode::Support::DynamicStack<int, Gecode::Space> IndexStack;
+    typedef Gecode::SharedArray<char> Tag;
 
     Gecode::Council<Idx> c;
 
     // Queue all changes -- fluent and timepoint subscriptions
     // are parallel, so that we can identify the exact changed
     // entry by ('t','f') using the same index
-    std::vector<int> mAssignedFluentIndices;
-    std::vector<int> mAssignedTimepointIndices;
+    // (allocated in the space, and empty when the propagator is copied)
+    IndexStack mAssignedFluentIndices;
+    IndexStack mAssignedTimepointIndices;
 
 
 protected:
-    std::string mTag;
+    // The tag never changes, so that it is shared between all copies
+    Tag mTag;
     uint32_t mNumberOfTimepoints;
     uint32_t mNumberOfFluents;
 
     uint32_t mMinPathLength;
     uint32_t mMaxPathLength;
 
-    std::vector< std::pair<int, bool> > mAssignedTimepoints;
+    // Assigned waypoint per timepoint (space allocated of size
+    // mNumberOfTimepoints)
+    std::pair<int, bool>* mAssignedTimepoints;
 
 public:
     /**
@@ -72,6 +79,13 @@ public:
 
     static bool isValidWaypointSequence(const std::vector< std::pair<int, bool> >& waypoints, size_t& startTimepoint, size_t& endTimepoint, bool fullyAssigned = false);
 
+    static bool isValidWaypointSequence(const std::pair<int, bool>* waypoints, size_t numberOfWaypoints, size_t& startTimepoint, size_t& endTimepoint, bool fullyAssigned = false);
+
+    /**
+     * Get the tag of this propagator
+     */
+    std::string getTag() const;
+
     /**
      * Cancels that subscription of the view
      * \return the size of the just disposed propagator
@@ -1,4 +1,5 @@
 #include "IsValidTransportEdge.hpp"
+#include <algorithm>
 #include <base-logging/Logging.hpp>
 
 using namespace Gecode;
@@ -14,7 +15,7 @@ IsValidTransportEdge::DemandSupply::DemandSupply(Gecode::Space& home,
         SetVarArrayView x,
         size_t numberOfFluents)
     : Gecode::Advisor(home, p, c)
-    , edgeValue(numberOfFluents, 0)
+    , numberOfFluents(numberOfFluents)
     , x(x)
 {
     x.subscribe(home, *this);
@@ -22,8 +23,7 @@ IsValidTransportEdge::DemandSupply::DemandSupply(Gecode::Space& home,
 
 IsValidTransportEdge::DemandSupply::DemandSupply(Gecode::Space& home, DemandSupply& other)
     : Gecode::Advisor(home, other)
-    , edgeIdxWithDemand(other.edgeIdxWithDemand)
-    , edgeValue(other.edgeValue)
+    , numberOfFluents(other.numberOfFluents)
 {
     x.update(home, other.x);
 }
@@ -37,29 +37,7 @@ void IsValidTransportEdge::DemandSupply::dispose(Gecode::Space& home, Gecode::Co
 std::string IsValidTransportEdge::DemandSupply::toString() const
 {
     std::stringstream ss;
-    ss << "EdgeIdxWithDemand: [";
-    std::set<size_t>::const_iterator cit = edgeIdxWithDemand.begin();
-    for(; cit != edgeIdxWithDemand.end();)
-    {
-        ss << *cit;
-        ++cit;
-
-        if(cit != edgeIdxWithDemand.end())
-        {
-            ss << ", ";
-        }
-    }
-    ss << "]" << std::endl;
-    ss << "EdgeValue: [";
-    for(size_t i = 0; i < edgeValue.size(); ++i)
-    {
-        ss << edgeValue[i];
-        if(i < edgeValue.size() - 1 )
-        {
-           ss << ", ";
-        }
-    }
-    ss << "]" << std::endl;
+    ss << "NumberOfFluents: " << numberOfFluents << std::endl;
     ss << "raw: " << x;
     return ss.str();
 }
@@ -69,7 +47,7 @@ IsValidTransportEdge::IsValidTransportEdge(Gecode::Space& home, SetVarArrayView&
     , c(home)
     , mTimepoint(timepoint)
     , mFluent(fluent)
-    , mSupplyDemand(supplyDemand)
+    , mSupplyDemand(std::vector<int>(supplyDemand.begin(), supplyDemand.end()))
     , mLocalTargetFluent((timepoint+1)*numberOfFluents + fluent)
     , mSpaceTimeOffset((timepoint+1)*numberOfFluents)
 {
@@ -79,7 +57,7 @@ IsValidTransportEdge::IsValidTransportEdge(Gecode::Space& home, SetVarArrayView&
     home.notice(*this, Gecode::AP_DISPOSE);
 
     assert(mLocalTargetFluent != 0);
-    assert(x.size() == static_cast<int>(mSupplyDemand.size()) );
+    assert(x.size() == mSupplyDemand.size());
 
     (void) new (home) DemandSupply(home, *this, c, x, numberOfFluents);
 }
@@ -129,6 +107,7 @@ size_t IsValidTransportEdge::dispose(Gecode::Space& home)
 {
     home.ignore(*this, AP_DISPOSE);
     c.dispose(home);
+    mSupplyDemand.~IntSharedArray();
     (void) NaryPropagator<Gecode::Set::SetView, Gecode::Set::PC_SET_NONE>::dispose(home);
     return sizeof(*this);
 }
@@ -186,6 +165,14 @@ Gecode::ExecStatus IsValidTransportEdge::advise(Gecode::Space& home, Gecode::Adv
 
         if(x.assigned())
         {
+            // Current supply demand on all outgoing edges, and marker for the
+            // edges that have a demand
+            Gecode::Region r;
+            int* edgeValue = r.alloc<int>(advisor.numberOfFluents);
+            bool* edgeWithDemand = r.alloc<bool>(advisor.numberOfFluents);
+            std::fill(edgeValue, edgeValue + advisor.numberOfFluents, 0);
+            std::fill(edgeWithDemand, edgeWithDemand + advisor.numberOfFluents, false);
+
             for(size_t idx = 0; idx < (size_t) x.size(); ++idx)
             {
                 Gecode::Set::SetView& view = advisor.x[idx];
@@ -196,25 +183,23 @@ Gecode::ExecStatus IsValidTransportEdge::advise(Gecode::Space& home, Gecode::Adv
                     // assumption of forward pointing in time
                     assert(targetIdx >= mSpaceTimeOffset);
                     size_t localTargetEdgeIdx = targetIdx - mSpaceTimeOffset;
+                    assert(localTargetEdgeIdx < advisor.numberOfFluents);
 
                     // Mark edges that have an actual demand
                     if(mSupplyDemand[idx] < 0)
                     {
                         if( static_cast<size_t>( targetIdx ) != mLocalTargetFluent + idx)
                         {
-                            advisor.edgeIdxWithDemand.insert(localTargetEdgeIdx);
+                            edgeWithDemand[localTargetEdgeIdx] = true;
                         }
                     }
-                    advisor.edgeValue[localTargetEdgeIdx] += mSupplyDemand[idx];
+                    edgeValue[localTargetEdgeIdx] += mSupplyDemand[idx];
                 }
             }
 
-            std::set<size_t>::const_iterator cit = advisor.edgeIdxWithDemand.begin();
-            for(; cit != advisor.edgeIdxWithDemand.end(); ++cit)
+            for(size_t i = 0; i < advisor.numberOfFluents; ++i)
             {
-                assert(advisor.edgeValue.size() > *cit);
-                int demand = advisor.edgeValue.at( *cit );
-                if(demand < 0)
+                if(edgeWithDemand[i] && edgeValue[i] < 0)
                 {
                     return ES_FAILED;
                 }
@@ -4,7 +4,6 @@
 #include <gecode/int.hh>
 #include <gecode/int/rel.hh>
 #include <gecode/minimodel.hh>
-#include <set>
 #include <vector>
 
 namespace templ {
@@ -22,13 +21,15 @@ class IsValidTransportEdge : public Gecode::NaryPropagator<Gecode::Set::SetView,
 public:
     typedef Gecode::ViewArray<Gecode::Set::SetView> SetVarArrayView;
 
+    /**
+     * The advisor is disposed once all views are assigned, so that the supply
+     * demand per edge is computed in a single advise call and does not need to
+     * be stored
+     */
     class DemandSupply : public Gecode::Advisor
     {
     public:
-        // This represent the outgoing edges that have a demand and associated demands
-        std::set<size_t> edgeIdxWithDemand;
-        // This array represent the current supply demand on all edges
-        std::vector<int> edgeValue;
+        size_t numberOfFluents;
         SetVarArrayView x;
 
         DemandSupply(Gecode::Space& home, Gecode::Propagator& p, Gecode::Council<DemandSupply>& c, SetVarArrayView x, size_t numberOfFluents);
@@ -46,8 +47,9 @@ protected:
     size_t mTimepoint;
     size_t mFluent;
 
-    std::vector<int32_t> mSupplyDemand;
-    std::vector<size_t> mDemandEdges;
+    // The supply demand never changes, so that it is shared between all
+    // copies
+    Gecode::IntSharedArray mSupplyDemand;
     uint32_t mLocalTargetFluent;
     uint32_t mSpaceTimeOffset;
 
@@ -1,6 +1,7 @@
 #include <gecode/int.hh>
 #include <gecode/int/rel.hh>
 #include <gecode/minimodel.hh>
+#include <algorithm>
 #include <base-logging/Logging.hpp>
 #include <moreorg/facades/Robot.hpp>
 
@@ -19,6 +20,37 @@ void multiCommodityFlow(Gecode::Space& home,
         uint32_t numberOfTimepoints, uint32_t numberOfFluents,
         const moreorg::OrganizationModelAsk& ask)
 {
+    // Cache supply/demand for each role to
+    // avoid recomputation
+    // positive value means a provided capacity
+    // a negative value means required (transport) capacity
+    std::vector<int32_t> supplyDemand;
+    for(const Role& role : roles)
+    {
+        moreorg::facades::Robot robot(role.getModel(), ask);
+        int32_t roleSupplyDemand = robot.getTransportSupplyDemand();
+        if(roleSupplyDemand == 0)
+        {
+            throw std::invalid_argument("templ::propagators::MultiCommodityFlow: " +  role.getModel().toString() + " has"
+                    " a transportSupplyDemand of 0 -- must be either positive of negative integer");
+        }
+        LOG_DEBUG_S << "SupplyDemand: " << role.toString()   << " " << roleSupplyDemand;
+        supplyDemand.push_back(roleSupplyDemand);
+    }
+
+    multiCommodityFlow(home, supplyDemand, timelines, numberOfTimepoints, numberOfFluents);
+}
+
+void multiCommodityFlow(Gecode::Space& home,
+        const std::vector<int32_t>& supplyDemand,
+        const std::vector<Gecode::SetVarArray>& timelines,
+        uint32_t numberOfTimepoints, uint32_t numberOfFluents)
+{
+    if(supplyDemand.size() != timelines.size())
+    {
+        throw std::invalid_argument("templ::propagators::multiCommodityFlow: number of timelines and supply/demand values differ");
+    }
+
     // If there is no path -- fail directly
     if(timelines.empty())
     {
@@ -28,7 +60,7 @@ void multiCommodityFlow(Gecode::Space& home,
         // It concatenates all the timelines that exist for the given (active)
         // roles
         size_t viewIdx = 0;
-        ViewArray<Set::SetView> xv(home, timelines.front().size()*roles.size());
+        ViewArray<Set::SetView> xv(home, timelines.front().size()*timelines.size());
         std::vector<Gecode::SetVarArray>::const_iterator tit = timelines.begin();
         for(; tit != timelines.end(); ++tit)
         {
@@ -36,13 +68,13 @@ void multiCommodityFlow(Gecode::Space& home,
             Gecode::SetVarArray::const_iterator ait = args.begin();
             for(; ait != args.end(); ++ait)
             {
-                assert(viewIdx < xv.size());
+                assert(viewIdx < (size_t) xv.size());
                 xv[viewIdx++] = Set::SetView(*ait);
             }
         }
 
         LOG_DEBUG_S << "MultiCommodityFlow: propagate #timepoints " << numberOfTimepoints << ", #fluents " << numberOfFluents;
-        if(MultiCommodityFlow::post(home, roles, xv, numberOfTimepoints, numberOfFluents, ask) != ES_OK)
+        if(MultiCommodityFlow::post(home, xv, supplyDemand, numberOfTimepoints, numberOfFluents) != ES_OK)
         {
             home.fail();
         }
@@ -54,129 +86,125 @@ void multiCommodityFlow(Gecode::Space& home,
     }
 }
 
+MultiCommodityFlow::ViewAdvisor::ViewAdvisor(Gecode::Space& home,
+        Gecode::Propagator& p,
+        Gecode::Council<ViewAdvisor>& c,
+        int idx,
+        Gecode::Set::SetView x)
+    : Gecode::Advisor(home, p, c)
+    , idx(idx)
+    , x(x)
+{
+    x.subscribe(home, *this);
+}
+
+MultiCommodityFlow::ViewAdvisor::ViewAdvisor(Gecode::Space& home, ViewAdvisor& other)
+    : Gecode::Advisor(home, other)
+    , idx(other.idx)
+{
+    x.update(home, other.x);
+}
+
+void MultiCommodityFlow::ViewAdvisor::dispose(Gecode::Space& home, Gecode::Council<ViewAdvisor>& c)
+{
+    x.cancel(home, *this);
+    Advisor::dispose(home, c);
+}
+
 MultiCommodityFlow::MultiCommodityFlow(Gecode::Space& home,
-        const Role::List& roles,
         SetViewViewArray& xv,
-        uint32_t numberOfTimepoints, uint32_t numberOfFluents,
-        const moreorg::OrganizationModelAsk& ask)
-    : NaryPropagator<Set::SetView, Set::PC_SET_ANY>(home, xv)
-    , mRoles(roles)
+        const std::vector<int32_t>& supplyDemand,
+        uint32_t numberOfTimepoints, uint32_t numberOfFluents)
+    : NaryPropagator<Set::SetView, Set::PC_SET_NONE>(home, xv)
+    , c(home)
     , mNumberOfTimepoints(numberOfTimepoints)
     , mNumberOfFluents(numberOfFluents)
     , mLocationTimeSize(numberOfTimepoints*numberOfFluents)
-    , mTimelineSize(mLocationTimeSize*mLocationTimeSize)
-    , mAsk(ask)
-    , mCapacityGraph()
+    , mNumberOfRoles(supplyDemand.size())
+    , mRoleSupplyDemand(std::vector<int>(supplyDemand.begin(), supplyDemand.end()))
+    , mCommittedSupplyDemand(home.alloc<int>(mLocationTimeSize*mNumberOfFluents))
+    , mModifiedSources(home)
+    , mIsModifiedSource(home.alloc<bool>(mLocationTimeSize))
 {
-    // Cache supply/demand for each role to
-    // avoid recomputation
-    // positive value means a provided capacity
-    // a negative value means required (transport) capacity
-    if(mRoleSupplyDemand.empty())
-    {
-        for(uint32_t roleIdx = 0; roleIdx < mRoles.size(); ++roleIdx)
-        {
-            const Role& role = mRoles[roleIdx];
-            moreorg::facades::Robot robot(role.getModel(), mAsk);
-            int32_t supplyDemand = robot.getTransportSupplyDemand();
-            if(supplyDemand == 0)
-            {
-                throw std::invalid_argument("templ::propagators::MultiCommodityFlow: " +  role.getModel().toString() + " has"
-                        " a transportSupplyDemand of 0 -- must be either positive of negative integer");
-            }
-            mRoleSupplyDemand.push_back(supplyDemand);
+    // The shared array has to be released when the space is deleted
+    home.notice(*this, Gecode::AP_DISPOSE);
 
-            LOG_WARN_S << "SupplyDemand: " << role.toString()   << " " << supplyDemand;
+    assert(x.size() == static_cast<int>(mNumberOfRoles*mLocationTimeSize));
 
-            for(uint32_t i = 0; i < mLocationTimeSize; ++i)
-            {
-                // the current roles timeline is in the
-                // concatenated list of timelines, thus we use
-                // the start offset: roleIdx*mLocationTimeSize
-                // to then interate over the timeline values
-                size_t idx = roleIdx*mLocationTimeSize + i;
-
-                // the target index (in the local timeline)
-                // -- the set is actually an adjacency list, so the index
-                // identifies the source space-time and the set value the
-                // target's space-time (if there is a target)
-                SetVar var(xv[idx]);
-                if(!var.assigned())
-                {
-                    throw std::invalid_argument("Cannot propagate since value is not assigned");
-                }
+    std::fill(mCommittedSupplyDemand, mCommittedSupplyDemand + mLocationTimeSize*mNumberOfFluents, 0);
+    std::fill(mIsModifiedSource, mIsModifiedSource + mLocationTimeSize, false);
+
+    for(int idx = 0; idx < x.size(); ++idx)
+    {
+        // the current roles timeline is in the
+        // concatenated list of timelines, thus we use
+        // the start offset: roleIdx*mLocationTimeSize
+        // -- the set is actually an adjacency list, so the index
+        // identifies the source space-time and the set value the
+        // target's space-time (if there is a target)
+        uint32_t roleIdx = idx / mLocationTimeSize;
+        uint32_t source = idx % mLocationTimeSize;
 
-                LOG_INFO_S << "Role " << roleIdx << " pos: " << i << " val glbSize: " << var.glbSize() << "  lubSize: " << var.lubSize() << " cardMax: " << var.cardMax() << " cardMin: " << var.cardMin();
-                // Check that the value is assigned, by checking that
-                // the set has cardinality 1
-                if(var.cardMax() == 1 && var.cardMin() == 1)
+        if(x[idx].assigned())
+        {
+            if(x[idx].glbSize() == 1)
+            {
+                uint32_t target = x[idx].glbMin();
+                if(target/mNumberOfFluents == source/mNumberOfFluents + 1)
                 {
-                    Gecode::SetVarGlbValues currentVar(var);
-                    std::pair<uint32_t, uint32_t> key(i, currentVar.val());
-
-                    // here we assign the supply demand of the role to the
-                    // current timeline value -- i will identify the same
-                    // space-time in all role timelines
-                    std::vector<int32_t>& supplyDemandVector = mCapacityGraph[key];
-                    supplyDemandVector.push_back( supplyDemand );
+                    mCommittedSupplyDemand[ getEdgeIdx(source, target) ] += mRoleSupplyDemand[roleIdx];
                 }
             }
+        } else {
+            (void) new (home) ViewAdvisor(home, *this, c, idx, x[idx]);
         }
     }
 
-    CapacityGraph::const_iterator cit = mCapacityGraph.begin();
-    for(; cit != mCapacityGraph.end(); ++cit)
+    for(uint32_t source = 0; source < mLocationTimeSize; ++source)
     {
-        const CapacityGraphKey& key = cit->first;
-        const std::vector<int32_t>& supplyDemand = cit->second;
-        if(isLocalTransition(key))
-        {
-            // this is a local transition with no capacity restriction
-            LOG_WARN_S << "This is a local transition: from " << key.first << " to " << key.second;
-        } else {
-            int32_t sum = 0;
-            std::vector<int32_t>::const_iterator vit = supplyDemand.begin();
-            for(; vit != supplyDemand.end(); ++vit)
-            {
-                sum += *vit;
-            }
-            if(sum < 0)
-            {
-                LOG_WARN_S << "SUM is " << sum << "  failing space at transition: from " <<  key.first << " to " << key.second;
-                LOG_WARN_S << xv;
-                home.fail();
-            }
-        }
-
+        markSource(source);
     }
+    reschedule(home);
 }
 
 MultiCommodityFlow::MultiCommodityFlow(Gecode::Space& home, MultiCommodityFlow& flow)
-    : NaryPropagator<Set::SetView, Set::PC_SET_ANY>(home, flow)
-    , mAsk(flow.mAsk)
-    , mCapacityGraph(flow.mCapacityGraph)
+    : NaryPropagator<Set::SetView, Set::PC_SET_NONE>(home, flow)
+    , mNumberOfTimepoints(flow.mNumberOfTimepoints)
+    , mNumberOfFluents(flow.mNumberOfFluents)
+    , mLocationTimeSize(flow.mLocationTimeSize)
+    , mNumberOfRoles(flow.mNumberOfRoles)
     , mRoleSupplyDemand(flow.mRoleSupplyDemand)
+    , mCommittedSupplyDemand(home.alloc<int>(flow.mLocationTimeSize*flow.mNumberOfFluents))
+    , mModifiedSources(home)
+    , mIsModifiedSource(home.alloc<bool>(flow.mLocationTimeSize))
 {
-    x.update(home, flow.x);
+    std::copy(flow.mCommittedSupplyDemand, flow.mCommittedSupplyDemand + mLocationTimeSize*mNumberOfFluents, mCommittedSupplyDemand);
+    std::fill(mIsModifiedSource, mIsModifiedSource + mLocationTimeSize, false);
+    c.update(home, flow.c);
 }
 
 Gecode::ExecStatus MultiCommodityFlow::post(Gecode::Space& home,
-        const Role::List& roles,
         SetViewViewArray& xv,
-        uint32_t numberOfTimepoints, uint32_t numberOfFluents,
-        const moreorg::OrganizationModelAsk& ask
+        const std::vector<int32_t>& supplyDemand,
+        uint32_t numberOfTimepoints, uint32_t numberOfFluents
         )
 {
     // documentation. 4.3.1 Post functions are clever
     // A constraint post function carefully analyzes its arguments. Based on
     // this analysis, the constraint post function chooses the best possible propagator for the constraint
-    (void) new (home) MultiCommodityFlow(home, roles, xv, numberOfTimepoints, numberOfFluents, ask);
+    (void) new (home) MultiCommodityFlow(home, xv, supplyDemand, numberOfTimepoints, numberOfFluents);
     return ES_OK;
 }
 
 size_t MultiCommodityFlow::dispose(Gecode::Space& home)
 {
-    (void) Propagator::dispose(home);
+    home.ignore(*this, Gecode::AP_DISPOSE);
+    c.dispose(home);
+    home.free<int>(mCommittedSupplyDemand, mLocationTimeSize*mNumberOfFluents);
+    home.free<bool>(mIsModifiedSource, mLocationTimeSize);
+    mModifiedSources.~IndexStack();
+    mRoleSupplyDemand.~IntSharedArray();
+    (void) NaryPropagator<Set::SetView, Set::PC_SET_NONE>::dispose(home);
     return sizeof(*this);
 }
 
@@ -187,21 +215,153 @@ Gecode::Propagator* MultiCommodityFlow::copy(Gecode::Space& home)
 
 Gecode::PropCost MultiCommodityFlow::cost(const Gecode::Space&, const Gecode::ModEventDelta&) const
 {
-    return Gecode::PropCost::quadratic(PropCost::HI, x.size());
+    return Gecode::PropCost::linear(PropCost::LO, x.size());
+}
+
+void MultiCommodityFlow::reschedule(Gecode::Space& home)
+{
+    Gecode::Set::SetView::schedule(home, *this, Gecode::ME_GEN_ASSIGNED);
+}
+
+Gecode::ExecStatus MultiCommodityFlow::advise(Gecode::Space& home, Gecode::Advisor& a, const Gecode::Delta&)
+{
+    ViewAdvisor& advisor = static_cast<ViewAdvisor&>(a);
+    uint32_t roleIdx = advisor.idx / mLocationTimeSize;
+    uint32_t source = advisor.idx % mLocationTimeSize;
+
+    if(advisor.x.assigned())
+    {
+        // Commit the supply/demand of the role to the selected edge
+        if(advisor.x.glbSize() == 1)
+        {
+            uint32_t target = advisor.x.glbMin();
+            if(target/mNumberOfFluents == source/mNumberOfFluents + 1)
+            {
+                mCommittedSupplyDemand[ getEdgeIdx(source, target) ] += mRoleSupplyDemand[roleIdx];
+            }
+        }
+        markSource(source);
+        return home.ES_NOFIX_DISPOSE(c, advisor);
+    }
+
+    // A reduced domain of a provider reduces the potential supply on the
+    // outgoing edges, while a reduced domain of a role with a demand does not
+    // affect the other roles
+    if(mRoleSupplyDemand[roleIdx] > 0)
+    {
+        markSource(source);
+        return ES_NOFIX;
+    }
+    return ES_FIX;
 }
 
 Gecode::ExecStatus MultiCommodityFlow::propagate(Gecode::Space& home, const Gecode::ModEventDelta&)
 {
+    // Revising a source might modify views, which leads to the
+    // (re)registration of sources via the advisors
+    while(!mModifiedSources.empty())
+    {
+        int source = mModifiedSources.pop();
+        mIsModifiedSource[source] = false;
+
+        GECODE_ES_CHECK(reviseSource(home, source));
+    }
+
     if(x.assigned())
     {
         return home.ES_SUBSUMED(*this);
-    } else if(home.failed())
+    }
+    return ES_FIX;
+}
+
+Gecode::ExecStatus MultiCommodityFlow::reviseSource(Gecode::Space& home, uint32_t source)
+{
+    uint32_t timepoint = source / mNumberOfFluents;
+    if(timepoint + 1 >= mNumberOfTimepoints)
     {
-        return ES_FAILED;
-    } else {
-        // the propagator will be scheduled if one of its views have been modified
-        return ES_NOFIX;
+        // No outgoing edges
+        return ES_OK;
+    }
+    uint32_t targetOffset = (timepoint + 1)*mNumberOfFluents;
+
+    // Supply of all providers, which have not been assigned, but can still
+    // use the edge
+    Gecode::Region r;
+    int* potentialSupply = r.alloc<int>(mNumberOfFluents);
+    std::fill(potentialSupply, potentialSupply + mNumberOfFluents, 0);
+    for(uint32_t roleIdx = 0; roleIdx < mNumberOfRoles; ++roleIdx)
+    {
+        int supplyDemand = mRoleSupplyDemand[roleIdx];
+        Gecode::Set::SetView& view = x[roleIdx*mLocationTimeSize + source];
+        if(supplyDemand <= 0 || view.assigned())
+        {
+            continue;
+        }
+
+        for(uint32_t f = 0; f < mNumberOfFluents; ++f)
+        {
+            if(!view.notContains(targetOffset + f))
+            {
+                potentialSupply[f] += supplyDemand;
+            }
+        }
     }
+
+    for(uint32_t f = 0; f < mNumberOfFluents; ++f)
+    {
+        uint32_t target = targetOffset + f;
+        if(isLocalTransition(CapacityGraphKey(source, target)))
+        {
+            // this is a local transition with no capacity restriction
+            continue;
+        }
+
+        int maxSupplyDemand = mCommittedSupplyDemand[ getEdgeIdx(source, target) ] + potentialSupply[f];
+        if(maxSupplyDemand < 0)
+        {
+            LOG_DEBUG_S << "Insufficient transport capacity " << maxSupplyDemand << " at transition: from " << source << " to " << target;
+            return ES_FAILED;
+        }
+
+        for(uint32_t roleIdx = 0; roleIdx < mNumberOfRoles; ++roleIdx)
+        {
+            Gecode::Set::SetView& view = x[roleIdx*mLocationTimeSize + source];
+            if(view.assigned() || view.contains(target) || view.notContains(target))
+            {
+                continue;
+            }
+
+            int supplyDemand = mRoleSupplyDemand[roleIdx];
+            if(supplyDemand < 0)
+            {
+                // The demand of this role cannot be covered on this edge
+                if(maxSupplyDemand + supplyDemand < 0)
+                {
+                    GECODE_ME_CHECK(view.exclude(home, target));
+                }
+            } else if(maxSupplyDemand - supplyDemand < 0)
+            {
+                // The committed demand cannot be covered without this provider
+                GECODE_ME_CHECK(view.include(home, target));
+            }
+        }
+    }
+    return ES_OK;
+}
+
+void MultiCommodityFlow::markSource(uint32_t source)
+{
+    if(!mIsModifiedSource[source])
+    {
+        mIsModifiedSource[source] = true;
+        mModifiedSources.push(source);
+    }
+}
+
+uint32_t MultiCommodityFlow::getEdgeIdx(uint32_t source, uint32_t target) const
+{
+    assert(target/mNumberOfFluents == source/mNumberOfFluents + 1);
+    return source*mNumberOfFluents + target%mNumberOfFluents;
 }
 
 bool MultiCommodityFlow::isLocalTransition(const CapacityGraphKey& key) const
@@ -217,4 +377,3 @@ bool MultiCommodityFlow::isLocalTransition(const CapacityGraphKey& key) const
 } // end namespace csp
 } // end namespace solvers
 } // end namespace templ
-
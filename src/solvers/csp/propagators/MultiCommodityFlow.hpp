@@ -6,6 +6,7 @@
 #include <gecode/int.hh>
 #include <gecode/int/rel.hh>
 #include <gecode/minimodel.hh>
+#include <gecode/support.hh>
 
 #include <moreorg/OrganizationModel.hpp>
 #include <moreorg/OrganizationModelAsk.hpp>
@@ -16,44 +17,62 @@ namespace solvers {
 namespace csp {
 namespace propagators {
 
-// MultiCommodityFlow computation
-class MultiCommodityFlow : public Gecode::NaryPropagator<Gecode::Set::SetView, Gecode::Set::PC_SET_ANY>
+/**
+ * \class MultiCommodityFlow
+ * \brief Transport capacity propagator for the timelines of all roles
+ * \details The timelines of all roles are concatenated, so that view
+ * roleIdx*numberOfTimepoints*numberOfFluents + i is the adjacency list of
+ * space time point i of the role with index roleIdx.
+ * Each role has a transport supply (positive value) or demand (negative
+ * value). The sum over all roles which use a (non-local) transition edge must
+ * not be negative, i.e. the transport demand has to be covered by the
+ * transport providers.
+ *
+ * The propagator maintains a running sum of the supply/demand of the assigned
+ * roles per edge, which is updated by advisors when a view becomes assigned.
+ * Only the edges starting at a space time point whose views changed are
+ * revised, where
+ *   - the space fails, if the committed sum plus the supply of all providers
+ *     which can still use the edge is negative
+ *   - a role with a demand is excluded from an edge, if its demand cannot be
+ *     covered
+ *   - a provider is forced onto an edge, if the committed demand cannot be
+ *     covered without it
+ */
+class MultiCommodityFlow : public Gecode::NaryPropagator<Gecode::Set::SetView, Gecode::Set::PC_SET_NONE>
 {
 public:
     typedef Gecode::ViewArray<Gecode::Set::SetView> SetViewViewArray;
     typedef std::pair<uint32_t,uint32_t> CapacityGraphKey;
-    typedef std::map< CapacityGraphKey , std::vector<int32_t> > CapacityGraph;
-
-    // Input
-    //     --> TupleSet: defining what types of Systems of combinations are
-    // required
-    //     --> ModelRequirement: defining what models are at minimum required at
-    //     one position
-    //
-    // Output:
-    //     --> propagation of boolean constraints of the form
-    //     Gecode::LinIntExpr cardinalityRequirementA(numberOfModelsA, Gecode::IRT_LE, requiredNumberOfModelAInstances);
-    //     Gecode::LinIntExpr cardinalityRequirementB(numberOfModelsB, Gecode::IRT_LE, requiredNumberOfModelBInstances);
-    //
-    //     BoolExpr combinedSystemA(cardinalityRequirementA, BoolExpr::AND,
-    //     cardinalityRequirementB);
-    //
-    //     BoolExpr minOneCombinedSystem(combinedSystemA, BoolExpr::OR,
-    //     cardinalityRequirementB);
-
-
-    MultiCommodityFlow(Gecode::Space& home, const Role::List& roles,
+    typedef Gecode::Support::DynamicStack<int, Gecode::Space> IndexStack;
+
+    /**
+     * Advisor for a single view, i.e. an adjacency list of one role
+     */
+    class ViewAdvisor : public Gecode::Advisor
+    {
+    public:
+        int idx;
+        Gecode::Set::SetView x;
+
+        ViewAdvisor(Gecode::Space& home, Gecode::Propagator& p, Gecode::Council<ViewAdvisor>& c, int idx, Gecode::Set::SetView x);
+        ViewAdvisor(Gecode::Space& home, ViewAdvisor& other);
+
+        void dispose(Gecode::Space& home, Gecode::Council<ViewAdvisor>& c);
+    };
+
+    MultiCommodityFlow(Gecode::Space& home,
             SetViewViewArray& timelines,
-            uint32_t numberOfTimepoints, uint32_t numberOfFluent,
-            const moreorg::OrganizationModelAsk& ask);
+            const std::vector<int32_t>& supplyDemand,
+            uint32_t numberOfTimepoints, uint32_t numberOfFluent);
 
     MultiCommodityFlow(Gecode::Space& home,
             MultiCommodityFlow& flow);
 
-    static Gecode::ExecStatus post(Gecode::Space& home, const Role::List& roles,
+    static Gecode::ExecStatus post(Gecode::Space& home,
             SetViewViewArray& timelines,
-            uint32_t numberOfTimepoints, uint32_t numberOfFluent,
-            const moreorg::OrganizationModelAsk& ask);
+            const std::vector<int32_t>& supplyDemand,
+            uint32_t numberOfTimepoints, uint32_t numberOfFluent);
 
     virtual size_t dispose(Gecode::Space& home);
 
@@ -61,26 +80,52 @@ public:
 
     virtual Gecode::PropCost cost(const Gecode::Space&, const Gecode::ModEventDelta&) const;
 
+    virtual void reschedule(Gecode::Space& home);
+
+    virtual Gecode::ExecStatus advise(Gecode::Space& home, Gecode::Advisor& a, const Gecode::Delta& d);
+
     virtual Gecode::ExecStatus propagate(Gecode::Space& home, const Gecode::ModEventDelta&);
 
     bool isLocalTransition(const CapacityGraphKey& key) const;
+
 protected:
-    Role::List mRoles;
+    /**
+     * Mark a space time point, so that its outgoing edges are revised with the
+     * next propagation
+     */
+    void markSource(uint32_t source);
+
+    /**
+     * Revise all outgoing edges of the given space time point
+     */
+    Gecode::ExecStatus reviseSource(Gecode::Space& home, uint32_t source);
+
+    /**
+     * Get the edge index of the transition from source to target,
+     * where target has to be part of the next timestep
+     */
+    uint32_t getEdgeIdx(uint32_t source, uint32_t target) const;
+
+    Gecode::Council<ViewAdvisor> c;
+
     uint32_t mNumberOfTimepoints;
     uint32_t mNumberOfFluents;
     uint32_t mLocationTimeSize;
-    uint32_t mTimelineSize;
-
-    moreorg::OrganizationModelAsk mAsk;
-
-    // The elements in the wrapped array a are accessed in row-major order
-    // as it is for all array in Gecode
-    // http://www.gecode.org/doc-latest/reference/classGecode_1_1Matrix.html#_details
-    CapacityGraph mCapacityGraph;
+    uint32_t mNumberOfRoles;
 
     // Map the role index to the transport supply/demand
     // Supply Demand can be either positive or negative
-    std::vector<int32_t> mRoleSupplyDemand;
+    // The values never change, so that they are shared between all copies
+    Gecode::IntSharedArray mRoleSupplyDemand;
+
+    // Running sum of the supply/demand of all roles that have been assigned
+    // to an edge (space allocated of size mLocationTimeSize*mNumberOfFluents)
+    int* mCommittedSupplyDemand;
+
+    // Space time points whose outgoing edges require revision
+    // (space allocated, and empty when the propagator is copied)
+    IndexStack mModifiedSources;
+    bool* mIsModifiedSource;
 };
 
 void multiCommodityFlow(Gecode::Space& home,
@@ -89,6 +134,15 @@ void multiCommodityFlow(Gecode::Space& home,
         uint32_t numberOfTimepoints, uint32_t numberOfFluents,
         const moreorg::OrganizationModelAsk& ask);
 
+/**
+ * Post the multi commodity flow propagator using the given transport
+ * supply/demand per timeline
+ */
+void multiCommodityFlow(Gecode::Space& home,
+        const std::vector<int32_t>& supplyDemand,
+        const std::vector<Gecode::SetVarArray>& timelines,
+        uint32_t numberOfTimepoints, uint32_t numberOfFluents);
+
 } // end propagators
 } // end csp
 } // end solvers
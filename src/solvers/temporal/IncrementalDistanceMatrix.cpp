@@ -0,0 +1,233 @@
+#include "IncrementalDistanceMatrix.hpp"
+#include <limits>
+#include <stdexcept>
+#include <algorithm>
+
+namespace templ {
+namespace solvers {
+namespace temporal {
+
+IncrementalDistanceMatrix::IncrementalDistanceMatrix()
+    : mCapacity(0)
+    , mNumberOfRejectedConstraints(0)
+{
+}
+
+size_t IncrementalDistanceMatrix::addTimePoint(const point_algebra::TimePoint::Ptr& timepoint)
+{
+    std::map<const point_algebra::TimePoint*, size_t>::const_iterator it = mIndex.find(timepoint.get());
+    if(it != mIndex.end())
+    {
+        return it->second;
+    }
+
+    size_t idx = mTimePoints.size();
+    if(idx == mCapacity)
+    {
+        // Grow geometrically to keep the amortized cost of adding timepoints
+        // linear in the size of the matrix
+        size_t capacity = std::max(static_cast<size_t>(16), 2*mCapacity);
+        std::vector<double> distances(capacity*capacity, std::numeric_limits<double>::infinity());
+        for(size_t i = 0; i < idx; ++i)
+        {
+            std::copy(mDistances.begin() + i*mCapacity,
+                    mDistances.begin() + i*mCapacity + idx,
+                    distances.begin() + i*capacity);
+        }
+        mDistances.swap(distances);
+        mCapacity = capacity;
+    }
+
+    for(size_t i = 0; i <= idx; ++i)
+    {
+        distance(i, idx) = std::numeric_limits<double>::infinity();
+        distance(idx, i) = std::numeric_limits<double>::infinity();
+    }
+    distance(idx, idx) = 0.0;
+
+    mTimePoints.push_back(timepoint);
+    mIndex[timepoint.get()] = idx;
+    return idx;
+}
+
+bool IncrementalDistanceMatrix::hasTimePoint(const point_algebra::TimePoint::Ptr& timepoint) const
+{
+    return mIndex.count(timepoint.get());
+}
+
+bool IncrementalDistanceMatrix::addConstraint(const point_algebra::TimePoint::Ptr& source,
+        const point_algebra::TimePoint::Ptr& target,
+        const Bounds& bounds)
+{
+    size_t i = addTimePoint(source);
+    size_t j = addTimePoint(target);
+
+    if(!isConsistent(source, target, bounds))
+    {
+        ++mNumberOfRejectedConstraints;
+        return false;
+    }
+
+    // The check above guarantees that neither edge introduces a negative cycle
+    addEdge(i, j, bounds.getUpperBound());
+    addEdge(j, i, -bounds.getLowerBound());
+    return true;
+}
+
+bool IncrementalDistanceMatrix::addDistanceConstraint(const point_algebra::TimePoint::Ptr& source,
+        const point_algebra::TimePoint::Ptr& target,
+        double weight)
+{
+    size_t i = addTimePoint(source);
+    size_t j = addTimePoint(target);
+
+    if(weight + distance(j,i) < 0)
+    {
+        ++mNumberOfRejectedConstraints;
+        return false;
+    }
+    addEdge(i, j, weight);
+    return true;
+}
+
+bool IncrementalDistanceMatrix::assign(const std::vector<DistanceConstraint>& constraints)
+{
+    clear();
+    for(const DistanceConstraint& c : constraints)
+    {
+        size_t i = addTimePoint(c.source);
+        size_t j = addTimePoint(c.target);
+        distance(i,j) = std::min(distance(i,j), c.distance);
+    }
+
+    size_t n = mTimePoints.size();
+    for(size_t k = 0; k < n; ++k)
+    {
+        const double* rowK = &mDistances[k*mCapacity];
+        for(size_t x = 0; x < n; ++x)
+        {
+            double toK = distance(x,k);
+            if(toK == std::numeric_limits<double>::infinity())
+            {
+                continue;
+            }
+
+            double* row = &mDistances[x*mCapacity];
+            for(size_t y = 0; y < n; ++y)
+            {
+                double d = toK + rowK[y];
+                if(d < row[y])
+                {
+                    row[y] = d;
+                }
+            }
+        }
+    }
+
+    for(size_t i = 0; i < n; ++i)
+    {
+        if(distance(i,i) < 0)
+        {
+            clear();
+            return false;
+        }
+    }
+    return true;
+}
+
+void IncrementalDistanceMatrix::clear()
+{
+    mTimePoints.clear();
+    mIndex.clear();
+    mDistances.clear();
+    mCapacity = 0;
+}
+
+bool IncrementalDistanceMatrix::isConsistent(const point_algebra::TimePoint::Ptr& source,
+        const point_algebra::TimePoint::Ptr& target,
+        const Bounds& bounds) const
+{
+    if(!bounds.isValid())
+    {
+        return false;
+    }
+
+    // Unknown timepoints are unconstrained
+    if(!hasTimePoint(source) || !hasTimePoint(target))
+    {
+        return source != target || (bounds.getLowerBound() <= 0 && bounds.getUpperBound() >= 0);
+    }
+
+    // The minimal network contains all feasible values, so that the
+    // constraint is consistent iff it intersects with the minimal network
+    // constraint
+    Bounds current = getBounds(source, target);
+    return std::max(current.getLowerBound(), bounds.getLowerBound())
+        <= std::min(current.getUpperBound(), bounds.getUpperBound());
+}
+
+double IncrementalDistanceMatrix::getDistance(const point_algebra::TimePoint::Ptr& source,
+        const point_algebra::TimePoint::Ptr& target) const
+{
+    return distance(getIndex(source), getIndex(target));
+}
+
+Bounds IncrementalDistanceMatrix::getBounds(const point_algebra::TimePoint::Ptr& source,
+        const point_algebra::TimePoint::Ptr& target) const
+{
+    size_t i = getIndex(source);
+    size_t j = getIndex(target);
+    return Bounds(-distance(j,i), distance(i,j));
+}
+
+size_t IncrementalDistanceMatrix::getIndex(const point_algebra::TimePoint::Ptr& timepoint) const
+{
+    std::map<const point_algebra::TimePoint*, size_t>::const_iterator it = mIndex.find(timepoint.get());
+    if(it == mIndex.end())
+    {
+        throw std::invalid_argument("templ::solvers::temporal::IncrementalDistanceMatrix::getIndex: unknown timepoint '" + timepoint->toString() + "'");
+    }
+    return it->second;
+}
+
+void IncrementalDistanceMatrix::addEdge(size_t i, size_t j, double weight)
+{
+    if(weight >= distance(i,j))
+    {
+        return;
+    }
+
+    size_t n = mTimePoints.size();
+    // Cache the column d(*,i), since row i might be updated in the loop below
+    std::vector<double> toI(n);
+    for(size_t x = 0; x < n; ++x)
+    {
+        toI[x] = distance(x,i);
+    }
+    // Row j is not modified: an update of d(j,y) would require a negative
+    // cycle through the edge i -> j
+    const double* fromJ = &mDistances[j*mCapacity];
+
+    for(size_t x = 0; x < n; ++x)
+    {
+        if(toI[x] == std::numeric_limits<double>::infinity())
+        {
+            continue;
+        }
+
+        double viaEdge = toI[x] + weight;
+        double* row = &mDistances[x*mCapacity];
+        for(size_t y = 0; y < n; ++y)
+        {
+            double d = viaEdge + fromJ[y];
+            if(d < row[y])
+            {
+                row[y] = d;
+            }
+        }
+    }
+}
+
+} // end namespace temporal
+} // end namespace solvers
+} // end namespace templ
@@ -0,0 +1,147 @@
+#ifndef TEMPL_SOLVERS_TEMPORAL_INCREMENTAL_DISTANCE_MATRIX_HPP
+#define TEMPL_SOLVERS_TEMPORAL_INCREMENTAL_DISTANCE_MATRIX_HPP
+
+#include <map>
+#include <vector>
+#include "Bounds.hpp"
+#include "point_algebra/TimePoint.hpp"
+
+namespace templ {
+namespace solvers {
+namespace temporal {
+
+/**
+ * \class IncrementalDistanceMatrix
+ * \brief All pairs shortest path distances of a simple temporal network, which
+ * are maintained under the addition (and tightening) of constraints
+ * \details The distance d(i,j) is the upper bound of t_j - t_i, so that the
+ * minimal network constraint between two timepoints is given by
+ * [-d(j,i), d(i,j)].
+ *
+ * Adding an edge i -> j with weight w requires to update only the paths
+ * passing this edge, i.e. d(x,y) = min(d(x,y), d(x,i) + w + d(j,y)), which is
+ * O(n^2) in contrast to O(n^3) for a recomputation using Floyd-Warshall.
+ * Since the matrix is minimal, a tentative constraint can be checked for
+ * consistency in O(1).
+ *
+ * Constraints which would render the network inconsistent are rejected, i.e.
+ * the matrix always represents a consistent network
+ */
+class IncrementalDistanceMatrix
+{
+public:
+    /// A single edge of the distance graph, i.e. target - source <= distance
+    struct DistanceConstraint
+    {
+        point_algebra::TimePoint::Ptr source;
+        point_algebra::TimePoint::Ptr target;
+        double distance;
+    };
+
+    IncrementalDistanceMatrix();
+
+    /**
+     * Add a timepoint (if it does not exist yet)
+     * \return index of the timepoint
+     */
+    size_t addTimePoint(const point_algebra::TimePoint::Ptr& timepoint);
+
+    /**
+     * Check if the timepoint is part of this matrix
+     */
+    bool hasTimePoint(const point_algebra::TimePoint::Ptr& timepoint) const;
+
+    /**
+     * Get the number of timepoints
+     */
+    size_t size() const { return mTimePoints.size(); }
+
+    /**
+     * Add the constraint lowerBound <= target - source <= upperBound
+     * Timepoints are added if required
+     * \return false if the constraint is inconsistent with the network (and
+     * has not been added), true otherwise
+     */
+    bool addConstraint(const point_algebra::TimePoint::Ptr& source,
+            const point_algebra::TimePoint::Ptr& target,
+            const Bounds& bounds);
+
+    /**
+     * Add the constraint target - source <= distance, i.e. a single edge of
+     * the distance graph
+     * \return false if the constraint is inconsistent with the network (and
+     * has not been added), true otherwise
+     */
+    bool addDistanceConstraint(const point_algebra::TimePoint::Ptr& source,
+            const point_algebra::TimePoint::Ptr& target,
+            double distance);
+
+    /**
+     * Replace the content of this matrix by the shortest path distances of the
+     * given edges of a distance graph
+     * \details Uses a single Floyd-Warshall pass, i.e. O(n^3) independent of
+     * the number of edges, which is preferable to adding many edges one by one
+     * \return false if the edges contain a negative cycle -- the matrix is
+     * empty then, true otherwise
+     */
+    bool assign(const std::vector<DistanceConstraint>& constraints);
+
+    /**
+     * Remove all timepoints and constraints
+     */
+    void clear();
+
+    /**
+     * Check whether the constraint lowerBound <= target - source <= upperBound
+     * is consistent with the network, without modifying it
+     */
+    bool isConsistent(const point_algebra::TimePoint::Ptr& source,
+            const point_algebra::TimePoint::Ptr& target,
+            const Bounds& bounds) const;
+
+    /**
+     * Get the shortest path distance, i.e. the upper bound for target - source
+     * \return distance, or infinity if it is unconstrained
+     * \throw std::invalid_argument if a timepoint is unknown
+     */
+    double getDistance(const point_algebra::TimePoint::Ptr& source,
+            const point_algebra::TimePoint::Ptr& target) const;
+
+    /**
+     * Get the minimal network constraint for target - source
+     * \throw std::invalid_argument if a timepoint is unknown
+     */
+    Bounds getBounds(const point_algebra::TimePoint::Ptr& source,
+            const point_algebra::TimePoint::Ptr& target) const;
+
+    /**
+     * Get the number of rejected, i.e. inconsistent constraints
+     */
+    size_t getNumberOfRejectedConstraints() const { return mNumberOfRejectedConstraints; }
+
+private:
+    size_t getIndex(const point_algebra::TimePoint::Ptr& timepoint) const;
+
+    double& distance(size_t i, size_t j) { return mDistances[i*mCapacity + j]; }
+    double distance(size_t i, size_t j) const { return mDistances[i*mCapacity + j]; }
+
+    /**
+     * Add edge i -> j with weight w and update all affected paths
+     * (the edge must not introduce a negative cycle)
+     */
+    void addEdge(size_t i, size_t j, double weight);
+
+    std::vector<point_algebra::TimePoint::Ptr> mTimePoints;
+    std::map<const point_algebra::TimePoint*, size_t> mIndex;
+
+    /// Row major matrix, with rows of size mCapacity
+    std::vector<double> mDistances;
+    size_t mCapacity;
+
+    size_t mNumberOfRejectedConstraints;
+};
+
+} // end namespace temporal
+} // end namespace solvers
+} // end namespace templ
+#endif // TEMPL_SOLVERS_TEMPORAL_INCREMENTAL_DISTANCE_MATRIX_HPP
@@ -69,6 +69,8 @@ bool QualitativeTemporalConstraintNetwork::isConsistent(ValidationAlgorithm algo
                 return incrementalPathConsistency();
             case TCN_BEEK_MANAK:
                 return pathConsistency_BeekManak();
+            case TCN_MATRIX:
+                return pathConsistency_Matrix();
             default:
                 throw std::invalid_argument("templ::solvers::temporal::QualitativeTemporalConstraintNetwork::isConsistent: given algorithm not supported");
         }
@@ -111,7 +113,7 @@ bool QualitativeTemporalConstraintNetwork::pathConsistency_BeekManak()
                 ConstraintValidationResult constraint = getConstraintType(i,j,k);
                 if(constraint.st_final != constraint.st)
                 {
-                    constraint.constraint_st->setType(constraint.st_final);
+                    updateConstraintType(constraint.constraint_st, constraint.st_final);
                     // enforce symmetry
                     QualitativeTimePointConstraint::Ptr ki = getBidirectionalConstraint(k,i);
 
@@ -130,7 +132,7 @@ bool QualitativeTemporalConstraintNetwork::pathConsistency_BeekManak()
                 ConstraintValidationResult constraint = getConstraintType(k,i,j);
                 if(constraint.st_final != constraint.st)
                 {
-                    constraint.constraint_st->setType(constraint.st_final);
+                    updateConstraintType(constraint.constraint_st, constraint.st_final);
                     // enforce symmetry
                     QualitativeTimePointConstraint::Ptr jk = getBidirectionalConstraint(j,k);
 
@@ -204,6 +206,69 @@ bool QualitativeTemporalConstraintNetwork::incrementalPathConsistency()
     return true;
 }
 
+bool QualitativeTemporalConstraintNetwork::pathConsistency_Matrix()
+{
+    mRelationMatrixVertices = getGraph()->getAllVertices();
+    mRelationMatrix.reset(mRelationMatrixVertices.size());
+
+    std::map<const Vertex*, size_t> index;
+    for(size_t i = 0; i < mRelationMatrixVertices.size(); ++i)
+    {
+        index[mRelationMatrixVertices[i].get()] = i;
+    }
+
+    bool consistent = true;
+    EdgeIterator::Ptr edgeIt = getGraph()->getEdgeIterator();
+    while(edgeIt->next())
+    {
+        QualitativeTimePointConstraint::Ptr constraint = dynamic_pointer_cast<QualitativeTimePointConstraint>(edgeIt->current());
+        if(!constraint)
+        {
+            continue;
+        }
+
+        size_t i = index[constraint->getSourceVertex().get()];
+        size_t j = index[constraint->getTargetVertex().get()];
+        if(!mRelationMatrix.constrain(i, j, QualitativeRelationMatrix::toRelation(constraint->getType())))
+        {
+            consistent = false;
+        }
+    }
+
+    if(consistent)
+    {
+        consistent = mRelationMatrix.pathConsistency();
+    }
+    LOG_DEBUG_S << "Matrix path consistency: timepoints #" << mRelationMatrixVertices.size() << " consistent: " << consistent;
+    return consistent;
+}
+
+void QualitativeTemporalConstraintNetwork::syncRelationMatrix()
+{
+    if(mRelationMatrix.isInconsistent())
+    {
+        throw std::runtime_error("templ::solvers::temporal::QualitativeTemporalConstraintNetwork::syncRelationMatrix: relation matrix is inconsistent");
+    }
+
+    for(size_t i = 0; i < mRelationMatrixVertices.size(); ++i)
+    {
+        for(size_t j = i + 1; j < mRelationMatrixVertices.size(); ++j)
+        {
+            QualitativeRelationMatrix::Relation relation = mRelationMatrix.get(i,j);
+            const Vertex::Ptr& vi = mRelationMatrixVertices[i];
+            const Vertex::Ptr& vj = mRelationMatrixVertices[j];
+            if(relation != QualitativeRelationMatrix::UNIVERSAL || !getGraph()->getEdges(vi, vj).empty())
+            {
+                setConstraintType(vi, vj, QualitativeRelationMatrix::toType(relation));
+            }
+            if(!getGraph()->getEdges(vj, vi).empty())
+            {
+                setConstraintType(vj, vi, QualitativeRelationMatrix::toType(mRelationMatrix.get(j,i)));
+            }
+        }
+    }
+}
+
 // c_ij o c_jk
 QualitativeTimePointConstraint::Type QualitativeTemporalConstraintNetwork::composition(const Vertex::Ptr& i, const Vertex::Ptr& j, const Vertex::Ptr& k)
 {
@@ -384,8 +449,8 @@ QualitativeTimePointConstraint::Ptr QualitativeTemporalConstraintNetwork::getBid
 
     QualitativeTimePointConstraint::Type result = QualitativeTimePointConstraint::getIntersection(ij->getType(), QualitativeTimePointConstraint::getSymmetric(ji->getType()));
 
-    ij->setType(result);
-    ji->setType(QualitativeTimePointConstraint::getSymmetric(result));
+    updateConstraintType(ij, result);
+    updateConstraintType(ji, QualitativeTimePointConstraint::getSymmetric(result));
     return ij;
 }
 
@@ -428,7 +493,16 @@ void QualitativeTemporalConstraintNetwork::setConstraintType(const Vertex::Ptr&
         addQualitativeConstraint(dynamic_pointer_cast<TimePoint>(i), dynamic_pointer_cast<TimePoint>(j), type);
     } else {
         QualitativeTimePointConstraint::Ptr constraint = dynamic_pointer_cast<QualitativeTimePointConstraint>(edges[0]);
+        updateConstraintType(constraint, type);
+    }
+}
+
+void QualitativeTemporalConstraintNetwork::updateConstraintType(const QualitativeTimePointConstraint::Ptr& constraint, QualitativeTimePointConstraint::Type type)
+{
+    if(constraint->getType() != type)
+    {
         constraint->setType(type);
+        incrementRevision();
     }
 }
 
@@ -475,6 +549,7 @@ void QualitativeTemporalConstraintNetwork::compactConstraint(const TimePoint::Pt
                 }
                 getGraph()->removeEdge(*eit);
             }
+            incrementRevision();
 
             if(constraintType == QualitativeTimePointConstraint::Empty)
             {
@@ -4,6 +4,7 @@
 #include <set>
 #include "TemporalConstraintNetwork.hpp"
 #include "point_algebra/QualitativeTimePointConstraint.hpp"
+#include "point_algebra/QualitativeRelationMatrix.hpp"
 
 namespace templ {
 namespace solvers {
@@ -23,7 +24,7 @@ public:
     typedef shared_ptr<QualitativeTemporalConstraintNetwork> Ptr;
     typedef std::pair<graph_analysis::Vertex::Ptr, graph_analysis::Vertex::Ptr> VertexPair;
 
-    enum ValidationAlgorithm { TCN_GECODE, TCN_INCREMENTAL, TCN_BEEK_MANAK };
+    enum ValidationAlgorithm { TCN_GECODE, TCN_INCREMENTAL, TCN_BEEK_MANAK, TCN_MATRIX };
 
     /**
      * Constraint validation for a triangle relation
@@ -112,6 +113,22 @@ public:
     bool incrementalPathConsistency();
     bool pathConsistency_BeekManak();
 
+    /**
+     * Enforce path consistency on a dense relation matrix of this network
+     * The graph remains unchanged, use syncRelationMatrix to apply the
+     * resulting constraints to the graph
+     * \return true if the network is path consistent, false otherwise
+     */
+    bool pathConsistency_Matrix();
+
+    /**
+     * Apply the result of the last call of pathConsistency_Matrix to the
+     * graph, i.e. set the constraint between all pairs of timepoints
+     * which are not universally related
+     * \throw std::runtime_error if the relation matrix is not consistent
+     */
+    void syncRelationMatrix();
+
     point_algebra::QualitativeTimePointConstraint::Type composition(const graph_analysis::Vertex::Ptr& i, const graph_analysis::Vertex::Ptr& j, const graph_analysis::Vertex::Ptr& k);
 
     VertexPair revise(const graph_analysis::Vertex::Ptr& i, const graph_analysis::Vertex::Ptr& j, point_algebra::QualitativeTimePointConstraint::Type pathConstraintType);
@@ -148,7 +165,20 @@ private:
      */
     bool isConsistent(const std::vector<graph_analysis::Edge::Ptr>& edges);
 
+    /**
+     * Set the type of an existing constraint
+     * \details All in place changes of constraints have to use this
+     * function, so that the revision of the network is updated
+     */
+    void updateConstraintType(const point_algebra::QualitativeTimePointConstraint::Ptr& constraint,
+            point_algebra::QualitativeTimePointConstraint::Type type);
+
     std::set<VertexPair> mUpdatedConstraints;
+
+    /// Relation matrix and corresponding vertices of the last run of
+    /// pathConsistency_Matrix
+    point_algebra::QualitativeRelationMatrix mRelationMatrix;
+    std::vector<graph_analysis::Vertex::Ptr> mRelationMatrixVertices;
 };
 
 } // end namespace temporal
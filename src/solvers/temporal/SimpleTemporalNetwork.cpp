@@ -2,7 +2,6 @@
 #include <numeric/Combinatorics.hpp>
 #include <base-logging/Logging.hpp>
 #include <graph_analysis/WeightedEdge.hpp>
-#include <graph_analysis/algorithms/FloydWarshall.hpp>
 
 using namespace templ::solvers::temporal::point_algebra;
 using namespace graph_analysis;
@@ -13,6 +12,8 @@ namespace temporal {
 
 SimpleTemporalNetwork::SimpleTemporalNetwork()
     : TemporalConstraintNetwork()
+    , mConsistent(true)
+    , mDistanceMatrixRevision(getRevision())
 {
 }
 
@@ -24,6 +25,7 @@ void SimpleTemporalNetwork::addInterval(TimePoint::Ptr source, TimePoint::Ptr ta
     // B --- weight: - lower bound --> A
     // the lower bound will be added as negative cost
     using namespace graph_analysis;
+    bool updated = mDistanceMatrixRevision == getRevision();
     {
         WeightedEdge::Ptr edge(new WeightedEdge(bounds.getUpperBound()));
         edge->setSourceVertex(source);
@@ -37,6 +39,72 @@ void SimpleTemporalNetwork::addInterval(TimePoint::Ptr source, TimePoint::Ptr ta
         edge->setTargetVertex(source);
         mpDistanceGraph->addEdge(edge);
     }
+
+    incrementRevision();
+
+    if(!updated)
+    {
+        // distances will be recomputed on demand
+        return;
+    }
+    if(mConsistent && !mDistanceMatrix.addConstraint(source, target, bounds))
+    {
+        LOG_DEBUG_S << "Interval " << source->toString() << " -- " << target->toString() << " renders network inconsistent";
+        mConsistent = false;
+    }
+    mDistanceMatrixRevision = getRevision();
+}
+
+void SimpleTemporalNetwork::updateDistanceMatrix() const
+{
+    if(mDistanceMatrixRevision == getRevision())
+    {
+        return;
+    }
+
+    // Use all edges of the distance graph, interval constraints contribute
+    // the bounds of all their intervals (as in toWeightedGraph)
+    std::vector<IncrementalDistanceMatrix::DistanceConstraint> constraints;
+    EdgeIterator::Ptr edgeIt = mpDistanceGraph->getEdgeIterator();
+    while(edgeIt->next())
+    {
+        const Edge::Ptr& edge = edgeIt->current();
+        TimePoint::Ptr source = dynamic_pointer_cast<TimePoint>(edge->getSourceVertex());
+        TimePoint::Ptr target = dynamic_pointer_cast<TimePoint>(edge->getTargetVertex());
+
+        WeightedEdge::Ptr weightedEdge = dynamic_pointer_cast<WeightedEdge>(edge);
+        if(weightedEdge)
+        {
+            IncrementalDistanceMatrix::DistanceConstraint c;
+            c.source = source;
+            c.target = target;
+            c.distance = weightedEdge->getWeight();
+            constraints.push_back(c);
+            continue;
+        }
+
+        IntervalConstraint::Ptr intervalConstraint = dynamic_pointer_cast<IntervalConstraint>(edge);
+        if(intervalConstraint)
+        {
+            for(const Bounds& bounds : intervalConstraint->getIntervals())
+            {
+                IncrementalDistanceMatrix::DistanceConstraint forward;
+                forward.source = source;
+                forward.target = target;
+                forward.distance = bounds.getUpperBound();
+                constraints.push_back(forward);
+
+                IncrementalDistanceMatrix::DistanceConstraint backward;
+                backward.source = target;
+                backward.target = source;
+                backward.distance = -bounds.getLowerBound();
+                constraints.push_back(backward);
+            }
+        }
+    }
+
+    mConsistent = mDistanceMatrix.assign(constraints);
+    mDistanceMatrixRevision = getRevision();
 }
 
 bool SimpleTemporalNetwork::isConsistent()
@@ -44,23 +112,16 @@ bool SimpleTemporalNetwork::isConsistent()
     return !hasNegativeCycle();
 }
 
-bool SimpleTemporalNetwork::hasNegativeCycle()
+bool SimpleTemporalNetwork::isConsistent(const TimePoint::Ptr& source, const TimePoint::Ptr& target, const Bounds& bounds) const
 {
-    try {
-        // Throw when the shortest path computation identifies a negative cycle,
-        // i.e. an inconsistent network whose constraints can never be fulfilled
-        bool throwOnNegativeCycle = true;
-        algorithms::DistanceMatrix distanceMatrix = algorithms::FloydWarshall::allShortestPaths(mpDistanceGraph, [](Edge::Ptr e) -> double
-                {
-                    return dynamic_pointer_cast<WeightedEdge>(e)->getWeight();
-                }, throwOnNegativeCycle);
-
-        return false;
-    } catch(...)
-    {
-        return true;
-    }
+    updateDistanceMatrix();
+    return mConsistent && mDistanceMatrix.isConsistent(source, target, bounds);
+}
 
+bool SimpleTemporalNetwork::hasNegativeCycle()
+{
+    updateDistanceMatrix();
+    return !mConsistent;
 }
 
 graph_analysis::BaseGraph::Ptr SimpleTemporalNetwork::propagate()
@@ -3,6 +3,7 @@
 
 #include "Bounds.hpp"
 #include "TemporalConstraintNetwork.hpp"
+#include "IncrementalDistanceMatrix.hpp"
 
 namespace templ {
 namespace solvers {
@@ -12,6 +13,12 @@ namespace temporal {
  * \class SimpleTemporalNetwork
  * \brief A SimpleTemporalNetwork (STN) represents a set of
  * quantitative timepoint constraints given by a set of intervals
+ * \details The shortest path distances are maintained incrementally while
+ * intervals are added, so that consistency checks do not require a
+ * recomputation.
+ * Any other modification of the network, e.g. through
+ * addIntervalConstraint or minNetwork, changes the revision of the network
+ * and leads to a recomputation of the distances on the next query
  */
 class SimpleTemporalNetwork : public TemporalConstraintNetwork
 {
@@ -22,8 +29,21 @@ public:
 
     bool isConsistent();
 
+    /**
+     * Check if adding the interval would keep the network consistent (without
+     * adding it)
+     * \return true if the network is consistent and remains consistent, false
+     * otherwise
+     */
+    bool isConsistent(const point_algebra::TimePoint::Ptr& source, const point_algebra::TimePoint::Ptr& target, const Bounds& bounds) const;
+
     void addInterval(point_algebra::TimePoint::Ptr source, point_algebra::TimePoint::Ptr target, const Bounds& bound);
 
+    /**
+     * Get the shortest path distances of the network
+     */
+    const IncrementalDistanceMatrix& getDistanceMatrix() const { updateDistanceMatrix(); return mDistanceMatrix; }
+
     /** Propagate and check for consistency using FloydWarshall algorithm
      * \return the resulting distance graph
      */
@@ -36,6 +56,18 @@ protected:
      */
     bool hasNegativeCycle();
 
+private:
+    /**
+     * Recompute the distances from the distance graph, if the network has
+     * been modified other than by addInterval
+     */
+    void updateDistanceMatrix() const;
+
+    mutable IncrementalDistanceMatrix mDistanceMatrix;
+    /// Set to false once an inconsistent interval has been added
+    mutable bool mConsistent;
+    /// Revision of the network which the distances correspond to
+    mutable uint64_t mDistanceMatrixRevision;
 };
 
 } // end namespace temporal
@@ -9,6 +9,7 @@
 #include "point_algebra/TimePointComparator.hpp"
 #include "../csp/TemporalConstraintNetwork.hpp"
 #include "QualitativeTemporalConstraintNetwork.hpp"
+#include "IncrementalDistanceMatrix.hpp"
 
 using namespace templ::solvers::temporal::point_algebra;
 using namespace graph_analysis;
@@ -79,6 +80,7 @@ void TemporalConstraintNetwork::stpWithConjunctiveIntervals()
     }
     // update mpDistanceGraph with the one that we just created (tcn)
     mpDistanceGraph = tcn.mpDistanceGraph->copy();
+    incrementRevision();
 }
 
 // stp(N) is generated by upper-lower bounds of range on disjunctive intervals
@@ -119,6 +121,7 @@ void TemporalConstraintNetwork::stp()
     }
     // update mpDistanceGraph with the one that we just created (tcn)
     mpDistanceGraph = tcn.mpDistanceGraph->copy();
+    incrementRevision();
 }
 
 // the intersection between a temporal constraint network and a simple temporal constraint network
@@ -218,6 +221,7 @@ graph_analysis::BaseGraph::Ptr TemporalConstraintNetwork::intersection(graph_ana
         }
     }
     mpDistanceGraph = tcn.mpDistanceGraph->copy();
+    incrementRevision();
     // update mpDistanceGraph with the one that we just created (tcn)
     return mpDistanceGraph;
 }
@@ -267,10 +271,34 @@ void TemporalConstraintNetwork::minNetwork()
     BaseGraph::Ptr graph = (toWeightedGraph())->copy();
 
     BaseGraph::Ptr oldGraph = mpDistanceGraph->copy();
-    algorithms::DistanceMatrix distanceMatrix = algorithms::FloydWarshall::allShortestPaths(graph, [](Edge::Ptr e) -> double
-                {
-                    return dynamic_pointer_cast<WeightedEdge>(e)->getWeight();
-                });
+
+    // Compute all shortest paths in a single pass
+    std::vector<IncrementalDistanceMatrix::DistanceConstraint> distanceConstraints;
+    EdgeIterator::Ptr weightedEdgeIt = graph->getEdgeIterator();
+    while(weightedEdgeIt->next())
+    {
+        WeightedEdge::Ptr edge = dynamic_pointer_cast<WeightedEdge>(weightedEdgeIt->current());
+        IncrementalDistanceMatrix::DistanceConstraint c;
+        c.source = dynamic_pointer_cast<TimePoint>(edge->getSourceVertex());
+        c.target = dynamic_pointer_cast<TimePoint>(edge->getTargetVertex());
+        c.distance = edge->getWeight();
+        distanceConstraints.push_back(c);
+    }
+    IncrementalDistanceMatrix incrementalDistances;
+    bool consistent = incrementalDistances.assign(distanceConstraints);
+
+    algorithms::DistanceMatrix distanceMatrix;
+    if(!consistent)
+    {
+        // Distances are undefined in the presence of negative cycles, so
+        // retain the result of Floyd-Warshall for this case
+        LOG_WARN_S << "Computing minimal network for an inconsistent network";
+        distanceMatrix = algorithms::FloydWarshall::allShortestPaths(graph, [](Edge::Ptr e) -> double
+                    {
+                        return dynamic_pointer_cast<WeightedEdge>(e)->getWeight();
+                    });
+    }
+
     EdgeIterator::Ptr edgeIt = oldGraph->getEdgeIterator();
 
     // Change again the computed graph into a graph using Interval Constraint representation
@@ -281,8 +309,15 @@ void TemporalConstraintNetwork::minNetwork()
         v1 = edge->getSourceTimePoint();
         v2 = edge->getTargetTimePoint();
 
-        double distance12 = distanceMatrix[std::pair<TimePoint::Ptr, TimePoint::Ptr>(v1,v2)];
-        double distance21 = distanceMatrix[std::pair<TimePoint::Ptr, TimePoint::Ptr>(v2,v1)];
+        double distance12, distance21;
+        if(consistent)
+        {
+            distance12 = incrementalDistances.getDistance(v1,v2);
+            distance21 = incrementalDistances.getDistance(v2,v1);
+        } else {
+            distance12 = distanceMatrix[std::pair<TimePoint::Ptr, TimePoint::Ptr>(v1,v2)];
+            distance21 = distanceMatrix[std::pair<TimePoint::Ptr, TimePoint::Ptr>(v2,v1)];
+        }
         distance21 = (-1)*distance21;
         IntervalConstraint::Ptr i(new IntervalConstraint(v1, v2));
         i->addInterval(Bounds(distance21,distance12));
@@ -290,6 +325,7 @@ void TemporalConstraintNetwork::minNetwork()
     }
     // update mpDistanceGraph with the one that we just created (a simple temporal constraint network with the shortest paths computed)
     mpDistanceGraph = tcn.mpDistanceGraph->copy();
+    incrementRevision();
 }
 
 bool TemporalConstraintNetwork::equals(const graph_analysis::BaseGraph::Ptr& other)
@@ -384,6 +420,7 @@ void TemporalConstraintNetwork::upperLowerTightening()
         tcn.intersection(mpDistanceGraph);
         // newGraph becomes the resulted graph obtained from the intersection between the oldGraph and the minimal network
         mpDistanceGraph = tcn.mpDistanceGraph->copy();
+        incrementRevision();
     } while (!this->equals(oldGraph)); // until newGraph = oldGraph
 }
 
@@ -593,6 +630,7 @@ double TemporalConstraintNetwork::getTimeHorizon(const Assignment& assignments)
 
 void TemporalConstraintNetwork::addIntervalConstraint(const IntervalConstraint::Ptr& i)
 {
+    incrementRevision();
     if( !i->getSourceVertex()->associated( mpDistanceGraph->getId()) ||
             !i->getTargetVertex()->associated( mpDistanceGraph->getId()) )
     {
@@ -20,6 +20,7 @@ class TemporalConstraintNetwork : public ConstraintNetwork
 {
 protected:
     // graph to compute distance between vertices
+    // (modifications have to increment the revision of the network)
     graph_analysis::BaseGraph::Ptr mpDistanceGraph;
 
 public:
@@ -49,7 +50,7 @@ public:
     /**
      * Add a TimePoint to the internal (distance) graph
      */
-    void addTimePoint(const point_algebra::TimePoint::Ptr& t) { mpDistanceGraph->addVertex(t); }
+    void addTimePoint(const point_algebra::TimePoint::Ptr& t) { mpDistanceGraph->addVertex(t); incrementRevision(); }
 
     /**
      * Add interval, i.e., and edge between two TimePoints to the internal
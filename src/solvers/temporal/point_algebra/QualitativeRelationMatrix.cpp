@@ -0,0 +1,324 @@
+#include "QualitativeRelationMatrix.hpp"
+#include <stdexcept>
+#include <algorithm>
+
+namespace templ {
+namespace solvers {
+namespace temporal {
+namespace point_algebra {
+
+const QualitativeRelationMatrix::Relation QualitativeRelationMatrix::EMPTY;
+const QualitativeRelationMatrix::Relation QualitativeRelationMatrix::LESS;
+const QualitativeRelationMatrix::Relation QualitativeRelationMatrix::EQUAL;
+const QualitativeRelationMatrix::Relation QualitativeRelationMatrix::GREATER;
+const QualitativeRelationMatrix::Relation QualitativeRelationMatrix::UNIVERSAL;
+
+QualitativeRelationMatrix::QualitativeRelationMatrix(size_t size)
+    : mSize(0)
+    , mWordsPerRow(0)
+    , mLastWordMask(0)
+    , mInconsistent(false)
+{
+    reset(size);
+}
+
+void QualitativeRelationMatrix::reset(size_t size)
+{
+    mSize = size;
+    mWordsPerRow = (size + 63)/64;
+    mLastWordMask = (size % 64 == 0) ? ~0ULL : (1ULL << (size % 64)) - 1;
+
+    std::vector<uint64_t> row(mWordsPerRow, ~0ULL);
+    if(mWordsPerRow > 0)
+    {
+        row.back() = mLastWordMask;
+    }
+    mLess.resize(size*mWordsPerRow);
+    mEqual.resize(size*mWordsPerRow);
+    mGreater.resize(size*mWordsPerRow);
+    for(size_t i = 0; i < size; ++i)
+    {
+        std::copy(row.begin(), row.end(), mLess.begin() + i*mWordsPerRow);
+        std::copy(row.begin(), row.end(), mEqual.begin() + i*mWordsPerRow);
+        std::copy(row.begin(), row.end(), mGreater.begin() + i*mWordsPerRow);
+
+        // r(i,i) = EQUAL
+        size_t word = i*mWordsPerRow + i/64;
+        uint64_t bit = 1ULL << (i % 64);
+        mLess[word] &= ~bit;
+        mGreater[word] &= ~bit;
+    }
+    mQueue.clear();
+    mQueued.assign(size*size, false);
+    mInconsistent = false;
+}
+
+bool QualitativeRelationMatrix::constrain(size_t i, size_t j, Relation relation)
+{
+    if(i >= mSize || j >= mSize)
+    {
+        throw std::out_of_range("templ::solvers::temporal::point_algebra::QualitativeRelationMatrix::constrain: index out of range");
+    }
+
+    if(i == j)
+    {
+        if(!(relation & EQUAL))
+        {
+            mInconsistent = true;
+            return false;
+        }
+        return true;
+    }
+
+    Relation current = get(i,j);
+    Relation intersection = current & relation;
+    if(intersection != current)
+    {
+        set(i,j, intersection);
+    }
+    if(intersection == EMPTY)
+    {
+        mInconsistent = true;
+        return false;
+    }
+    return true;
+}
+
+bool QualitativeRelationMatrix::propagate()
+{
+    while(!mQueue.empty() && !mInconsistent)
+    {
+        std::pair<size_t, size_t> pair = mQueue.back();
+        mQueue.pop_back();
+        mQueued[pair.first*mSize + pair.second] = false;
+
+        if(!revise(pair.first, pair.second))
+        {
+            mInconsistent = true;
+        }
+    }
+    return !mInconsistent;
+}
+
+bool QualitativeRelationMatrix::pathConsistency()
+{
+    for(size_t i = 0; i < mSize; ++i)
+    {
+        for(size_t j = i + 1; j < mSize; ++j)
+        {
+            if(get(i,j) != UNIVERSAL)
+            {
+                enqueue(i,j);
+            }
+        }
+    }
+    return propagate();
+}
+
+void QualitativeRelationMatrix::set(size_t i, size_t j, Relation relation)
+{
+    Relation converseRelation = converse(relation);
+    size_t wordIJ = i*mWordsPerRow + j/64;
+    size_t wordJI = j*mWordsPerRow + i/64;
+    uint64_t bitJ = 1ULL << (j % 64);
+    uint64_t bitI = 1ULL << (i % 64);
+
+    mLess[wordIJ] = (relation & LESS) ? (mLess[wordIJ] | bitJ) : (mLess[wordIJ] & ~bitJ);
+    mEqual[wordIJ] = (relation & EQUAL) ? (mEqual[wordIJ] | bitJ) : (mEqual[wordIJ] & ~bitJ);
+    mGreater[wordIJ] = (relation & GREATER) ? (mGreater[wordIJ] | bitJ) : (mGreater[wordIJ] & ~bitJ);
+
+    mLess[wordJI] = (converseRelation & LESS) ? (mLess[wordJI] | bitI) : (mLess[wordJI] & ~bitI);
+    mEqual[wordJI] = (converseRelation & EQUAL) ? (mEqual[wordJI] | bitI) : (mEqual[wordJI] & ~bitI);
+    mGreater[wordJI] = (converseRelation & GREATER) ? (mGreater[wordJI] | bitI) : (mGreater[wordJI] & ~bitI);
+
+    enqueue(i,j);
+}
+
+void QualitativeRelationMatrix::enqueue(size_t i, size_t j)
+{
+    size_t a = std::min(i,j);
+    size_t b = std::max(i,j);
+    size_t idx = a*mSize + b;
+    if(!mQueued[idx])
+    {
+        mQueued[idx] = true;
+        mQueue.push_back(std::pair<size_t,size_t>(a,b));
+    }
+}
+
+bool QualitativeRelationMatrix::revise(size_t i, size_t j)
+{
+    // Since converse relations are maintained, revising the paths i-j-k and
+    // j-i-k covers all triangles containing the pair (i,j)
+    return reviseRow(i,j) && reviseRow(j,i);
+}
+
+bool QualitativeRelationMatrix::reviseRow(size_t i, size_t j)
+{
+    // Composition of a fixed relation a = r(i,j) with a row b = r(j,*) in terms
+    // of the primitives:
+    //   < in a o b  iff  (< in a and b not empty) or ((= or >) in a and < in b)
+    //   = in a o b  iff  (< in a and > in b) or (= in a and = in b) or (> in a and < in b)
+    //   > in a o b  iff  (> in a and b not empty) or ((< or =) in a and > in b)
+    // The entries k = i and k = j remain unchanged for a consistent r(i,j),
+    // since r(i,j) o r(j,i) contains = and r(i,j) o = = r(i,j)
+    Relation a = get(i,j);
+    if(a == EMPTY)
+    {
+        return false;
+    }
+    const uint64_t aLess = (a & LESS) ? ~0ULL : 0;
+    const uint64_t aEqual = (a & EQUAL) ? ~0ULL : 0;
+    const uint64_t aGreater = (a & GREATER) ? ~0ULL : 0;
+
+    uint64_t* lessI = &mLess[i*mWordsPerRow];
+    uint64_t* equalI = &mEqual[i*mWordsPerRow];
+    uint64_t* greaterI = &mGreater[i*mWordsPerRow];
+    const uint64_t* lessJ = &mLess[j*mWordsPerRow];
+    const uint64_t* equalJ = &mEqual[j*mWordsPerRow];
+    const uint64_t* greaterJ = &mGreater[j*mWordsPerRow];
+
+    for(size_t w = 0; w < mWordsPerRow; ++w)
+    {
+        uint64_t bLess = lessJ[w];
+        uint64_t bEqual = equalJ[w];
+        uint64_t bGreater = greaterJ[w];
+        uint64_t bAny = bLess | bEqual | bGreater;
+
+        uint64_t less = lessI[w] & ((aLess & bAny) | ((aEqual | aGreater) & bLess));
+        uint64_t equal = equalI[w] & ((aLess & bGreater) | (aEqual & bEqual) | (aGreater & bLess));
+        uint64_t greater = greaterI[w] & ((aGreater & bAny) | ((aLess | aEqual) & bGreater));
+
+        uint64_t changed = (lessI[w] ^ less) | (equalI[w] ^ equal) | (greaterI[w] ^ greater);
+        if(!changed)
+        {
+            continue;
+        }
+
+        uint64_t valid = (w + 1 == mWordsPerRow) ? mLastWordMask : ~0ULL;
+        if( ((less | equal | greater) & valid) != valid)
+        {
+            return false;
+        }
+
+        lessI[w] = less;
+        equalI[w] = equal;
+        greaterI[w] = greater;
+
+        // update the converse relations r(k,i) and enqueue the changed pairs
+        size_t wordI = i/64;
+        uint64_t bitI = 1ULL << (i % 64);
+        while(changed)
+        {
+            size_t bit = __builtin_ctzll(changed);
+            changed &= changed - 1;
+
+            size_t k = w*64 + bit;
+            size_t wordKI = k*mWordsPerRow + wordI;
+            uint64_t bitK = 1ULL << bit;
+
+            mLess[wordKI] = (greater & bitK) ? (mLess[wordKI] | bitI) : (mLess[wordKI] & ~bitI);
+            mEqual[wordKI] = (equal & bitK) ? (mEqual[wordKI] | bitI) : (mEqual[wordKI] & ~bitI);
+            mGreater[wordKI] = (less & bitK) ? (mGreater[wordKI] | bitI) : (mGreater[wordKI] & ~bitI);
+
+            enqueue(i,k);
+        }
+    }
+    return true;
+}
+
+QualitativeRelationMatrix::Relation QualitativeRelationMatrix::converse(Relation r)
+{
+    // swap < and >
+    return (r & EQUAL) | ((r & LESS) << 2) | ((r & GREATER) >> 2);
+}
+
+QualitativeRelationMatrix::CompositionTable::CompositionTable()
+{
+    // Composition of the primitives
+    //  o| < | = | >
+    //  <| < | < | P
+    //  =| < | = | >
+    //  >| P | > | >
+    const Relation primitives[3] = { LESS, EQUAL, GREATER };
+    const Relation primitiveComposition[3][3] = {
+        { LESS, LESS, UNIVERSAL },
+        { LESS, EQUAL, GREATER },
+        { UNIVERSAL, GREATER, GREATER }
+    };
+
+    for(Relation a = 0; a < 8; ++a)
+    {
+        for(Relation b = 0; b < 8; ++b)
+        {
+            Relation result = EMPTY;
+            for(size_t p = 0; p < 3; ++p)
+            {
+                if(!(a & primitives[p]))
+                {
+                    continue;
+                }
+                for(size_t q = 0; q < 3; ++q)
+                {
+                    if(b & primitives[q])
+                    {
+                        result |= primitiveComposition[p][q];
+                    }
+                }
+            }
+            relations[a][b] = result;
+        }
+    }
+}
+
+const QualitativeRelationMatrix::CompositionTable& QualitativeRelationMatrix::getCompositionTable()
+{
+    static const CompositionTable table;
+    return table;
+}
+
+QualitativeRelationMatrix::Relation QualitativeRelationMatrix::toRelation(QualitativeTimePointConstraint::Type type)
+{
+    switch(type)
+    {
+        case QualitativeTimePointConstraint::Empty:
+            return EMPTY;
+        case QualitativeTimePointConstraint::Greater:
+            return GREATER;
+        case QualitativeTimePointConstraint::Less:
+            return LESS;
+        case QualitativeTimePointConstraint::Equal:
+            return EQUAL;
+        case QualitativeTimePointConstraint::Distinct:
+            return LESS | GREATER;
+        case QualitativeTimePointConstraint::GreaterOrEqual:
+            return GREATER | EQUAL;
+        case QualitativeTimePointConstraint::LessOrEqual:
+            return LESS | EQUAL;
+        case QualitativeTimePointConstraint::Universal:
+            return UNIVERSAL;
+        default:
+            break;
+    }
+    throw std::invalid_argument("templ::solvers::temporal::point_algebra::QualitativeRelationMatrix::toRelation: unknown constraint type");
+}
+
+QualitativeTimePointConstraint::Type QualitativeRelationMatrix::toType(Relation relation)
+{
+    static const QualitativeTimePointConstraint::Type types[8] = {
+        QualitativeTimePointConstraint::Empty,          // {}
+        QualitativeTimePointConstraint::Less,           // {<}
+        QualitativeTimePointConstraint::Equal,          // {=}
+        QualitativeTimePointConstraint::LessOrEqual,    // {<,=}
+        QualitativeTimePointConstraint::Greater,        // {>}
+        QualitativeTimePointConstraint::Distinct,       // {<,>}
+        QualitativeTimePointConstraint::GreaterOrEqual, // {=,>}
+        QualitativeTimePointConstraint::Universal       // {<,=,>}
+    };
+    return types[relation & UNIVERSAL];
+}
+
+} // end namespace point_algebra
+} // end namespace temporal
+} // end namespace solvers
+} // end namespace templ
@@ -0,0 +1,158 @@
+#ifndef TEMPL_SOLVERS_TEMPORAL_POINT_ALGEBRA_QUALITATIVE_RELATION_MATRIX_HPP
+#define TEMPL_SOLVERS_TEMPORAL_POINT_ALGEBRA_QUALITATIVE_RELATION_MATRIX_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include "QualitativeTimePointConstraint.hpp"
+
+namespace templ {
+namespace solvers {
+namespace temporal {
+namespace point_algebra {
+
+/**
+ * \class QualitativeRelationMatrix
+ * \brief Dense representation of a point algebra network
+ * \details Each relation between two timepoints i and j is a 3 bit
+ * set of the primitive relations {<,=,>}, so that intersection is a bitwise
+ * and, and composition a table lookup.
+ * The matrix maintains the converse relation, i.e. r(j,i) = r(i,j)^-1
+ *
+ * Rows are stored as three bit planes (one per primitive relation), so that
+ * revising a row against a fixed relation r(i,j), i.e.
+ * r(i,k) = r(i,k) & r(i,j) o r(j,k) for all k, operates on 64 timepoints per
+ * word.
+ *
+ * Path consistency is enforced with PC-2, where only the pairs that changed
+ * since the last propagation are revised.
+ */
+class QualitativeRelationMatrix
+{
+public:
+    typedef uint8_t Relation;
+
+    static const Relation EMPTY = 0;
+    static const Relation LESS = 1;
+    static const Relation EQUAL = 2;
+    static const Relation GREATER = 4;
+    static const Relation UNIVERSAL = 7;
+
+    /**
+     * Create matrix for the given number of timepoints, where all
+     * relations are initialized to universal
+     */
+    QualitativeRelationMatrix(size_t size = 0);
+
+    /**
+     * Reset the matrix to the given number of timepoints, where all relations
+     * are initialized to universal
+     */
+    void reset(size_t size);
+
+    /**
+     * Get the number of timepoints
+     */
+    size_t size() const { return mSize; }
+
+    /**
+     * Get the relation between timepoint i and j
+     */
+    Relation get(size_t i, size_t j) const
+    {
+        size_t word = i*mWordsPerRow + j/64;
+        uint64_t bit = 1ULL << (j % 64);
+        return ((mLess[word] & bit) ? LESS : EMPTY)
+            | ((mEqual[word] & bit) ? EQUAL : EMPTY)
+            | ((mGreater[word] & bit) ? GREATER : EMPTY);
+    }
+
+    /**
+     * Intersect the relation between timepoint i and j with the given
+     * relation (and update the converse relation)
+     * Changed relations are revised with the next call of propagate
+     * \return false if the relation became empty, true otherwise
+     */
+    bool constrain(size_t i, size_t j, Relation relation);
+
+    /**
+     * Propagate all changes since the last propagation
+     * \return false if the network is inconsistent, true otherwise
+     */
+    bool propagate();
+
+    /**
+     * Enforce path consistency for the full network
+     * \return false if the network is inconsistent, true otherwise
+     */
+    bool pathConsistency();
+
+    /**
+     * Check if the network is known to be inconsistent
+     */
+    bool isInconsistent() const { return mInconsistent; }
+
+    static Relation compose(Relation a, Relation b) { return getCompositionTable().relations[a][b]; }
+    static Relation converse(Relation r);
+
+    /**
+     * Map a qualitative constraint type to the relation representation
+     */
+    static Relation toRelation(QualitativeTimePointConstraint::Type type);
+
+    /**
+     * Map a relation to the qualitative constraint type
+     */
+    static QualitativeTimePointConstraint::Type toType(Relation relation);
+
+private:
+    struct CompositionTable
+    {
+        CompositionTable();
+
+        Relation relations[8][8];
+    };
+    static const CompositionTable& getCompositionTable();
+
+    /**
+     * Set a relation (and its converse) and enqueue the pair for revision
+     */
+    void set(size_t i, size_t j, Relation relation);
+
+    /**
+     * Enqueue the pair (i,j) for revision
+     */
+    void enqueue(size_t i, size_t j);
+
+    /**
+     * Revise all triangles which contain the pair (i,j)
+     */
+    bool revise(size_t i, size_t j);
+
+    /**
+     * Revise row i, i.e. r(i,k) = r(i,k) & r(i,j) o r(j,k) for all k
+     * \return false if a relation became empty, true otherwise
+     */
+    bool reviseRow(size_t i, size_t j);
+
+    size_t mSize;
+    size_t mWordsPerRow;
+    /// Valid bits of the last word of a row
+    uint64_t mLastWordMask;
+
+    /// Bit planes of the primitive relations, row major
+    std::vector<uint64_t> mLess;
+    std::vector<uint64_t> mEqual;
+    std::vector<uint64_t> mGreater;
+
+    /// Pairs (i < j) which require revision
+    std::vector< std::pair<size_t, size_t> > mQueue;
+    std::vector<bool> mQueued;
+    bool mInconsistent;
+};
+
+} // end namespace point_algebra
+} // end namespace temporal
+} // end namespace solvers
+} // end namespace templ
+#endif // TEMPL_SOLVERS_TEMPORAL_POINT_ALGEBRA_QUALITATIVE_RELATION_MATRIX_HPP
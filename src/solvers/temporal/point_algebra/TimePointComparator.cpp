@@ -1,13 +1,153 @@
 #include "TimePointComparator.hpp"
 #include <base-logging/Logging.hpp>
 #include <algorithm>
+#include <mutex>
 #include "../Interval.hpp"
+#include "../QualitativeTemporalConstraintNetwork.hpp"
+#include "QualitativeRelationMatrix.hpp"
 
 namespace templ {
 namespace solvers {
 namespace temporal {
 namespace point_algebra {
 
+/**
+ * Path consistent relation matrix of a qualitative temporal constraint network
+ *
+ * The matrix is computed once per revision of the network: if constraints
+ * have only been added or tightened, the changes are propagated
+ * incrementally, otherwise the matrix is recomputed
+ */
+class TimePointComparator::QualitativeClosure
+{
+public:
+    typedef QualitativeRelationMatrix::Relation Relation;
+
+    QualitativeClosure(const QualitativeTemporalConstraintNetwork::Ptr& tcn)
+        : mpNetwork(tcn)
+        , mValid(false)
+        , mRevision(0)
+        , mConsistent(true)
+        , mHasDistinct(false)
+    {}
+
+    /**
+     * Lookup the relation between two timepoints
+     * \return false if the timepoints are not part of the network, true otherwise
+     */
+    bool getRelation(const TimePoint::Ptr& t0, const TimePoint::Ptr& t1, Relation& relation)
+    {
+        update();
+
+        std::map<const graph_analysis::Vertex*, size_t>::const_iterator it0 = mIndex.find(t0.get());
+        std::map<const graph_analysis::Vertex*, size_t>::const_iterator it1 = mIndex.find(t1.get());
+        if(it0 == mIndex.end() || it1 == mIndex.end())
+        {
+            return false;
+        }
+        relation = mConsistent ? mMatrix.get(it0->second, it1->second) : QualitativeRelationMatrix::EMPTY;
+        return true;
+    }
+
+    /**
+     * Path consistency yields the minimal network for the convex point
+     * algebra, i.e. without distinct constraints -- only then a relation
+     * entails that each of its primitives is consistent
+     */
+    bool isMinimal() const { return !mHasDistinct; }
+
+    std::mutex mutex;
+
+private:
+    typedef std::pair<graph_analysis::Edge::Ptr, Relation> Snapshot;
+    typedef std::map<const graph_analysis::Edge*, Snapshot> Constraints;
+
+    void update()
+    {
+        if(mValid && mRevision == mpNetwork->getRevision())
+        {
+            return;
+        }
+
+        graph_analysis::BaseGraph::Ptr graph = mpNetwork->getGraph();
+        std::vector<graph_analysis::Vertex::Ptr> vertices = graph->getAllVertices();
+
+        bool rebuild = !mValid || vertices.size() != mIndex.size();
+        for(size_t i = 0; !rebuild && i < vertices.size(); ++i)
+        {
+            rebuild = mIndex.count(vertices[i].get()) == 0;
+        }
+
+        Constraints constraints;
+        graph_analysis::EdgeIterator::Ptr edgeIt = graph->getEdgeIterator();
+        while(edgeIt->next())
+        {
+            QualitativeTimePointConstraint::Ptr constraint = dynamic_pointer_cast<QualitativeTimePointConstraint>(edgeIt->current());
+            if(constraint)
+            {
+                constraints[constraint.get()] = Snapshot(constraint, QualitativeRelationMatrix::toRelation(constraint->getType()));
+            }
+        }
+
+        // A removed or relaxed constraint requires recomputation
+        for(Constraints::const_iterator cit = mConstraints.begin(); !rebuild && cit != mConstraints.end(); ++cit)
+        {
+            Constraints::const_iterator it = constraints.find(cit->first);
+            rebuild = it == constraints.end() || (it->second.second & ~cit->second.second);
+        }
+
+        if(rebuild)
+        {
+            mIndex.clear();
+            mVertices = vertices;
+            for(size_t i = 0; i < vertices.size(); ++i)
+            {
+                mIndex[vertices[i].get()] = i;
+            }
+            mMatrix.reset(vertices.size());
+            mConstraints.clear();
+        }
+
+        mHasDistinct = false;
+        for(const Constraints::value_type& c : constraints)
+        {
+            Relation relation = c.second.second;
+            if(relation == (QualitativeRelationMatrix::LESS | QualitativeRelationMatrix::GREATER))
+            {
+                mHasDistinct = true;
+            }
+
+            Constraints::const_iterator it = mConstraints.find(c.first);
+            if(it != mConstraints.end() && it->second.second == relation)
+            {
+                continue;
+            }
+            const graph_analysis::Edge::Ptr& edge = c.second.first;
+            mMatrix.constrain(mIndex[edge->getSourceVertex().get()],
+                    mIndex[edge->getTargetVertex().get()],
+                    relation);
+        }
+
+        mConsistent = rebuild ? mMatrix.pathConsistency() : mMatrix.propagate();
+        mConstraints.swap(constraints);
+        mRevision = mpNetwork->getRevision();
+        mValid = true;
+    }
+
+    QualitativeTemporalConstraintNetwork::Ptr mpNetwork;
+
+    bool mValid;
+    uint64_t mRevision;
+    bool mConsistent;
+    bool mHasDistinct;
+
+    /// Vertices are kept, so that the index remains valid
+    std::vector<graph_analysis::Vertex::Ptr> mVertices;
+    std::map<const graph_analysis::Vertex*, size_t> mIndex;
+    Constraints mConstraints;
+    QualitativeRelationMatrix mMatrix;
+};
+
 TimePointComparator::TimePointComparator(const TemporalConstraintNetwork::Ptr& tcn)
     : mpTemporalConstraintNetwork(tcn)
 {
@@ -15,6 +155,12 @@ TimePointComparator::TimePointComparator(const TemporalConstraintNetwork::Ptr& t
     {
         throw std::invalid_argument("templ::solvers::temporal::point_algebra::TimePointComparator: given constraint network is not consistent -- cannot construct comparator");
     }
+
+    QualitativeTemporalConstraintNetwork::Ptr qtcn = dynamic_pointer_cast<QualitativeTemporalConstraintNetwork>(tcn);
+    if(qtcn)
+    {
+        mpQualitativeClosure = make_shared<QualitativeClosure>(qtcn);
+    }
 }
 
 void TimePointComparator::sort(std::vector<point_algebra::TimePoint::Ptr>& timepoints) const
@@ -66,28 +212,49 @@ bool TimePointComparator::greaterThan(const TimePoint::Ptr& t0, const TimePoint:
             throw std::runtime_error("templ::solvers::temporal::point_algebra::TimePointComparator::greaterThan: comparing qualitive timepoints, but not QualitativeTimePointConstraintNetwork given to comparator");
         }
 
-        graph_analysis::Edge::PtrList existingEdges = mpTemporalConstraintNetwork->getGraph()->getEdges(t0,t1);
-        QualitativeTimePointConstraint::Ptr constraint = mpTemporalConstraintNetwork->addQualitativeConstraint(t0, t1, point_algebra::QualitativeTimePointConstraint::Greater);
-        bool consistent = mpTemporalConstraintNetwork->isConsistent();
-
-        // Remove temporary addition
-        graph_analysis::Edge::PtrList tempEdges = mpTemporalConstraintNetwork->getGraph()->getEdges(t0,t1);
-        for(const graph_analysis::Edge::Ptr& e : tempEdges)
-        {
-            mpTemporalConstraintNetwork->getGraph()->removeEdge(e);
-        }
-
-        // Restore previous status
-        for(const graph_analysis::Edge::Ptr& e : existingEdges)
+        if(mpQualitativeClosure)
         {
-            mpTemporalConstraintNetwork->getGraph()->addEdge(e);
+            std::lock_guard<std::mutex> lock(mpQualitativeClosure->mutex);
+            QualitativeClosure::Relation relation;
+            if(mpQualitativeClosure->getRelation(t0, t1, relation))
+            {
+                if(!(relation & QualitativeRelationMatrix::GREATER))
+                {
+                    return false;
+                } else if(mpQualitativeClosure->isMinimal())
+                {
+                    return true;
+                }
+            }
         }
-        return consistent;
+        return isGreaterThanConsistent(t0, t1);
     } else {
         throw std::invalid_argument("templ::solvers::temporal::point_algebra::TimePointComparator::greaterThan: cannot compare this type of TimePoints");
     }
 }
 
+bool TimePointComparator::isGreaterThanConsistent(const TimePoint::Ptr& t0, const TimePoint::Ptr& t1) const
+{
+    graph_analysis::Edge::PtrList existingEdges = mpTemporalConstraintNetwork->getGraph()->getEdges(t0,t1);
+    QualitativeTimePointConstraint::Ptr constraint = mpTemporalConstraintNetwork->addQualitativeConstraint(t0, t1, point_algebra::QualitativeTimePointConstraint::Greater);
+    bool consistent = mpTemporalConstraintNetwork->isConsistent();
+
+    // Remove temporary addition (through the network interface, so that the
+    // revision of the network is updated)
+    graph_analysis::Edge::PtrList tempEdges = mpTemporalConstraintNetwork->getGraph()->getEdges(t0,t1);
+    for(const graph_analysis::Edge::Ptr& e : tempEdges)
+    {
+        mpTemporalConstraintNetwork->removeConstraint(dynamic_pointer_cast<Constraint>(e));
+    }
+
+    // Restore previous status
+    for(const graph_analysis::Edge::Ptr& e : existingEdges)
+    {
+        mpTemporalConstraintNetwork->addConstraint(dynamic_pointer_cast<Constraint>(e));
+    }
+    return consistent;
+}
+
 bool TimePointComparator::hasIntervalOverlap(const TimePoint::Ptr& a_start, const TimePoint::Ptr& a_end, const TimePoint::Ptr& b_start, const TimePoint::Ptr& b_end) const
 {
 //    if(TimePointComparator::inInterval(a_start, b_start, b_end))
@@ -22,6 +22,11 @@ class TimePointComparator
 {
     TemporalConstraintNetwork::Ptr mpTemporalConstraintNetwork;
 
+    class QualitativeClosure;
+    /// Path consistent relation matrix of a qualitative network, which is
+    /// shared between copies of this comparator
+    shared_ptr<QualitativeClosure> mpQualitativeClosure;
+
 public:
     /**
      * Default constructor
@@ -65,6 +70,13 @@ public:
     Interval getIntervalOverlap(const TimePoint::Ptr& a_start, const TimePoint::Ptr& a_end, const TimePoint::Ptr& b_start, const TimePoint::Ptr& b_end) const;
 
     bool inInterval(const TimePoint::Ptr& t0, const TimePoint::Ptr& i_start, const TimePoint::Ptr& i_end) const;
+
+private:
+    /**
+     * Check if t0 > t1 is consistent by temporarily adding the constraint to
+     * the network and performing a full consistency check
+     */
+    bool isGreaterThanConsistent(const TimePoint::Ptr& t0, const TimePoint::Ptr& t1) const;
 };
 
 } // end namespace point_algebra
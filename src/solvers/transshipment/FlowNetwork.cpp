@@ -5,6 +5,7 @@
 #include <graph_analysis/WeightedEdge.hpp>
 #include <base-logging/Logging.hpp>
 #include "../../utils/Logger.hpp"
+#include "../CoalitionFeasibilityCache.hpp"
 
 namespace pa = templ::solvers::temporal::point_algebra;
 namespace co = templ::symbols::constants;
@@ -175,7 +176,8 @@ transshipment::Flaw::List FlowNetwork::getInvalidTransitions(double feasibilityC
                 LOG_INFO_S << "Checking for infeasible coalition on transition:"
                     << pool.toString(4);
                 moreorg::ModelPool::List coalitionStructure =
-                    ask.findFeasibleCoalitionStructure(pool, mMoveToResource, feasibilityCheckTimeoutInMs);
+                    CoalitionFeasibilityCache::getInstance().findFeasibleCoalitionStructure(ask,
+                            pool, mMoveToResource, feasibilityCheckTimeoutInMs);
                 if( coalitionStructure.empty() )
                 {
                     LOG_WARN_S << "Infeasible coalition detected for transition"
@@ -0,0 +1,493 @@
+#include "IncrementalFlowGraph.hpp"
+#include <cmath>
+#include <limits>
+#include <base-logging/Logging.hpp>
+
+using namespace graph_analysis;
+
+namespace templ {
+namespace solvers {
+namespace transshipment {
+
+IncrementalFlowGraph::IncrementalFlowGraph()
+    : mpProblem(glp_create_prob())
+    , mObjectiveValue(0)
+    , mNumberOfChanges(0)
+    , mNumberOfResets(0)
+{
+    reset();
+}
+
+IncrementalFlowGraph::~IncrementalFlowGraph()
+{
+    glp_delete_prob(mpProblem);
+}
+
+void IncrementalFlowGraph::reset()
+{
+    mpFlowGraph = BaseGraph::getInstance();
+    glp_erase_prob(mpProblem);
+    glp_set_obj_dir(mpProblem, GLP_MIN);
+    mObjectiveValue = 0;
+    mVertices.clear();
+    mEdges.clear();
+    mVertexStates.clear();
+    mEdgeStates.clear();
+}
+
+void IncrementalFlowGraph::beginUpdate(const std::vector<Role>& commodities,
+        const std::set<SpaceTime::Point>& points)
+{
+    if(commodities != mCommodities || points != mPoints)
+    {
+        LOG_DEBUG_S << "Commodities or space time points changed -- rebuilding flow graph";
+        reset();
+        mCommodities = commodities;
+        mPoints = points;
+        mpValidator = make_shared<algorithms::MultiCommodityMinCostFlow>(mpFlowGraph,
+                mCommodities.size(),
+                algorithms::LPSolver::GLPK_SOLVER);
+        ++mNumberOfResets;
+    }
+
+    mNumberOfChanges = 0;
+    for(std::pair<const edge_t* const, EdgeState>& p : mEdgeStates)
+    {
+        p.second.active = false;
+    }
+    for(std::pair<const vertex_t* const, VertexState>& p : mVertexStates)
+    {
+        VertexState& state = p.second;
+        state.touchedSupplies.assign(mCommodities.size(), false);
+        state.touchedMinTransFlows.assign(mCommodities.size(), false);
+    }
+}
+
+void IncrementalFlowGraph::endUpdate()
+{
+    for(std::pair<const edge_t* const, EdgeState>& p : mEdgeStates)
+    {
+        EdgeState& state = p.second;
+        if(state.active)
+        {
+            continue;
+        }
+
+        // Disable the edge instead of removing it
+        if(update(state.capacityUpperBound, 0u))
+        {
+            state.edge->setCapacityUpperBound(0);
+            applyCapacityUpperBound(state);
+        }
+        for(size_t i = 0; i < mCommodities.size(); ++i)
+        {
+            if(update(state.commodityCapacityUpperBounds[i], 0u))
+            {
+                state.edge->setCommodityCapacityUpperBound(i, 0);
+                applyCommodityCapacityUpperBound(state, i);
+            }
+        }
+    }
+
+    for(std::pair<const vertex_t* const, VertexState>& p : mVertexStates)
+    {
+        VertexState& state = p.second;
+        for(size_t i = 0; i < mCommodities.size(); ++i)
+        {
+            if(!state.touchedSupplies[i] && update(state.supplies[i], 0))
+            {
+                state.vertex->setCommoditySupply(i, 0);
+                applyCommoditySupply(state, i);
+            }
+            if(!state.touchedMinTransFlows[i] && update(state.minTransFlows[i], 0u))
+            {
+                state.vertex->setCommodityMinTransFlow(i, 0);
+                applyCommodityMinTransFlow(state, i);
+            }
+        }
+    }
+    LOG_DEBUG_S << "Incremental flow graph update: " << mNumberOfChanges << " changes";
+}
+
+IncrementalFlowGraph::vertex_t::Ptr IncrementalFlowGraph::getVertex(const SpaceTime::Point& point, const std::string& label)
+{
+    std::map<SpaceTime::Point, vertex_t::Ptr>::const_iterator cit = mVertices.find(point);
+    if(cit != mVertices.end())
+    {
+        return cit->second;
+    }
+
+    uint32_t commodities = mCommodities.size();
+    vertex_t::Ptr vertex = make_shared<vertex_t>(commodities);
+    vertex->setLabel(label);
+
+    VertexState state;
+    state.vertex = vertex;
+    state.row = 0;
+    state.supplies.assign(commodities, 0);
+    state.minTransFlows.assign(commodities, 0);
+    state.touchedSupplies.assign(commodities, false);
+    state.touchedMinTransFlows.assign(commodities, false);
+    for(size_t i = 0; i < commodities; ++i)
+    {
+        vertex->setCommoditySupply(i, 0);
+        vertex->setCommodityMinTransFlow(i, 0);
+    }
+
+    mVertexStates[vertex.get()] = state;
+    mVertices[point] = vertex;
+    return vertex;
+}
+
+IncrementalFlowGraph::edge_t::Ptr IncrementalFlowGraph::getEdge(const SpaceTime::Point& source, const SpaceTime::Point& target)
+{
+    std::pair<SpaceTime::Point, SpaceTime::Point> key(source, target);
+    std::map< std::pair<SpaceTime::Point, SpaceTime::Point>, edge_t::Ptr>::const_iterator cit = mEdges.find(key);
+    if(cit != mEdges.end())
+    {
+        getEdgeState(cit->second).active = true;
+        return cit->second;
+    }
+
+    std::map<SpaceTime::Point, vertex_t::Ptr>::const_iterator sourceIt = mVertices.find(source);
+    std::map<SpaceTime::Point, vertex_t::Ptr>::const_iterator targetIt = mVertices.find(target);
+    if(sourceIt == mVertices.end() || targetIt == mVertices.end())
+    {
+        throw std::invalid_argument("templ::solvers::transshipment::IncrementalFlowGraph::getEdge: "
+                "source or target vertex does not exist");
+    }
+
+    uint32_t commodities = mCommodities.size();
+    edge_t::Ptr edge = make_shared<edge_t>(commodities);
+    edge->setSourceVertex(sourceIt->second);
+    edge->setTargetVertex(targetIt->second);
+
+    EdgeState state;
+    state.edge = edge;
+    state.row = 0;
+    state.column = 0;
+    state.active = true;
+    state.capacityUpperBound = 0;
+    state.commodityCapacityUpperBounds.assign(commodities, 0);
+    // costs will be applied with the first set
+    state.commodityCosts.assign(commodities, std::numeric_limits<double>::quiet_NaN());
+    edge->setCapacityUpperBound(0);
+    for(size_t i = 0; i < commodities; ++i)
+    {
+        edge->setCommodityCapacityUpperBound(i, 0);
+    }
+
+    mpFlowGraph->addEdge(edge);
+    mEdgeStates[edge.get()] = state;
+    mEdges[key] = edge;
+    return edge;
+}
+
+void IncrementalFlowGraph::setCapacityUpperBound(const edge_t::Ptr& edge, uint32_t bound)
+{
+    EdgeState& state = getEdgeState(edge);
+    if(update(state.capacityUpperBound, bound))
+    {
+        edge->setCapacityUpperBound(bound);
+        applyCapacityUpperBound(state);
+    }
+}
+
+void IncrementalFlowGraph::setCommodityCapacityUpperBound(const edge_t::Ptr& edge, uint32_t commodity, uint32_t bound)
+{
+    EdgeState& state = getEdgeState(edge);
+    if(update(state.commodityCapacityUpperBounds.at(commodity), bound))
+    {
+        edge->setCommodityCapacityUpperBound(commodity, bound);
+        applyCommodityCapacityUpperBound(state, commodity);
+    }
+}
+
+void IncrementalFlowGraph::setCommodityCost(const edge_t::Ptr& edge, uint32_t commodity, double cost)
+{
+    EdgeState& state = getEdgeState(edge);
+    if(update(state.commodityCosts.at(commodity), cost))
+    {
+        edge->setCommodityCost(commodity, cost);
+        applyCommodityCost(state, commodity);
+    }
+}
+
+void IncrementalFlowGraph::setCommoditySupply(const vertex_t::Ptr& vertex, uint32_t commodity, int32_t supply)
+{
+    VertexState& state = getVertexState(vertex);
+    state.touchedSupplies.at(commodity) = true;
+    if(update(state.supplies[commodity], supply))
+    {
+        vertex->setCommoditySupply(commodity, supply);
+        applyCommoditySupply(state, commodity);
+    }
+}
+
+void IncrementalFlowGraph::setCommodityMinTransFlow(const vertex_t::Ptr& vertex, uint32_t commodity, uint32_t minTransFlow)
+{
+    VertexState& state = getVertexState(vertex);
+    state.touchedMinTransFlows.at(commodity) = true;
+    if(update(state.minTransFlows[commodity], minTransFlow))
+    {
+        vertex->setCommodityMinTransFlow(commodity, minTransFlow);
+        applyCommodityMinTransFlow(state, commodity);
+    }
+}
+
+uint32_t IncrementalFlowGraph::getCommodityMinTransFlow(const vertex_t::Ptr& vertex, uint32_t commodity)
+{
+    VertexState& state = getVertexState(vertex);
+    if(state.touchedMinTransFlows.at(commodity))
+    {
+        return state.minTransFlows[commodity];
+    }
+    return 0;
+}
+
+algorithms::LPSolver::Status IncrementalFlowGraph::solve()
+{
+    using namespace graph_analysis::algorithms;
+
+    extendProblem();
+
+    // The basis of the previous run remains valid: new rows are added with
+    // a basic auxiliary variable, new columns as non-basic, so that the
+    // simplex continues from there -- the presolver would discard the basis
+    glp_smcp simplexParameters;
+    glp_init_smcp(&simplexParameters);
+    simplexParameters.msg_lev = GLP_MSG_OFF;
+    simplexParameters.presolve = GLP_OFF;
+    if(glp_simplex(mpProblem, &simplexParameters) == GLP_EBADB
+            || glp_get_status(mpProblem) == GLP_UNDEF)
+    {
+        LOG_DEBUG_S << "Invalid basis -- restarting from the standard basis";
+        glp_std_basis(mpProblem);
+        glp_simplex(mpProblem, &simplexParameters);
+    }
+
+    LPSolver::Status status = LPSolver::STATUS_UNKNOWN;
+    switch(glp_get_status(mpProblem))
+    {
+        case GLP_OPT:
+        {
+            glp_iocp integerParameters;
+            glp_init_iocp(&integerParameters);
+            integerParameters.msg_lev = GLP_MSG_OFF;
+            integerParameters.presolve = GLP_OFF;
+            if(glp_intopt(mpProblem, &integerParameters) == 0)
+            {
+                switch(glp_mip_status(mpProblem))
+                {
+                    case GLP_OPT:
+                        status = LPSolver::STATUS_OPTIMAL;
+                        break;
+                    case GLP_FEAS:
+                        status = LPSolver::SOLUTION_FOUND;
+                        break;
+                    case GLP_NOFEAS:
+                        status = LPSolver::STATUS_INFEASIBLE;
+                        break;
+                    default:
+                        break;
+                }
+            }
+            break;
+        }
+        case GLP_NOFEAS:
+        case GLP_INFEAS:
+            status = LPSolver::STATUS_INFEASIBLE;
+            break;
+        case GLP_UNBND:
+            status = LPSolver::STATUS_UNBOUNDED;
+            break;
+        default:
+            break;
+    }
+
+    bool hasSolution = (status == LPSolver::STATUS_OPTIMAL || status == LPSolver::SOLUTION_FOUND);
+    mObjectiveValue = hasSolution ? glp_mip_obj_val(mpProblem) : 0;
+    for(std::pair<const edge_t* const, EdgeState>& p : mEdgeStates)
+    {
+        EdgeState& state = p.second;
+        for(size_t i = 0; i < mCommodities.size(); ++i)
+        {
+            uint32_t flow = 0;
+            if(hasSolution)
+            {
+                flow = static_cast<uint32_t>(std::lround(glp_mip_col_val(mpProblem, state.column + i)));
+            }
+            state.edge->setCommodityFlow(i, flow);
+        }
+    }
+    LOG_DEBUG_S << "Incremental flow graph solved: status " << static_cast<int>(status)
+        << ", cost " << mObjectiveValue;
+    return status;
+}
+
+void IncrementalFlowGraph::extendProblem()
+{
+    int commodities = static_cast<int>(mCommodities.size());
+
+    // Vertices: flow conservation (out - in = supply) and minimum transflow
+    // (in >= min transflow) per commodity
+    for(std::pair<const vertex_t* const, VertexState>& p : mVertexStates)
+    {
+        VertexState& state = p.second;
+        if(state.row != 0 || commodities == 0)
+        {
+            continue;
+        }
+        state.row = glp_add_rows(mpProblem, 2*commodities);
+        for(int i = 0; i < commodities; ++i)
+        {
+            applyCommoditySupply(state, i);
+            applyCommodityMinTransFlow(state, i);
+        }
+    }
+
+    // Edges: joint capacity row and one integer column per commodity
+    for(std::pair<const edge_t* const, EdgeState>& p : mEdgeStates)
+    {
+        EdgeState& state = p.second;
+        if(state.row != 0 || commodities == 0)
+        {
+            continue;
+        }
+        state.row = glp_add_rows(mpProblem, 1);
+        state.column = glp_add_cols(mpProblem, commodities);
+
+        const VertexState& source = getVertexState(dynamic_pointer_cast<vertex_t>(state.edge->getSourceVertex()));
+        const VertexState& target = getVertexState(dynamic_pointer_cast<vertex_t>(state.edge->getTargetVertex()));
+        for(int i = 0; i < commodities; ++i)
+        {
+            int column = state.column + i;
+            // GLPK arrays are 1-based
+            int indices[5] = { 0, state.row, source.row + i, target.row + i, target.row + commodities + i };
+            double values[5] = { 0, 1.0, 1.0, -1.0, 1.0 };
+            glp_set_mat_col(mpProblem, column, 4, indices, values);
+            glp_set_col_kind(mpProblem, column, GLP_IV);
+
+            applyCommodityCapacityUpperBound(state, i);
+            applyCommodityCost(state, i);
+        }
+        applyCapacityUpperBound(state);
+    }
+}
+
+void IncrementalFlowGraph::applyCapacityUpperBound(const EdgeState& state)
+{
+    if(state.row == 0)
+    {
+        return;
+    }
+    if(state.capacityUpperBound == std::numeric_limits<uint32_t>::max())
+    {
+        glp_set_row_bnds(mpProblem, state.row, GLP_FR, 0, 0);
+    } else {
+        glp_set_row_bnds(mpProblem, state.row, GLP_UP, 0, state.capacityUpperBound);
+    }
+}
+
+void IncrementalFlowGraph::applyCommodityCapacityUpperBound(const EdgeState& state, uint32_t commodity)
+{
+    if(state.column == 0)
+    {
+        return;
+    }
+    int column = state.column + commodity;
+    uint32_t bound = state.commodityCapacityUpperBounds[commodity];
+    if(bound == std::numeric_limits<uint32_t>::max())
+    {
+        glp_set_col_bnds(mpProblem, column, GLP_LO, 0, 0);
+    } else if(bound == 0)
+    {
+        glp_set_col_bnds(mpProblem, column, GLP_FX, 0, 0);
+    } else {
+        glp_set_col_bnds(mpProblem, column, GLP_DB, 0, bound);
+    }
+}
+
+void IncrementalFlowGraph::applyCommodityCost(const EdgeState& state, uint32_t commodity)
+{
+    if(state.column == 0)
+    {
+        return;
+    }
+    // Costs which have not been set explicitly are taken from the edge
+    double cost = state.commodityCosts[commodity];
+    if(std::isnan(cost))
+    {
+        cost = state.edge->getCommodityCost(commodity);
+    }
+    glp_set_obj_coef(mpProblem, state.column + commodity, cost);
+}
+
+void IncrementalFlowGraph::applyCommoditySupply(const VertexState& state, uint32_t commodity)
+{
+    if(state.row == 0)
+    {
+        return;
+    }
+    double supply = state.supplies[commodity];
+    glp_set_row_bnds(mpProblem, state.row + commodity, GLP_FX, supply, supply);
+}
+
+void IncrementalFlowGraph::applyCommodityMinTransFlow(const VertexState& state, uint32_t commodity)
+{
+    if(state.row == 0)
+    {
+        return;
+    }
+    int row = state.row + mCommodities.size() + commodity;
+    uint32_t minTransFlow = state.minTransFlows[commodity];
+    if(minTransFlow == 0)
+    {
+        glp_set_row_bnds(mpProblem, row, GLP_FR, 0, 0);
+    } else {
+        glp_set_row_bnds(mpProblem, row, GLP_LO, minTransFlow, 0);
+    }
+}
+
+std::vector<algorithms::ConstraintViolation> IncrementalFlowGraph::validateInflow() const
+{
+    if(!mpValidator)
+    {
+        return std::vector<algorithms::ConstraintViolation>();
+    }
+    return mpValidator->validateInflow();
+}
+
+void IncrementalFlowGraph::save(const std::string& filename) const
+{
+    if(glp_write_lp(mpProblem, NULL, filename.c_str()) != 0)
+    {
+        LOG_WARN_S << "Saving LP to " << filename << " failed";
+    }
+}
+
+IncrementalFlowGraph::EdgeState& IncrementalFlowGraph::getEdgeState(const edge_t::Ptr& edge)
+{
+    std::map<const edge_t*, EdgeState>::iterator it = mEdgeStates.find(edge.get());
+    if(it == mEdgeStates.end())
+    {
+        throw std::invalid_argument("templ::solvers::transshipment::IncrementalFlowGraph::getEdgeState: "
+                "edge is not part of this flow graph");
+    }
+    return it->second;
+}
+
+IncrementalFlowGraph::VertexState& IncrementalFlowGraph::getVertexState(const vertex_t::Ptr& vertex)
+{
+    std::map<const vertex_t*, VertexState>::iterator it = mVertexStates.find(vertex.get());
+    if(it == mVertexStates.end())
+    {
+        throw std::invalid_argument("templ::solvers::transshipment::IncrementalFlowGraph::getVertexState: "
+                "vertex is not part of this flow graph");
+    }
+    return it->second;
+}
+
+} // end namespace transshipment
+} // end namespace solvers
+} // end namespace templ
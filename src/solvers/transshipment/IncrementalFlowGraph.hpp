@@ -0,0 +1,225 @@
+#ifndef TEMPL_SOLVERS_TRANSSHIPMENT_INCREMENTAL_FLOW_GRAPH_HPP
+#define TEMPL_SOLVERS_TRANSSHIPMENT_INCREMENTAL_FLOW_GRAPH_HPP
+
+#include <map>
+#include <set>
+#include <vector>
+#include <glpk.h>
+#include <graph_analysis/BaseGraph.hpp>
+#include <graph_analysis/algorithms/MultiCommodityMinCostFlow.hpp>
+#include <graph_analysis/algorithms/LPSolver.hpp>
+#include "../../SharedPtr.hpp"
+#include "../../SpaceTime.hpp"
+
+namespace templ {
+namespace solvers {
+namespace transshipment {
+
+/**
+ * \class IncrementalFlowGraph
+ * \details Persistent multi-commodity flow graph, which is kept alive across
+ * consecutive min cost flow optimizations
+ *
+ * Consecutive search nodes typically differ only in a few timeline edges.
+ * Vertices and edges of the flow graph are identified by their space time
+ * points, so that they can be reused and only the changed capacity bounds,
+ * costs and commodity supplies have to be applied.
+ * Edges which are not part of the current space time network are not
+ * removed, but disabled by a capacity bound of 0, so that the structure of
+ * the flow graph (and thus of the resulting LP) remains stable.
+ *
+ * An update is enclosed by beginUpdate and endUpdate: all values which have
+ * not been set in between are reset to their neutral value in endUpdate
+ *
+ * The corresponding (integer) LP is kept alive as well: new vertices and
+ * edges add rows and columns, changed values modify bounds and objective
+ * coefficients in place, so that solve() restarts the simplex from the basis
+ * of the previous run. The LP is solved with GLPK, hence MinCostFlow
+ * accepts an incremental flow graph only for the GLPK solver type.
+ *
+ * An instance must not be shared between threads (see
+ * csp::Context::acquireIncrementalFlowGraph)
+ */
+class IncrementalFlowGraph
+{
+public:
+    typedef shared_ptr<IncrementalFlowGraph> Ptr;
+
+    typedef graph_analysis::algorithms::MultiCommodityMinCostFlow::vertex_t vertex_t;
+    typedef graph_analysis::algorithms::MultiCommodityMinCostFlow::edge_t edge_t;
+
+    IncrementalFlowGraph();
+    ~IncrementalFlowGraph();
+
+    IncrementalFlowGraph(const IncrementalFlowGraph&) = delete;
+    IncrementalFlowGraph& operator=(const IncrementalFlowGraph&) = delete;
+
+    /**
+     * Start an update of the flow graph
+     * The graph is reset (and thus rebuilt), when the commodities or
+     * the set of space time points differ from the previous update
+     * \param commodities Roles which correspond to the commodities
+     * \param points All space time points of the current network
+     */
+    void beginUpdate(const std::vector<Role>& commodities,
+            const std::set<SpaceTime::Point>& points);
+
+    /**
+     * Finalize the update, i.e. disable all edges and reset all supplies and
+     * minimum transflows which have not been set since beginUpdate
+     */
+    void endUpdate();
+
+    /**
+     * Get the vertex corresponding to a space time point (or create it if it
+     * does not exist yet)
+     */
+    vertex_t::Ptr getVertex(const SpaceTime::Point& point, const std::string& label);
+
+    /**
+     * Get the edge between two space time points (or create it if it does not
+     * exist yet)
+     * The edge will be marked as active for this update
+     */
+    edge_t::Ptr getEdge(const SpaceTime::Point& source, const SpaceTime::Point& target);
+
+    void setCapacityUpperBound(const edge_t::Ptr& edge, uint32_t bound);
+    void setCommodityCapacityUpperBound(const edge_t::Ptr& edge, uint32_t commodity, uint32_t bound);
+    void setCommodityCost(const edge_t::Ptr& edge, uint32_t commodity, double cost);
+
+    void setCommoditySupply(const vertex_t::Ptr& vertex, uint32_t commodity, int32_t supply);
+    void setCommodityMinTransFlow(const vertex_t::Ptr& vertex, uint32_t commodity, uint32_t minTransFlow);
+
+    /**
+     * Get the minimum transflow of a vertex as set since beginUpdate
+     * \return minimum transflow, or 0 if it has not been set in this update
+     */
+    uint32_t getCommodityMinTransFlow(const vertex_t::Ptr& vertex, uint32_t commodity);
+
+    /**
+     * Solve the multi-commodity min cost flow problem for the current flow
+     * graph, starting from the basis of the previous solve
+     * The resulting commodity flows are set on the edges of the flow graph
+     * (0 if no solution has been found)
+     * \return status of the optimization
+     */
+    graph_analysis::algorithms::LPSolver::Status solve();
+
+    /**
+     * Get the objective value, i.e. the cost of the flow found by the last
+     * solve
+     */
+    double getObjectiveValue() const { return mObjectiveValue; }
+
+    /**
+     * Validate the flow found by the last solve, i.e. identify vertices where
+     * supply, demand or minimum transflow are not met
+     * \return list of constraint violations
+     */
+    std::vector<graph_analysis::algorithms::ConstraintViolation> validateInflow() const;
+
+    /**
+     * Write the current LP to file (CPLEX LP format)
+     */
+    void save(const std::string& filename) const;
+
+    /**
+     * Get the current flow graph
+     */
+    const graph_analysis::BaseGraph::Ptr& getGraph() const { return mpFlowGraph; }
+
+    /**
+     * Get the number of values that have been changed during the last update,
+     * i.e. in comparison to the previous update
+     */
+    size_t getNumberOfChanges() const { return mNumberOfChanges; }
+
+    /**
+     * Get the number of times the flow graph had to be rebuilt from scratch
+     */
+    size_t getNumberOfResets() const { return mNumberOfResets; }
+
+private:
+    void reset();
+
+    struct EdgeState
+    {
+        edge_t::Ptr edge;
+        /// Row of the (joint) capacity constraint, 0 if not yet part of the LP
+        int row;
+        /// Column of the first commodity, the commodities are consecutive
+        int column;
+        bool active;
+        uint32_t capacityUpperBound;
+        std::vector<uint32_t> commodityCapacityUpperBounds;
+        std::vector<double> commodityCosts;
+    };
+
+    struct VertexState
+    {
+        vertex_t::Ptr vertex;
+        /// Row of the flow conservation constraint of the first commodity,
+        /// followed by the conservation and then the minimum transflow
+        /// constraints of all commodities; 0 if not yet part of the LP
+        int row;
+        std::vector<int32_t> supplies;
+        std::vector<uint32_t> minTransFlows;
+        std::vector<bool> touchedSupplies;
+        std::vector<bool> touchedMinTransFlows;
+    };
+
+    EdgeState& getEdgeState(const edge_t::Ptr& edge);
+    VertexState& getVertexState(const vertex_t::Ptr& vertex);
+
+    /**
+     * Add rows and columns for all vertices and edges which are not yet part
+     * of the LP
+     */
+    void extendProblem();
+
+    void applyCapacityUpperBound(const EdgeState& state);
+    void applyCommodityCapacityUpperBound(const EdgeState& state, uint32_t commodity);
+    void applyCommodityCost(const EdgeState& state, uint32_t commodity);
+    void applyCommoditySupply(const VertexState& state, uint32_t commodity);
+    void applyCommodityMinTransFlow(const VertexState& state, uint32_t commodity);
+
+    /**
+     * Update a recorded value
+     * \return true if the value changed, false otherwise
+     */
+    template<typename T>
+    bool update(T& current, const T& value)
+    {
+        if(current != value)
+        {
+            current = value;
+            ++mNumberOfChanges;
+            return true;
+        }
+        return false;
+    }
+
+    graph_analysis::BaseGraph::Ptr mpFlowGraph;
+    /// Validates the flow on the current flow graph (recreated with the
+    /// flow graph, and not used for optimization)
+    shared_ptr<graph_analysis::algorithms::MultiCommodityMinCostFlow> mpValidator;
+    glp_prob* mpProblem;
+    double mObjectiveValue;
+
+    std::vector<Role> mCommodities;
+    std::set<SpaceTime::Point> mPoints;
+
+    std::map<SpaceTime::Point, vertex_t::Ptr> mVertices;
+    std::map< std::pair<SpaceTime::Point, SpaceTime::Point>, edge_t::Ptr> mEdges;
+
+    std::map<const edge_t*, EdgeState> mEdgeStates;
+    std::map<const vertex_t*, VertexState> mVertexStates;
+
+    size_t mNumberOfChanges;
+    size_t mNumberOfResets;
+};
+
+} // end namespace transshipment
+} // end namespace solvers
+} // end namespace templ
+#endif // TEMPL_SOLVERS_TRANSSHIPMENT_INCREMENTAL_FLOW_GRAPH_HPP
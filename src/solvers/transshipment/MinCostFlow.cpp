@@ -40,6 +40,7 @@ MinCostFlow::MinCostFlow(
     , mSpaceTimeNetwork(mFlowNetwork.getSpaceTimeNetwork())
     , mSolverType(solverType)
     , mFeasibilityTimeoutInMs(feasibilityTimeoutInMs)
+    , mWriteArtifacts(true)
 {
     // Create virtual start and end depot vertices and connect them with the
     // current start and end vertices
@@ -75,6 +76,16 @@ MinCostFlow::MinCostFlow(
     mInitialSetupCost = std::vector<double>(mCommoditiesRoles.size(), 1.0);
 }
 
+void MinCostFlow::setIncrementalFlowGraph(const IncrementalFlowGraph::Ptr& flowGraph)
+{
+    if(flowGraph && mSolverType != LPSolver::GLPK_SOLVER)
+    {
+        throw std::invalid_argument("templ::solvers::transshipment::MinCostFlow::setIncrementalFlowGraph:"
+                " incremental flow graph requires the solver type GLPK_SOLVER");
+    }
+    mpIncrementalFlowGraph = flowGraph;
+}
+
 BaseGraph::Ptr MinCostFlow::createFlowGraph(uint32_t commodities)
 {
     BaseGraph::Ptr flowGraph = BaseGraph::getInstance();
@@ -141,6 +152,71 @@ BaseGraph::Ptr MinCostFlow::createFlowGraph(uint32_t commodities)
     return flowGraph;
 }
 
+BaseGraph::Ptr MinCostFlow::updateFlowGraph(uint32_t commodities)
+{
+    assert(mpIncrementalFlowGraph);
+
+    std::set<SpaceTime::Point> points;
+    VertexIterator::Ptr vertexIt = mSpaceTimeNetwork.getGraph()->getVertexIterator();
+    while(vertexIt->next())
+    {
+        SpaceTime::Network::tuple_t::Ptr tuple = dynamic_pointer_cast<SpaceTime::Network::tuple_t>(vertexIt->current());
+        points.insert(tuple->getPair());
+    }
+    mpIncrementalFlowGraph->beginUpdate(mCommoditiesRoles, points);
+
+    vertexIt = mSpaceTimeNetwork.getGraph()->getVertexIterator();
+    while(vertexIt->next())
+    {
+        SpaceTime::Network::tuple_t::Ptr tuple = dynamic_pointer_cast<SpaceTime::Network::tuple_t>(vertexIt->current());
+        MultiCommodityMinCostFlow::vertex_t::Ptr multicommodityVertex =
+            mpIncrementalFlowGraph->getVertex(tuple->getPair(), tuple->toString());
+        mBipartiteGraph.linkVertices(multicommodityVertex, tuple);
+    }
+
+    EdgeIterator::Ptr edgeIt = mSpaceTimeNetwork.getGraph()->getEdgeIterator();
+    while(edgeIt->next())
+    {
+        WeightedEdge::Ptr edge = dynamic_pointer_cast<WeightedEdge>(edgeIt->current());
+
+        SpaceTime::Network::tuple_t::Ptr source = dynamic_pointer_cast<SpaceTime::Network::tuple_t>(edge->getSourceVertex());
+        SpaceTime::Network::tuple_t::Ptr target = dynamic_pointer_cast<SpaceTime::Network::tuple_t>(edge->getTargetVertex());
+
+        bool isHorizonStart = (source == SpaceTime::getHorizonStartTuple());
+        bool isHorizonEnd = (target == SpaceTime::getHorizonEndTuple());
+
+        MultiCommodityMinCostFlow::edge_t::Ptr multicommodityEdge =
+            mpIncrementalFlowGraph->getEdge(source->getPair(), target->getPair());
+
+        double weight = edge->getWeight();
+        uint32_t bound = 0;
+        if(weight == std::numeric_limits<double>::max())
+        {
+            bound = std::numeric_limits<uint32_t>::max();
+        } else {
+            bound = static_cast<uint32_t>(weight);
+        }
+        mpIncrementalFlowGraph->setCapacityUpperBound(multicommodityEdge, bound);
+
+        if(isHorizonStart)
+        {
+            // commodity bounds and cost are set in setDepotRestrictions
+            continue;
+        }
+
+        for(size_t i = 0; i < commodities; ++i)
+        {
+            if(isHorizonEnd)
+            {
+                mpIncrementalFlowGraph->setCommodityCost(multicommodityEdge, i, 0);
+            }
+            mpIncrementalFlowGraph->setCommodityCapacityUpperBound(multicommodityEdge, i, bound);
+        }
+    }
+
+    return mpIncrementalFlowGraph->getGraph();
+}
+
 void MinCostFlow::setCommoditySupplyAndDemand()
 {
     for(const std::pair<Role, csp::RoleTimeline>& p : mMinRequiredTimelines)
@@ -196,6 +272,14 @@ void MinCostFlow::setDepotRestrictions(const graph_analysis::BaseGraph::Ptr& flo
 
         for(size_t i = 0; i < commodities; ++i)
         {
+            if(mpIncrementalFlowGraph)
+            {
+                uint32_t initialSetupDemand = mpIncrementalFlowGraph->getCommodityMinTransFlow(target, i);
+                mpIncrementalFlowGraph->setCommodityCapacityUpperBound(multicommodityEdge, i, initialSetupDemand);
+                mpIncrementalFlowGraph->setCommodityCost(multicommodityEdge, i, getInitialSetupCost(i));
+                continue;
+            }
+
             uint32_t initialSetupDemand = target->getCommodityMinTransFlow(i);
             multicommodityEdge->setCommodityCapacityUpperBound(i, initialSetupDemand);
             multicommodityEdge->setCommodityCost(i, getInitialSetupCost(i));
@@ -225,58 +309,95 @@ std::vector<Flaw> MinCostFlow::run(bool doThrow)
     using namespace graph_analysis::algorithms;
 
     uint32_t numberOfCommodities = mCommoditiesRoles.size();
-    BaseGraph::Ptr flowGraph = createFlowGraph(numberOfCommodities);
-    setCommoditySupplyAndDemand();
-    setDepotRestrictions(flowGraph, numberOfCommodities);
+    BaseGraph::Ptr flowGraph;
+    if(mpIncrementalFlowGraph)
+    {
+        flowGraph = updateFlowGraph(numberOfCommodities);
+        setCommoditySupplyAndDemand();
+        setDepotRestrictions(flowGraph, numberOfCommodities);
+        mpIncrementalFlowGraph->endUpdate();
+    } else {
+        flowGraph = createFlowGraph(numberOfCommodities);
+        setCommoditySupplyAndDemand();
+        setDepotRestrictions(flowGraph, numberOfCommodities);
+    }
 
-    MultiCommodityMinCostFlow minCostFlow(flowGraph, numberOfCommodities, mSolverType);
     // LOGGING
+    if(mWriteArtifacts)
     {
         std::string filename  = mpLogger->filename("multicommodity-min-cost-flow-init.gexf");
         graph_analysis::io::GraphIO::write(filename, flowGraph);
     }
 
-    std::string prefixPath = mpLogger->filename("multicommodity-min-cost-flow");
-    algorithms::LPSolver::Status status = minCostFlow.solve(prefixPath);
-    switch(status)
+    algorithms::LPSolver::Status status;
+    std::vector<ConstraintViolation> violations;
+    if(mpIncrementalFlowGraph)
     {
-        case algorithms::LPSolver::SOLUTION_FOUND:
-        case algorithms::LPSolver::STATUS_OPTIMAL:
-            break;
-        case algorithms::LPSolver::NO_SOLUTION_FOUND:
-        case algorithms::LPSolver::STATUS_INFEASIBLE:
-        case algorithms::LPSolver::STATUS_UNBOUNDED:
-        case algorithms::LPSolver::STATUS_UNKNOWN:
-        case algorithms::LPSolver::INVALID_PROBLEM_DEFINITION:
-        default:
-            if(doThrow)
-            {
-                throw std::runtime_error("templ::solvers::transshipment::MinCostFlow: no solution found");
-            }
-    }
+        // Modify the persistent LP and start from the previous basis
+        status = mpIncrementalFlowGraph->solve();
+        checkStatus(status, doThrow);
+        if(mWriteArtifacts)
+        {
+            std::string filename  = mpLogger->filename("multicommodity-min-cost-flow-final-flow.gexf");
+            graph_analysis::io::GraphIO::write(filename, flowGraph);
 
-    // LOGGING
-    {
-        std::string filename  = mpLogger->filename("multicommodity-min-cost-flow-final-flow.gexf");
-        graph_analysis::io::GraphIO::write(filename, flowGraph);
+            filename  = mpLogger->filename("multicommodity-min-cost-flow.lp");
+            mpIncrementalFlowGraph->save(filename);
+        }
+        violations = mpIncrementalFlowGraph->validateInflow();
+    } else {
+        MultiCommodityMinCostFlow minCostFlow(flowGraph, numberOfCommodities, mSolverType);
+        std::string prefixPath;
+        if(mWriteArtifacts)
+        {
+            prefixPath = mpLogger->filename("multicommodity-min-cost-flow");
+        }
+        // An empty prefix path keeps the optimization in memory
+        status = minCostFlow.solve(prefixPath);
+        checkStatus(status, doThrow);
+        if(mWriteArtifacts)
+        {
+            std::string filename  = mpLogger->filename("multicommodity-min-cost-flow-final-flow.gexf");
+            graph_analysis::io::GraphIO::write(filename, flowGraph);
 
-        filename  = mpLogger->filename("multicommodity-min-cost-flow.gexf");
-        minCostFlow.save(filename);
+            filename  = mpLogger->filename("multicommodity-min-cost-flow.gexf");
+            minCostFlow.save(filename);
+        }
+        violations = minCostFlow.validateInflow();
     }
 
     // Update roles in the space time network using the information of the
     // flow graph
     updateRoles(flowGraph);
 
-    return computeFlaws(minCostFlow);
+    return computeFlaws(violations);
 }
 
-std::vector<Flaw> MinCostFlow::computeFlaws(const MultiCommodityMinCostFlow& minCostFlow) const
+void MinCostFlow::checkStatus(graph_analysis::algorithms::LPSolver::Status status, bool doThrow) const
+{
+    switch(status)
+    {
+        case graph_analysis::algorithms::LPSolver::SOLUTION_FOUND:
+        case graph_analysis::algorithms::LPSolver::STATUS_OPTIMAL:
+            break;
+        case graph_analysis::algorithms::LPSolver::NO_SOLUTION_FOUND:
+        case graph_analysis::algorithms::LPSolver::STATUS_INFEASIBLE:
+        case graph_analysis::algorithms::LPSolver::STATUS_UNBOUNDED:
+        case graph_analysis::algorithms::LPSolver::STATUS_UNKNOWN:
+        case graph_analysis::algorithms::LPSolver::INVALID_PROBLEM_DEFINITION:
+        default:
+            if(doThrow)
+            {
+                throw std::runtime_error("templ::solvers::transshipment::MinCostFlow: no solution found");
+            }
+    }
+}
+
+std::vector<Flaw> MinCostFlow::computeFlaws(const std::vector<ConstraintViolation>& violations) const
 {
     std::vector<Flaw> flaws;
 
     // Check on violations of the current network
-    std::vector<ConstraintViolation> violations = minCostFlow.validateInflow();
     LOG_INFO_S << "Violations found: " << violations.size() << " violations in the commodity flow";
     std::vector<ConstraintViolation>::const_iterator vit = violations.begin();
     for(; vit != violations.end(); ++vit)
@@ -417,7 +538,12 @@ void MinCostFlow::setMinTransFlow(const SpaceTime::Network::tuple_t::Ptr& tuple,
     // intermediate ones
     // set minimum flow that needs to go through this node
     // for this commodity (i.e. can be either 0 or 1)
-    multicommodityVertex->setCommodityMinTransFlow(commodityId, value);
+    if(mpIncrementalFlowGraph)
+    {
+        mpIncrementalFlowGraph->setCommodityMinTransFlow(multicommodityVertex, commodityId, value);
+    } else {
+        multicommodityVertex->setCommodityMinTransFlow(commodityId, value);
+    }
     tuple->addRole(role, RoleInfo::REQUIRED);
 }
 
@@ -430,7 +556,12 @@ void MinCostFlow::setSupplyDemand(const SpaceTime::Network::tuple_t::Ptr& tuple,
     // intermediate ones
     // set minimum flow that needs to go through this node
     // for this commodity (i.e. can be either 0 or 1)
-    multicommodityVertex->setCommoditySupply(commodityId, value);
+    if(mpIncrementalFlowGraph)
+    {
+        mpIncrementalFlowGraph->setCommoditySupply(multicommodityVertex, commodityId, value);
+    } else {
+        multicommodityVertex->setCommoditySupply(commodityId, value);
+    }
     if(value >= 0)
     {
         tuple->addRole(role, RoleInfo::AVAILABLE);
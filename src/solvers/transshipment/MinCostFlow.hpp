@@ -8,6 +8,7 @@
 #include "../../solvers/csp/RoleTimeline.hpp"
 #include "FlowNetwork.hpp"
 #include "Flaw.hpp"
+#include "IncrementalFlowGraph.hpp"
 
 namespace templ {
 namespace solvers {
@@ -52,6 +53,25 @@ public:
     std::vector<Flaw> run(bool doThrow = false);
 
     FlowNetwork& getFlowNetwork() { return mFlowNetwork; }
+
+    /**
+     * Use a persistent flow graph, which is only updated with the
+     * changes in comparison to a previous run (instead of creating the flow
+     * graph from scratch); the persistent LP of this flow graph is then
+     * solved instead of a new LP, so that no LP problem file is written
+     * \param flowGraph Incremental flow graph, or an empty pointer to
+     * disable the incremental mode
+     * \throws std::invalid_argument if the solver type is not GLPK, since
+     * the persistent LP is solved with GLPK
+     */
+    void setIncrementalFlowGraph(const IncrementalFlowGraph::Ptr& flowGraph);
+
+    /**
+     * Enable/Disable writing the flow graphs and the LP problem to the
+     * session directory (enabled by default)
+     * When disabled, the optimization is performed without any file I/O
+     */
+    void setWriteArtifacts(bool writeArtifacts) { mWriteArtifacts = writeArtifacts; }
 protected:
     /**
      *  Translating the space time network into the mincommodity representation,
@@ -69,6 +89,16 @@ protected:
      */
     graph_analysis::BaseGraph::Ptr createFlowGraph(uint32_t commodities);
 
+    /**
+     * Update the incremental flow graph to match the current space time
+     * network -- this corresponds to createFlowGraph but only applies the
+     * changes to the flow graph of the previous run
+     *
+     * The restrictions of the horizon start edges are only set in
+     * setDepotRestrictions
+     */
+    graph_analysis::BaseGraph::Ptr updateFlowGraph(uint32_t commodities);
+
     /**
      *  Set the commodity supply and demand
      *  Since the general transport network is constructed from mobile systems,
@@ -98,9 +128,16 @@ protected:
     /**
      * Analyse the result of the optimization and identify the current
      * (partial) solution upon flaws
+     * \param violations Constraint violations of the optimized flow graph
      * \return List of existing flaws in the solution
      */
-    std::vector<Flaw> computeFlaws(const graph_analysis::algorithms::MultiCommodityMinCostFlow&) const;
+    std::vector<Flaw> computeFlaws(const std::vector<graph_analysis::algorithms::ConstraintViolation>& violations) const;
+
+    /**
+     * Check the status of the optimization
+     * \throws std::runtime_error if no solution has been found and doThrow is set
+     */
+    void checkStatus(graph_analysis::algorithms::LPSolver::Status status, bool doThrow) const;
 
     SpaceTime::Network::tuple_t::Ptr getFromTimeTuple(const FluentTimeResource& ftr);
     SpaceTime::Network::tuple_t::Ptr getToTimeTuple(const FluentTimeResource& ftr);
@@ -155,6 +192,9 @@ private:
     graph_analysis::algorithms::LPSolver::Type mSolverType;
 
     double mFeasibilityTimeoutInMs;
+
+    IncrementalFlowGraph::Ptr mpIncrementalFlowGraph;
+    bool mWriteArtifacts;
 };
 
 } // end namespace transshipment
@@ -0,0 +1,112 @@
+#include "ArtifactWriter.hpp"
+#include <fstream>
+#include <algorithm>
+#include <base-logging/Logging.hpp>
+
+namespace templ {
+namespace utils {
+
+ArtifactWriter::ArtifactWriter(size_t maxQueueSize)
+    : mMaxQueueSize(std::max(maxQueueSize, static_cast<size_t>(1)))
+    , mPending(0)
+    , mShutdown(false)
+{
+    mThread = std::thread(&ArtifactWriter::run, this);
+}
+
+ArtifactWriter::~ArtifactWriter()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mShutdown = true;
+    }
+    mQueueChanged.notify_all();
+    if(mThread.joinable())
+    {
+        mThread.join();
+    }
+}
+
+void ArtifactWriter::write(const std::string& filename, const std::string& content)
+{
+    enqueue([filename, content]()
+            {
+                std::ofstream outfile(filename);
+                outfile << content;
+            });
+}
+
+void ArtifactWriter::append(const std::string& filename, const std::string& content)
+{
+    enqueue([filename, content]()
+            {
+                std::ofstream outfile(filename, std::ios_base::app);
+                outfile << content;
+            });
+}
+
+void ArtifactWriter::enqueue(const Task& task)
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+    mRequestProcessed.wait(lock, [this]()
+            {
+                return mQueue.size() < mMaxQueueSize;
+            });
+    mQueue.push_back(task);
+    ++mPending;
+    lock.unlock();
+    mQueueChanged.notify_one();
+}
+
+void ArtifactWriter::flush()
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+    mRequestProcessed.wait(lock, [this]()
+            {
+                return mPending == 0;
+            });
+}
+
+size_t ArtifactWriter::getNumberOfPendingRequests() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mPending;
+}
+
+void ArtifactWriter::run()
+{
+    while(true)
+    {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mQueueChanged.wait(lock, [this]()
+                    {
+                        return mShutdown || !mQueue.empty();
+                    });
+            // Process all pending requests before shutting down
+            if(mQueue.empty())
+            {
+                return;
+            }
+            task = mQueue.front();
+            mQueue.pop_front();
+        }
+
+        try {
+            task();
+        } catch(const std::exception& e)
+        {
+            LOG_WARN_S << "Writing artifact failed: -- " << e.what();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            --mPending;
+        }
+        mRequestProcessed.notify_all();
+    }
+}
+
+} // end namespace utils
+} // end namespace templ
@@ -0,0 +1,87 @@
+#ifndef TEMPL_UTILS_ARTIFACT_WRITER_HPP
+#define TEMPL_UTILS_ARTIFACT_WRITER_HPP
+
+#include <string>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include "../SharedPtr.hpp"
+
+namespace templ {
+namespace utils {
+
+/**
+ * \class ArtifactWriter
+ * \details Asynchronous writer for log files and solution artifacts
+ *
+ * Write requests are queued and processed by a background thread, so that
+ * the filesystem latency does not affect the (search) thread which produces
+ * the artifacts. The queue is bounded: when it is full, callers block until
+ * the writer catches up (backpressure).
+ *
+ * All pending requests are processed on flush and when the writer is
+ * destroyed
+ */
+class ArtifactWriter
+{
+public:
+    typedef shared_ptr<ArtifactWriter> Ptr;
+    typedef std::function<void()> Task;
+
+    /**
+     * \param maxQueueSize Maximum number of pending requests
+     */
+    ArtifactWriter(size_t maxQueueSize = 64);
+
+    /**
+     * Flushes all pending requests
+     */
+    ~ArtifactWriter();
+
+    /**
+     * Write the content to the file (replacing an existing file)
+     */
+    void write(const std::string& filename, const std::string& content);
+
+    /**
+     * Append the content to the file (creating the file if it does not exist)
+     */
+    void append(const std::string& filename, const std::string& content);
+
+    /**
+     * Queue a generic write task, e.g. for serializing a graph
+     * Data used by the task has to be owned by the task
+     */
+    void enqueue(const Task& task);
+
+    /**
+     * Block until all pending requests have been processed
+     */
+    void flush();
+
+    /**
+     * Get the number of pending requests
+     */
+    size_t getNumberOfPendingRequests() const;
+
+private:
+    void run();
+
+    size_t mMaxQueueSize;
+    std::deque<Task> mQueue;
+    /// Number of requests that are queued or in process
+    size_t mPending;
+    bool mShutdown;
+
+    mutable std::mutex mMutex;
+    std::condition_variable mQueueChanged;
+    std::condition_variable mRequestProcessed;
+
+    std::thread mThread;
+};
+
+} // end namespace utils
+} // end namespace templ
+#endif // TEMPL_UTILS_ARTIFACT_WRITER_HPP
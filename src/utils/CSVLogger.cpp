@@ -60,23 +60,37 @@ void CSVLogger::save(const std::string& filename, bool withColumnDescription) co
     std::ofstream outfile(filename);
     if(withColumnDescription)
     {
-        outfile << "# ";
-        for(const std::string& description : mColumnDescription)
-        {
-            outfile << description << " ";
-        }
-        outfile << std::endl;
+        outfile << columnDescriptionToString();
     }
 
-    for(const Row& row : mRows)
+    for(size_t i = 0; i < mRows.size(); ++i)
     {
-        for(const double& value : row)
-        {
-            outfile << value << " ";
-        }
-        outfile << std::endl;
+        outfile << rowToString(i);
     }
     outfile.close();
 }
 
+std::string CSVLogger::columnDescriptionToString() const
+{
+    std::stringstream ss;
+    ss << "# ";
+    for(const std::string& description : mColumnDescription)
+    {
+        ss << description << " ";
+    }
+    ss << std::endl;
+    return ss.str();
+}
+
+std::string CSVLogger::rowToString(size_t rowIdx) const
+{
+    std::stringstream ss;
+    for(const double& value : mRows.at(rowIdx))
+    {
+        ss << value << " ";
+    }
+    ss << std::endl;
+    return ss.str();
+}
+
 } // end namespace templ
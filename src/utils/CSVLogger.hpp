@@ -25,6 +25,17 @@ public:
 
     void save(const std::string& filename, bool withColumnDescription = true) const;
 
+    /**
+     * Get the column description line (including the line break)
+     */
+    std::string columnDescriptionToString() const;
+
+    /**
+     * Get a single row as line (including the line break), e.g.
+     * to append the row to an existing file
+     */
+    std::string rowToString(size_t rowIdx) const;
+
     size_t getNumberOfColums() const { return mColumnDescription.size(); }
     size_t getNumberOfRows() const { return mRows.size(); }
 
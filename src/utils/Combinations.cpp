@@ -0,0 +1,184 @@
+#include "Combinations.hpp"
+#include "Hash.hpp"
+#include <stdexcept>
+#include <sstream>
+#include <algorithm>
+
+namespace templ {
+namespace utils {
+
+// Number of rounds of the Feistel network
+static const size_t FEISTEL_ROUNDS = 4;
+
+Combinations::Combinations(size_t numberOfItems)
+    : mNumberOfItems(numberOfItems)
+    , mTotal(0)
+    , mNumberOfDraws(0)
+    , mHalfBits((numberOfItems + 1)/2)
+{
+    if(numberOfItems > MAX_ITEMS)
+    {
+        std::stringstream ss;
+        ss << "templ::utils::Combinations: number of items " << numberOfItems
+            << " exceeds the maximum of " << MAX_ITEMS;
+        throw std::invalid_argument(ss.str());
+    }
+    mTotal = (static_cast<uint64_t>(1) << numberOfItems) - 1;
+}
+
+bool Combinations::next(Draw& draw, bool random, std::mt19937& generator)
+{
+    if(empty())
+    {
+        return false;
+    }
+
+    uint64_t index;
+    if(random)
+    {
+        if(mKeys.empty())
+        {
+            for(size_t i = 0; i < FEISTEL_ROUNDS; ++i)
+            {
+                mKeys.push_back( (static_cast<uint64_t>(generator()) << 32) | generator() );
+            }
+        }
+        index = permute(mNumberOfDraws);
+    } else {
+        index = mTotal - 1 - mNumberOfDraws;
+    }
+    ++mNumberOfDraws;
+
+    draw = unrank(index);
+    return true;
+}
+
+Combinations::Draw Combinations::unrank(uint64_t index) const
+{
+    if(index >= mTotal)
+    {
+        throw std::invalid_argument("templ::utils::Combinations::unrank: index is out of bounds");
+    }
+
+    // Identify the size of the combination
+    size_t n = mNumberOfItems;
+    size_t k = 1;
+    uint64_t count = n;
+    while(index >= count)
+    {
+        index -= count;
+        count = count*(n - k)/(k + 1);
+        ++k;
+    }
+
+    // Identify the combination of size k in lexicographic order, where c is
+    // the number of combinations that contain the current item as next item
+    Draw draw;
+    size_t remaining = k;
+    uint64_t c = binomial(n - 1, k - 1);
+    for(size_t item = 0; remaining > 0; ++item)
+    {
+        size_t m = n - 1 - item;
+        if(index < c)
+        {
+            draw.push_back(item);
+            --remaining;
+            if(remaining > 0)
+            {
+                c = c*remaining/m;
+            }
+        } else {
+            index -= c;
+            c = c*(m - (remaining - 1))/m;
+        }
+    }
+    return draw;
+}
+
+uint64_t Combinations::rank(const Draw& draw) const
+{
+    if(draw.empty())
+    {
+        throw std::invalid_argument("templ::utils::Combinations::rank: draw is empty");
+    }
+    for(size_t i = 0; i < draw.size(); ++i)
+    {
+        if(draw[i] >= mNumberOfItems || (i > 0 && draw[i-1] >= draw[i]))
+        {
+            throw std::invalid_argument("templ::utils::Combinations::rank: draw is not a strictly increasing list of valid item indices");
+        }
+    }
+
+    size_t n = mNumberOfItems;
+    size_t k = draw.size();
+    uint64_t index = 0;
+    for(size_t j = 1; j < k; ++j)
+    {
+        index += binomial(n, j);
+    }
+
+    size_t remaining = k;
+    size_t pos = 0;
+    uint64_t c = binomial(n - 1, k - 1);
+    for(size_t item = 0; remaining > 0; ++item)
+    {
+        size_t m = n - 1 - item;
+        if(draw[pos] == item)
+        {
+            ++pos;
+            --remaining;
+            if(remaining > 0)
+            {
+                c = c*remaining/m;
+            }
+        } else {
+            index += c;
+            c = c*(m - (remaining - 1))/m;
+        }
+    }
+    return index;
+}
+
+uint64_t Combinations::binomial(size_t n, size_t k)
+{
+    if(k > n)
+    {
+        return 0;
+    }
+    k = std::min(k, n - k);
+    uint64_t value = 1;
+    for(size_t i = 1; i <= k; ++i)
+    {
+        value = value*(n - k + i)/i;
+    }
+    return value;
+}
+
+uint64_t Combinations::permute(uint64_t index) const
+{
+    // Cycle walking: the Feistel network permutes the power of two domain,
+    // so apply it until the value falls into the index space
+    uint64_t value = feistel(index);
+    while(value >= mTotal)
+    {
+        value = feistel(value);
+    }
+    return value;
+}
+
+uint64_t Combinations::feistel(uint64_t value) const
+{
+    uint64_t mask = (static_cast<uint64_t>(1) << mHalfBits) - 1;
+    uint64_t left = value >> mHalfBits;
+    uint64_t right = value & mask;
+    for(uint64_t key : mKeys)
+    {
+        uint64_t nextRight = left ^ (hash::mix(right ^ key) & mask);
+        left = right;
+        right = nextRight;
+    }
+    return (left << mHalfBits) | right;
+}
+
+} // end namespace utils
+} // end namespace templ
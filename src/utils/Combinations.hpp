@@ -0,0 +1,108 @@
+#ifndef TEMPL_UTILS_COMBINATIONS_HPP
+#define TEMPL_UTILS_COMBINATIONS_HPP
+
+#include <cstdint>
+#include <vector>
+#include <random>
+
+namespace templ {
+namespace utils {
+
+/**
+ * \class Combinations
+ * \brief Lazy, indexable sequence of all combinations of n items, i.e. all
+ * non-empty subsets of {0, ..., n-1}
+ * \details The combinations are ordered as by numeric::Combination with
+ * numeric::MAX, i.e. by size and lexicographically for the same size.
+ * Combinations are computed from their index (unrank) instead of being
+ * materialized, so that memory is O(n) instead of O(2^n) and drawing is O(n).
+ *
+ * Draws are taken without replacement either from the back of the sequence
+ * or in the order of a random permutation of the index space.
+ * The permutation is a Feistel network (with cycle walking), so that it
+ * requires only a fixed number of keys.
+ * The draw mode must not be changed between calls to next()
+ */
+class Combinations
+{
+public:
+    typedef std::vector<size_t> Draw;
+
+    /// Maximum number of items, so that all combination counts (and
+    /// intermediate products) fit into 64 bit
+    static const size_t MAX_ITEMS = 60;
+
+    /**
+     * Create the combinations of the given number of items
+     * \throws std::invalid_argument if the number of items exceeds MAX_ITEMS
+     */
+    Combinations(size_t numberOfItems = 0);
+
+    /**
+     * Get the number of items
+     */
+    size_t getNumberOfItems() const { return mNumberOfItems; }
+
+    /**
+     * Get the total number of combinations, i.e. 2^n - 1
+     */
+    uint64_t total() const { return mTotal; }
+
+    /**
+     * Get the number of combinations that have not been drawn yet
+     */
+    uint64_t size() const { return mTotal - mNumberOfDraws; }
+
+    /**
+     * Check if all combinations have been drawn
+     */
+    bool empty() const { return size() == 0; }
+
+    /**
+     * Draw the next combination
+     * \param random If true draw in the order of a random permutation,
+     * otherwise draw from the back of the sequence
+     * \return false if all combinations have been drawn
+     */
+    bool next(Draw& draw, bool random, std::mt19937& generator);
+
+    /**
+     * Get the combination with the given index
+     */
+    Draw unrank(uint64_t index) const;
+
+    /**
+     * Get the index of a combination
+     * \param draw Strictly increasing list of item indices
+     */
+    uint64_t rank(const Draw& draw) const;
+
+    /**
+     * Compute the binomial coefficient n over k
+     */
+    static uint64_t binomial(size_t n, size_t k);
+
+protected:
+    /**
+     * Permute an index of the index space (using the permutation keys)
+     */
+    uint64_t permute(uint64_t index) const;
+
+    /**
+     * Apply the Feistel network to a value of the (power of two) domain
+     */
+    uint64_t feistel(uint64_t value) const;
+
+private:
+    size_t mNumberOfItems;
+    uint64_t mTotal;
+    uint64_t mNumberOfDraws;
+
+    // Number of bits of each half of the Feistel domain
+    uint32_t mHalfBits;
+    std::vector<uint64_t> mKeys;
+};
+
+} // end namespace utils
+} // end namespace templ
+#endif // TEMPL_UTILS_COMBINATIONS_HPP
@@ -0,0 +1,69 @@
+#ifndef TEMPL_UTILS_COPY_ON_WRITE_HPP
+#define TEMPL_UTILS_COPY_ON_WRITE_HPP
+
+#include "../SharedPtr.hpp"
+
+namespace templ {
+namespace utils {
+
+/**
+ * \class CopyOnWrite
+ * \brief Value wrapper, where copies share the data until it is modified
+ * \details Copying a CopyOnWrite instance is O(1), since only the reference
+ * to the (immutable) data is copied. A private copy of the data is created
+ * only when it is accessed via modify() while it is shared.
+ *
+ * Modification of a shared instance must not happen concurrently to a copy
+ * of the same instance, which holds for Gecode spaces, since a space is
+ * not modified while it is cloned
+ */
+template<typename T>
+class CopyOnWrite
+{
+public:
+    CopyOnWrite()
+        : mpData(make_shared<T>())
+    {}
+
+    CopyOnWrite(const T& data)
+        : mpData(make_shared<T>(data))
+    {}
+
+    /**
+     * Replace the data
+     */
+    CopyOnWrite& operator=(const T& data)
+    {
+        mpData = make_shared<T>(data);
+        return *this;
+    }
+
+    const T& operator*() const { return *mpData; }
+    const T* operator->() const { return mpData.get(); }
+    const T& get() const { return *mpData; }
+
+    /**
+     * Get write access to the data, i.e. detach from all other copies if
+     * the data is shared
+     */
+    T& modify()
+    {
+        if(mpData.use_count() > 1)
+        {
+            mpData = make_shared<T>(*mpData);
+        }
+        return *mpData;
+    }
+
+    /**
+     * Check if the data is shared with other copies
+     */
+    bool isShared() const { return mpData.use_count() > 1; }
+
+private:
+    shared_ptr<T> mpData;
+};
+
+} // end namespace utils
+} // end namespace templ
+#endif // TEMPL_UTILS_COPY_ON_WRITE_HPP
@@ -0,0 +1,116 @@
+#ifndef TEMPL_UTILS_HASH_HPP
+#define TEMPL_UTILS_HASH_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <functional>
+
+namespace templ {
+namespace utils {
+
+/**
+ * Hashing functions to compute compact (64 bit or 128 bit) content hashes,
+ * e.g., to use as cache keys instead of comparing full objects
+ */
+namespace hash {
+
+const uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ULL;
+const uint64_t FNV_PRIME = 0x100000001b3ULL;
+
+/**
+ * 64 bit FNV-1a hash of a sequence of bytes
+ * \param hash The hash value to continue from
+ */
+inline uint64_t fnv1a(const void* data, size_t size, uint64_t hash = FNV_OFFSET_BASIS)
+{
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for(size_t i = 0; i < size; ++i)
+    {
+        hash ^= bytes[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+inline uint64_t fnv1a(const std::string& s, uint64_t hash = FNV_OFFSET_BASIS)
+{
+    return fnv1a(s.data(), s.size(), hash);
+}
+
+/**
+ * Finalizer of splitmix64 to obtain a well distributed value
+ */
+inline uint64_t mix(uint64_t value)
+{
+    value ^= value >> 30;
+    value *= 0xbf58476d1ce4e5b9ULL;
+    value ^= value >> 27;
+    value *= 0x94d049bb133111ebULL;
+    value ^= value >> 31;
+    return value;
+}
+
+/**
+ * Combine a hash value (seed) with a further value
+ */
+inline uint64_t combine(uint64_t seed, uint64_t value)
+{
+    return mix(seed ^ (value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2)));
+}
+
+} // end namespace hash
+
+/**
+ * 128 bit hash value which is computed from two independently seeded 64 bit
+ * hashes
+ */
+struct Hash128
+{
+    uint64_t first;
+    uint64_t second;
+
+    Hash128(uint64_t first = hash::FNV_OFFSET_BASIS, uint64_t second = hash::mix(hash::FNV_OFFSET_BASIS))
+        : first(first)
+        , second(second)
+    {}
+
+    /**
+     * Add a value to this hash
+     */
+    void update(uint64_t value)
+    {
+        first = hash::combine(first, value);
+        second = hash::combine(second, hash::mix(value) ^ 0x5bd1e9955bd1e995ULL);
+    }
+
+    void update(const std::string& s) { update(hash::fnv1a(s)); }
+
+    bool operator==(const Hash128& other) const { return first == other.first && second == other.second; }
+    bool operator!=(const Hash128& other) const { return !(*this == other); }
+    bool operator<(const Hash128& other) const
+    {
+        if(first == other.first)
+        {
+            return second < other.second;
+        }
+        return first < other.first;
+    }
+};
+
+} // end namespace utils
+} // end namespace templ
+
+namespace std {
+
+template<>
+struct hash<templ::utils::Hash128>
+{
+    size_t operator()(const templ::utils::Hash128& h) const
+    {
+        return static_cast<size_t>(h.first ^ (h.second * 0x9e3779b97f4a7c15ULL));
+    }
+};
+
+} // end namespace std
+#endif // TEMPL_UTILS_HASH_HPP
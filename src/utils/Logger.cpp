@@ -1,16 +1,40 @@
 #include "Logger.hpp"
 #include <sstream>
+#include <stdexcept>
 #include <boost/filesystem.hpp>
 #include <base-logging/Logging.hpp>
 
 namespace templ {
 namespace utils {
 
+std::map<Logger::ArtifactPolicy, std::string> Logger::ArtifactPolicyTxt = {
+    { Logger::ARTIFACTS_NONE, "none" },
+    { Logger::ARTIFACTS_ON_SOLUTION, "on-solution" },
+    { Logger::ARTIFACTS_EVERY_NTH, "every-nth" },
+    { Logger::ARTIFACTS_ALL, "all" }
+};
+
+Logger::ArtifactPolicy Logger::getArtifactPolicyFromTxt(const std::string& policy)
+{
+    for(const std::pair<const ArtifactPolicy, std::string>& p : ArtifactPolicyTxt)
+    {
+        if(p.second == policy)
+        {
+            return p.first;
+        }
+    }
+    throw std::invalid_argument("templ::utils::Logger::getArtifactPolicyFromTxt: unknown policy '"
+            + policy + "'");
+}
+
 Logger::Logger(const base::Time& time, const std::string& baseDirectory, bool useSessions)
     : mTime(time)
     , mBaseDirectory(baseDirectory)
     , mUseSessions(useSessions)
     , mSessionId(0)
+    , mArtifactPolicy(ARTIFACTS_ALL)
+    , mArtifactInterval(1)
+    , mIntermediateEvaluations(0)
 {
 }
 
@@ -22,15 +46,56 @@ std::string Logger::filename(const std::string& filename) const
     {
         ss << "/" << mSessionId;
     }
-    if(boost::filesystem::create_directories( boost::filesystem::path(ss.str())) )
     {
-        LOG_DEBUG_S << "Created directory: '" << ss.str() << "'";
+        std::lock_guard<std::mutex> lock(mMutex);
+        if(mCreatedDirectories.insert(ss.str()).second)
+        {
+            if(boost::filesystem::create_directories( boost::filesystem::path(ss.str())) )
+            {
+                LOG_DEBUG_S << "Created directory: '" << ss.str() << "'";
+            }
+        }
     }
 
     ss << "/" << filename;
     return ss.str();
 }
 
+ArtifactWriter::Ptr Logger::getArtifactWriter()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    if(!mpArtifactWriter)
+    {
+        mpArtifactWriter = make_shared<ArtifactWriter>();
+    }
+    return mpArtifactWriter;
+}
+
+void Logger::setArtifactPolicy(ArtifactPolicy policy, uint32_t interval)
+{
+    if(interval == 0)
+    {
+        throw std::invalid_argument("templ::utils::Logger::setArtifactPolicy: interval must be greater than 0");
+    }
+    mArtifactPolicy = policy;
+    mArtifactInterval = interval;
+}
+
+bool Logger::sampleIntermediateArtifacts()
+{
+    uint64_t evaluation = mIntermediateEvaluations++;
+    switch(mArtifactPolicy)
+    {
+        case ARTIFACTS_ALL:
+            return true;
+        case ARTIFACTS_EVERY_NTH:
+            return (evaluation % mArtifactInterval) == 0;
+        default:
+            break;
+    }
+    return false;
+}
+
 std::string Logger::getBasePath() const
 {
     std::stringstream ss;
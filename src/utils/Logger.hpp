@@ -2,8 +2,13 @@
 #define TEMPL_LOGGER_HPP
 
 #include <string>
+#include <map>
+#include <atomic>
+#include <mutex>
+#include <set>
 #include <base/Time.hpp>
 #include "../SharedPtr.hpp"
+#include "ArtifactWriter.hpp"
 
 namespace templ {
 namespace utils {
@@ -19,15 +24,47 @@ class Logger
 public:
     typedef shared_ptr<Logger> Ptr;
 
+    /**
+     * Policy to control which (file) artifacts are written
+     * during the search, i.e. intermediate artifacts are written per
+     * evaluated candidate, solution artifacts per found solution
+     */
+    enum ArtifactPolicy { ARTIFACTS_NONE = 0,
+        /// write only artifacts of found solutions
+        ARTIFACTS_ON_SOLUTION,
+        /// write artifacts of found solutions and of every nth
+        /// intermediate candidate
+        ARTIFACTS_EVERY_NTH,
+        /// write all artifacts
+        ARTIFACTS_ALL,
+        END_ARTIFACTS
+    };
+
+    static std::map<ArtifactPolicy, std::string> ArtifactPolicyTxt;
+
+    /**
+     * Get the artifact policy from its string representation, i.e.
+     * none, on-solution, every-nth or all
+     * \throw std::invalid_argument if the policy is unknown
+     */
+    static ArtifactPolicy getArtifactPolicyFromTxt(const std::string& policy);
+
     Logger(const base::Time& time = base::Time::now()
             , const std::string& baseDirectory = "/tmp"
             , bool useSessions = true);
 
     /**
-     *
+     * Get the full path for a file in the current session directory
+     * The session directory is created if it does not exist yet
      */
     std::string filename(const std::string& filename) const;
 
+    /**
+     * Get the asynchronous writer for log files and artifacts of this
+     * logger
+     */
+    ArtifactWriter::Ptr getArtifactWriter();
+
 
     const base::Time& getTime() const { return mTime; }
 
@@ -55,11 +92,39 @@ public:
 
     std::string getBasePath() const;
 
+    /**
+     * Set the artifact policy
+     * \param interval Sampling interval for ARTIFACTS_EVERY_NTH
+     */
+    void setArtifactPolicy(ArtifactPolicy policy, uint32_t interval = 1);
+    ArtifactPolicy getArtifactPolicy() const { return mArtifactPolicy; }
+
+    /**
+     * Register an intermediate evaluation and check whether its artifacts
+     * should be written
+     * \return true if artifacts should be written, false otherwise
+     */
+    bool sampleIntermediateArtifacts();
+
+    /**
+     * Check whether the artifacts of a solution should be written
+     */
+    bool logSolutionArtifacts() const { return mArtifactPolicy != ARTIFACTS_NONE; }
+
 private:
     base::Time mTime;
     std::string mBaseDirectory;
     bool mUseSessions;
     uint32_t mSessionId;
+
+    ArtifactPolicy mArtifactPolicy;
+    uint32_t mArtifactInterval;
+    std::atomic<uint64_t> mIntermediateEvaluations;
+
+    /// Cache of the already created directories
+    mutable std::set<std::string> mCreatedDirectories;
+    mutable std::mutex mMutex;
+    ArtifactWriter::Ptr mpArtifactWriter;
 };
 
 } // end namespace utils
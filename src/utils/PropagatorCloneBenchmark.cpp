@@ -0,0 +1,136 @@
+#include <iostream>
+#include <cstdlib>
+#include <sstream>
+#include <vector>
+#include <numeric/Stats.hpp>
+#include <base/Time.hpp>
+#include <gecode/set.hh>
+
+#include "../solvers/csp/propagators/IsPath.hpp"
+#include "../solvers/csp/propagators/IsValidTransportEdge.hpp"
+#include "../solvers/csp/propagators/MultiCommodityFlow.hpp"
+
+using namespace templ::solvers::csp;
+
+/**
+ * Minimal space which posts the custom timeline propagators in the same way
+ * as the TransportNetwork, in order to measure the cost of cloning
+ * \details The benchmark only reports the cost for the current build; no
+ * reference results are kept, so compare runs of two builds on the same
+ * machine to assess a change
+ */
+class CloneBenchmarkSpace : public Gecode::Space
+{
+public:
+    CloneBenchmarkSpace(size_t numberOfRoles, size_t numberOfTimepoints, size_t numberOfFluents)
+        : Gecode::Space()
+    {
+        size_t locationTimeSize = numberOfTimepoints*numberOfFluents;
+        for(size_t r = 0; r < numberOfRoles; ++r)
+        {
+            Gecode::SetVarArray timeline(*this, locationTimeSize, Gecode::IntSet::empty, Gecode::IntSet(0,locationTimeSize-1), 0, 1);
+            for(size_t t = 0; t < numberOfTimepoints; ++t)
+            {
+                for(size_t l = 0; l < numberOfFluents; ++l)
+                {
+                    Gecode::Set::SetView v(timeline[t*numberOfFluents + l]);
+                    // only edges to the next timestep are allowed
+                    v.exclude(*this, 0, (t+1)*numberOfFluents - 1);
+                    v.exclude(*this, (t+2)*numberOfFluents, locationTimeSize);
+                }
+            }
+            mTimelines.push_back(timeline);
+
+            std::stringstream ss;
+            ss << "role-" << r;
+            propagators::isPath(*this, timeline, ss.str(), numberOfTimepoints, numberOfFluents);
+        }
+
+        // Alternating transport providers and consumers
+        std::vector<int32_t> supplyDemand;
+        for(size_t r = 0; r < numberOfRoles; ++r)
+        {
+            supplyDemand.push_back( (r % 2 == 0) ? 2 : -1);
+        }
+
+        for(size_t t = 0; t + 1 < numberOfTimepoints; ++t)
+        {
+            for(size_t l = 0; l < numberOfFluents; ++l)
+            {
+                Gecode::SetVarArgs edges;
+                for(size_t r = 0; r < numberOfRoles; ++r)
+                {
+                    edges << mTimelines[r][t*numberOfFluents + l];
+                }
+                propagators::isValidTransportEdge(*this, edges, supplyDemand, t, l, numberOfFluents);
+            }
+        }
+
+        propagators::multiCommodityFlow(*this, supplyDemand, mTimelines, numberOfTimepoints, numberOfFluents);
+    }
+
+    CloneBenchmarkSpace(CloneBenchmarkSpace& other)
+        : Gecode::Space(other)
+    {
+        for(size_t i = 0; i < other.mTimelines.size(); ++i)
+        {
+            Gecode::SetVarArray timeline;
+            timeline.update(*this, other.mTimelines[i]);
+            mTimelines.push_back(timeline);
+        }
+    }
+
+    virtual Gecode::Space* copy(void)
+    {
+        return new CloneBenchmarkSpace(*this);
+    }
+
+private:
+    std::vector<Gecode::SetVarArray> mTimelines;
+};
+
+int main(int argc, char** argv)
+{
+    if(argc > 1 && std::string(argv[1]) == "--help")
+    {
+        std::cout << "usage: " << argv[0] << " [<number-of-roles> [<number-of-timepoints> [<number-of-fluents> [<number-of-clones>]]]]" << std::endl;
+        return 0;
+    }
+
+    size_t numberOfRoles = argc > 1 ? atoi(argv[1]) : 10;
+    size_t numberOfTimepoints = argc > 2 ? atoi(argv[2]) : 10;
+    size_t numberOfFluents = argc > 3 ? atoi(argv[3]) : 5;
+    size_t numberOfClones = argc > 4 ? atoi(argv[4]) : 1000;
+
+    CloneBenchmarkSpace* space = new CloneBenchmarkSpace(numberOfRoles, numberOfTimepoints, numberOfFluents);
+    if(space->status() == Gecode::SS_FAILED)
+    {
+        std::cout << "Benchmark space failed during initial propagation" << std::endl;
+        delete space;
+        return 1;
+    }
+
+    numeric::Stats<double> cloneStats;
+    numeric::Stats<double> deleteStats;
+    size_t allocated = 0;
+    for(size_t i = 0; i < numberOfClones; ++i)
+    {
+        base::Time start = base::Time::now();
+        Gecode::Space* clone = space->clone();
+        cloneStats.update( (base::Time::now() - start).toSeconds() );
+
+        allocated = clone->allocated();
+
+        start = base::Time::now();
+        delete clone;
+        deleteStats.update( (base::Time::now() - start).toSeconds() );
+    }
+    delete space;
+
+    std::cout << "# <number-of-roles> <number-of-timepoints> <number-of-fluents> <clone-mean> <clone-stdev> <delete-mean> <delete-stdev> <allocated-bytes>" << std::endl;
+    std::cout << numberOfRoles << " " << numberOfTimepoints << " " << numberOfFluents << " "
+        << cloneStats.mean() << " " << cloneStats.stdev() << " "
+        << deleteStats.mean() << " " << deleteStats.stdev() << " "
+        << allocated << std::endl;
+    return 0;
+}
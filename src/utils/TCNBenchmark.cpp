@@ -1,4 +1,5 @@
 #include <iostream>
+#include <cstdlib>
 #include <sstream>
 #include <numeric/Stats.hpp>
 #include <base/Time.hpp>
@@ -54,6 +55,20 @@ int main(int argc, char** argv)
     stats["gq"];
 #endif
     stats["incremental"];
+    stats["matrix"];
+
+    // Allow to benchmark larger networks, e.g., for the matrix based
+    // path consistency
+    int maxNumberOfTimepoints = 502;
+    int stepSize = 50;
+    if(argc > 1)
+    {
+        maxNumberOfTimepoints = atoi(argv[1]);
+    }
+    if(argc > 2)
+    {
+        stepSize = atoi(argv[2]);
+    }
 
     std::cout << "# <number-of-timepoints> ";
     for(std::pair<std::string, numeric::Stats<double> > p : stats)
@@ -62,7 +77,7 @@ int main(int argc, char** argv)
     }
     std::cout << std::endl;
 
-    for(int i = 10; i < 502; i+=50)
+    for(int i = 10; i < maxNumberOfTimepoints; i+=stepSize)
     {
         for(int epoch = 0; epoch < 20; ++epoch)
         {
@@ -86,6 +101,13 @@ int main(int argc, char** argv)
             stats["gq"].update(gqDuration);
 #endif // WITH_GQR
 
+            // Matrix based path consistency does not modify the graph, so
+            // that it is run before the incremental path consistency
+            start = base::Time::now();
+            tcn->isConsistent(QualitativeTemporalConstraintNetwork::TCN_MATRIX);
+            double matrix = (base::Time::now() - start).toSeconds();
+            stats["matrix"].update(matrix);
+
             start = base::Time::now();
             tcn->isConsistent(QualitativeTemporalConstraintNetwork::TCN_INCREMENTAL);
             double incremental = (base::Time::now() - start).toSeconds();
@@ -95,7 +117,7 @@ int main(int argc, char** argv)
 #ifdef WITH_GQR
             std::cout << gqWithOverheadDuration << " " << gqDuration << " ";
 #endif // WITH_GQR
-            std::cout << incremental << std::endl;
+            std::cout << incremental << " " << matrix << std::endl;
         }
         //std::cout << i <<  " ";
         //for(std::pair<std::string, numeric::Stats<double> > p: stats)
@@ -0,0 +1,81 @@
+#include <iostream>
+#include <cstdlib>
+#include <numeric/Stats.hpp>
+#include <base/Time.hpp>
+#include <gecode/search.hh>
+
+#include "../io/MissionReader.hpp"
+#include "../solvers/csp/TransportNetwork.hpp"
+
+using namespace templ;
+using namespace templ::solvers::csp;
+
+/**
+ * Measure the cost of cloning the given space
+ * \details Only the cost for the current build is reported, so compare runs
+ * of two builds to assess a change
+ */
+numeric::Stats<double> measureClone(Gecode::Space& space, size_t numberOfClones)
+{
+    numeric::Stats<double> stats;
+    for(size_t i = 0; i < numberOfClones; ++i)
+    {
+        base::Time start = base::Time::now();
+        Gecode::Space* clone = space.clone();
+        stats.update( (base::Time::now() - start).toSeconds() );
+        delete clone;
+    }
+    return stats;
+}
+
+int main(int argc, char** argv)
+{
+    if(argc < 3)
+    {
+        std::cout << "usage: " << argv[0] << " <mission> <configuration> [<number-of-clones>]" << std::endl;
+        std::cout << "Measure the cost of cloning the TransportNetwork for the initial space and the first solution, e.g.," << std::endl;
+        std::cout << "    " << argv[0] << " test/data/scenarios/test-mission-1.xml test/data/configuration/default-configuration.xml" << std::endl;
+        return 1;
+    }
+
+    std::string missionFilename = argv[1];
+    qxcfg::Configuration configuration(argv[2]);
+    size_t numberOfClones = argc > 3 ? atoi(argv[3]) : 1000;
+
+    Mission baseMission = io::MissionReader::fromFile(missionFilename);
+    baseMission.applyOrganizationModelOverrides();
+    Mission::Ptr mission = make_shared<Mission>(baseMission);
+    mission->getLogger()->setBaseDirectory(configuration.getValue("TransportNetwork/logging/basedir","/tmp"));
+    mission->getLogger()->setArtifactPolicy(templ::utils::Logger::ARTIFACTS_NONE);
+    mission->prepareForPlanning();
+
+    TransportNetwork* space = new TransportNetwork(mission, configuration);
+    if(space->status() == Gecode::SS_FAILED)
+    {
+        std::cout << "Initial space failed" << std::endl;
+        delete space;
+        return 1;
+    }
+
+    std::cout << "# <space> <number-of-clones> <clone-mean> <clone-stdev>" << std::endl;
+    numeric::Stats<double> rootStats = measureClone(*space, numberOfClones);
+    std::cout << "initial " << numberOfClones << " " << rootStats.mean() << " " << rootStats.stdev() << std::endl;
+
+    // The first solution carries the full solution state, i.e. the min cost
+    // flow solution, flaws and the solution analysis
+    Gecode::Search::Options options;
+    options.cutoff = Gecode::Search::Cutoff::geometric(10, 2);
+    Gecode::RBS<TransportNetwork, Gecode::DFS> searchEngine(space, options);
+    TransportNetwork* solution = searchEngine.next();
+    if(solution)
+    {
+        numeric::Stats<double> solutionStats = measureClone(*solution, numberOfClones);
+        std::cout << "solution " << numberOfClones << " " << solutionStats.mean() << " " << solutionStats.stdev() << std::endl;
+        delete solution;
+    } else {
+        std::cout << "# no solution found" << std::endl;
+    }
+
+    delete space;
+    return 0;
+}
@@ -1,7 +1,13 @@
 #include <boost/test/unit_test.hpp>
 #include <templ/Mission.hpp>
 #include <templ/solvers/csp/FlawResolution.hpp>
+#include <templ/solvers/csp/FlowSolutionCache.hpp>
+#include <templ/solvers/csp/Context.hpp>
+#include <templ/solvers/csp/Portfolio.hpp>
+#include <templ/io/MissionReader.hpp>
+#include <templ/solvers/CoalitionFeasibilityCache.hpp>
 #include <moreorg/vocabularies/OM.hpp>
+#include <thread>
 
 #include "../test_utils.hpp"
 
@@ -437,6 +443,224 @@ BOOST_AUTO_TEST_CASE(flaw_resolution)
             }
         }
     }
+
+    {
+        // Resolution options beyond the enumerable maximum must not be dropped
+        std::vector<transshipment::Flaw> tooManyFlaws(templ::utils::Combinations::MAX_ITEMS + 1, flaw1);
+        FlawResolution flawResolution;
+        BOOST_REQUIRE_THROW(flawResolution.prepare(tooManyFlaws), std::invalid_argument);
+
+        tooManyFlaws.pop_back();
+        flawResolution.prepare(tooManyFlaws);
+        BOOST_REQUIRE_MESSAGE(flawResolution.getResolutionOptions().size() == templ::utils::Combinations::MAX_ITEMS,
+                "All resolution options should be kept");
+    }
+}
+
+BOOST_AUTO_TEST_CASE(extensional_domain_cache)
+{
+    using namespace templ::solvers::csp;
+    using namespace templ::solvers;
+
+    moreorg::OrganizationModel::Ptr om = moreorg::OrganizationModel::getInstance(owlapi::model::IRI("http://www.rock-robotics.org/2015/12/projects/TransTerrA"));
+    std::string missionFilename = getRootDir() + "test/data/scenarios/should_succeed/0.xml";
+    Mission baseMission = templ::io::MissionReader::fromFile(missionFilename, om);
+    Mission::Ptr mission = make_shared<Mission>(baseMission);
+    mission->prepareTimeIntervals();
+
+    FluentTimeResource::List requirements = Mission::getResourceRequirements(mission);
+    BOOST_REQUIRE_MESSAGE(!requirements.empty(), "Mission should have requirements");
+
+    Context context(mission);
+    size_t hits = 0;
+    for(const FluentTimeResource& ftr : requirements)
+    {
+        templ::utils::Hash128 signature = Context::getDomainSignature(ftr);
+        moreorg::ModelPool::Set domain = ftr.getDomain();
+
+        Context::ExtensionalDomain cached;
+        if(context.getExtensionalDomain(signature, cached))
+        {
+            // Requirements of the same signature have to share the domain
+            BOOST_REQUIRE_MESSAGE(cached.combinations == domain, "Cached domain should equal the domain of " << ftr.toString());
+            ++hits;
+        } else {
+            cached.combinations = domain;
+            context.putExtensionalDomain(signature, cached);
+        }
+    }
+
+    // The same requirement always hits
+    const FluentTimeResource& ftr = requirements.front();
+    Context::ExtensionalDomain cached;
+    BOOST_REQUIRE_MESSAGE(context.getExtensionalDomain(Context::getDomainSignature(FluentTimeResource(ftr)), cached),
+            "Copy of a requirement should hit the cache");
+    BOOST_REQUIRE_MESSAGE(cached.combinations == ftr.getDomain(), "Cache hit should return an equal domain");
+
+    BOOST_TEST_MESSAGE("Domain cache hits: " << hits << " of " << requirements.size() << " requirements");
+
+    templ::utils::Hash128 unknown;
+    unknown.update(std::string("unknown-signature"));
+    BOOST_REQUIRE_MESSAGE(!context.getExtensionalDomain(unknown, cached), "Unknown signature should miss the cache");
+}
+
+BOOST_AUTO_TEST_CASE(portfolio)
+{
+    using namespace templ::solvers::csp;
+
+    qxcfg::Configuration configuration;
+    configuration.setValue("TransportNetwork/search/options/portfolio/assets", "5");
+    configuration.setValue("TransportNetwork/search/options/portfolio/seed", "10");
+    configuration.setValue("TransportNetwork/search/options/portfolio/afc-decay-step", "0.1");
+    configuration.setValue("TransportNetwork/search/options/timeline-brancher/afc-decay", "0.7");
+
+    Portfolio::Ptr portfolio = make_shared<Portfolio>(configuration);
+    BOOST_REQUIRE_MESSAGE(portfolio->getNumberOfAssets() == 5, "Portfolio should have 5 assets");
+
+    // The first asset corresponds to the single engine search
+    const Portfolio::AssetConfiguration& first = portfolio->getAssetConfiguration(0);
+    BOOST_REQUIRE_MESSAGE(first.seed == 10, "First asset should use the configured seed");
+    BOOST_REQUIRE_CLOSE(first.timelineAfcDecay, 0.7, 1E-06);
+    BOOST_REQUIRE_MESSAGE(first.cutoffType == Portfolio::GEOMETRIC, "First asset should use the geometric cutoff");
+
+    std::set<unsigned int> seeds;
+    for(size_t asset = 0; asset < portfolio->getNumberOfAssets(); ++asset)
+    {
+        const Portfolio::AssetConfiguration& assetConfiguration = portfolio->getAssetConfiguration(asset);
+        seeds.insert(assetConfiguration.seed);
+        BOOST_REQUIRE_MESSAGE(assetConfiguration.timelineAfcDecay >= 0.5, "AFC decay should be bounded by 0.5");
+        BOOST_REQUIRE_MESSAGE(assetConfiguration.cutoffType == static_cast<Portfolio::CutoffType>(asset % Portfolio::END_CUTOFF_TYPE),
+                "Assets should cycle through the cutoff types");
+        delete portfolio->createCutoff(asset, 10);
+    }
+    BOOST_REQUIRE_MESSAGE(seeds.size() == portfolio->getNumberOfAssets(), "Assets should use different seeds");
+    BOOST_REQUIRE_CLOSE(portfolio->getAssetConfiguration(4).timelineAfcDecay, 0.5, 1E-06);
+    BOOST_REQUIRE_THROW(portfolio->getAssetConfiguration(5), std::invalid_argument);
+
+    // The incumbent cost is the minimum reported by any asset
+    std::vector<std::thread> assets;
+    for(int asset = 0; asset < 5; ++asset)
+    {
+        assets.push_back(std::thread([portfolio, asset]()
+                    {
+                        for(int cost = 100; cost >= 10 + asset; --cost)
+                        {
+                            portfolio->updateIncumbentCost(cost);
+                            portfolio->incrementFlowEvaluations(asset);
+                        }
+                    }));
+    }
+    for(std::thread& t : assets)
+    {
+        t.join();
+    }
+    BOOST_REQUIRE_MESSAGE(portfolio->getIncumbentCost() == 10, "Incumbent cost should be 10, but was " << portfolio->getIncumbentCost());
+    BOOST_REQUIRE_MESSAGE(!portfolio->updateIncumbentCost(11), "Higher cost should not update the incumbent");
+    BOOST_REQUIRE_MESSAGE(portfolio->getStatistics(4).flowEvaluations == 87, "Statistics should be counted per asset");
+
+    // Termination stops all assets, while a reset keeps the incumbent
+    Gecode::Search::Statistics statistics;
+    Gecode::Search::Options options;
+    Portfolio::Stop stop(portfolio, 1E06);
+    BOOST_REQUIRE_MESSAGE(!stop.stop(statistics, options), "Portfolio should not be stopped initially");
+    portfolio->terminate();
+    BOOST_REQUIRE_MESSAGE(stop.stop(statistics, options), "Terminated portfolio should stop all assets");
+    portfolio->reset();
+    BOOST_REQUIRE_MESSAGE(!stop.stop(statistics, options), "Reset portfolio should not stop");
+    BOOST_REQUIRE_MESSAGE(portfolio->getIncumbentCost() == 10, "Reset should keep the incumbent cost");
+}
+
+BOOST_AUTO_TEST_CASE(flow_solution_cache)
+{
+    using namespace templ::solvers::csp;
+
+    FlowSolutionCache cache(templ::symbols::constants::Location::PtrList(),
+            templ::solvers::temporal::point_algebra::TimePoint::PtrList(), 4, 2);
+    std::vector<FlowSolutionCache::Key> keys;
+    for(uint64_t i = 0; i < 8; ++i)
+    {
+        FlowSolutionCache::Key key;
+        key.update(i);
+        keys.push_back(key);
+    }
+    BOOST_REQUIRE_MESSAGE(!(keys[0] == keys[1]), "Keys of different content should differ");
+
+    BOOST_REQUIRE_MESSAGE(!cache.get(keys[0]), "Empty cache should not return a solution");
+    BOOST_REQUIRE_MESSAGE(cache.getMisses() == 1, "Cache miss should be counted");
+
+    FlowSolutionCache::ValuePtr value = make_shared<FlowSolutionCache::Value>();
+    cache.put(keys[0], value);
+    FlowSolutionCache::ValuePtr cachedValue = cache.get(keys[0]);
+    BOOST_REQUIRE_MESSAGE(cachedValue, "Cache should return stored solution");
+    BOOST_REQUIRE_MESSAGE(cache.getHits() == 1, "Cache hit should be counted");
+    BOOST_REQUIRE_MESSAGE(cachedValue->second.getGraph() != value->second.getGraph(),
+            "Cache should not share the network graph with the stored solution");
+    BOOST_REQUIRE_MESSAGE(cache.get(keys[0])->second.getGraph() != cachedValue->second.getGraph(),
+            "Cache should not share the network graph between hits");
+
+    for(const FlowSolutionCache::Key& key : keys)
+    {
+        cache.put(key, make_shared<FlowSolutionCache::Value>());
+    }
+    BOOST_REQUIRE_MESSAGE(cache.size() <= 4, "Cache should be bounded to 4 entries, but contains " << cache.size());
+    BOOST_REQUIRE_MESSAGE(cache.getEvictions() > 0, "Cache should evict entries");
+
+    cache.clear();
+    BOOST_REQUIRE_MESSAGE(cache.size() == 0, "Cache should be empty after clear");
+
+    // The size bound is split exactly between the shards
+    FlowSolutionCache shardedCache(templ::symbols::constants::Location::PtrList(),
+            templ::solvers::temporal::point_algebra::TimePoint::PtrList(), 5, 16);
+    for(uint64_t i = 0; i < 200; ++i)
+    {
+        FlowSolutionCache::Key key;
+        key.update(i);
+        shardedCache.put(key, make_shared<FlowSolutionCache::Value>());
+    }
+    BOOST_REQUIRE_MESSAGE(shardedCache.size() <= 5, "Cache should be bounded to 5 entries, but contains " << shardedCache.size());
+}
+
+BOOST_AUTO_TEST_CASE(coalition_feasibility_cache)
+{
+    using namespace templ::solvers;
+
+    CoalitionFeasibilityCache& cache = CoalitionFeasibilityCache::getInstance();
+    cache.clear();
+
+    CoalitionFeasibilityCache::Key feasibleKey(1,1);
+    CoalitionFeasibilityCache::Result feasible;
+    feasible.status = CoalitionFeasibilityCache::FEASIBLE;
+    feasible.timeoutInMs = 1000;
+    ModelPool coalition;
+    coalition[vocabulary::OM::resolve("Sherpa")] = 1;
+    coalition[vocabulary::OM::resolve("CREX")] = 2;
+    feasible.coalitionStructure.push_back(coalition);
+    cache.put(feasibleKey, feasible);
+
+    CoalitionFeasibilityCache::Key timeoutKey(2,2);
+    CoalitionFeasibilityCache::Result timeout;
+    timeout.status = CoalitionFeasibilityCache::TIMEOUT;
+    timeout.timeoutInMs = 1000;
+    cache.put(timeoutKey, timeout);
+
+    CoalitionFeasibilityCache::Result result;
+    BOOST_REQUIRE_MESSAGE(cache.get(feasibleKey, 5000, result), "Feasible result should be reused for any timeout");
+    BOOST_REQUIRE_MESSAGE(result.coalitionStructure.size() == 1, "Coalition structure should be cached");
+    BOOST_REQUIRE_MESSAGE(cache.get(timeoutKey, 500, result), "Timeout should be reused for a shorter timeout");
+    BOOST_REQUIRE_MESSAGE(!cache.get(timeoutKey, 5000, result), "Timeout should not be reused for a longer timeout");
+
+    std::string filename = "/tmp/templ-test-coalition-feasibility-cache.txt";
+    cache.save(filename);
+    cache.clear();
+    BOOST_REQUIRE_MESSAGE(cache.size() == 0, "Cache should be empty after clear");
+
+    cache.load(filename);
+    BOOST_REQUIRE_MESSAGE(cache.size() == 2, "Cache should contain 2 entries after loading, but contains " << cache.size());
+    BOOST_REQUIRE_MESSAGE(cache.get(feasibleKey, 1000, result), "Loaded result should be available");
+    BOOST_REQUIRE_MESSAGE(result.status == CoalitionFeasibilityCache::FEASIBLE, "Loaded result should be feasible");
+    BOOST_REQUIRE_MESSAGE(result.coalitionStructure.size() == 1 && result.coalitionStructure.front() == coalition,
+            "Loaded coalition structure should be identical");
+    cache.clear();
 }
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -81,6 +81,37 @@ BOOST_AUTO_TEST_CASE(sorting)
     }
 }
 
+BOOST_AUTO_TEST_CASE(indices)
+{
+    std::string rootDir = getRootDir();
+    std::string missionFilename = rootDir + "/test/data/scenarios/test-mission-ftrs-0.xml";
+
+    Mission m = io::MissionReader::fromFile(missionFilename);
+    Mission::Ptr mission(new Mission(m));
+    mission->prepareTimeIntervals();
+
+    FluentTimeResource::List requirements = Mission::getResourceRequirements(mission);
+    BOOST_REQUIRE_MESSAGE(!requirements.empty(), "Mission has requirements");
+    for(size_t i = 0; i < requirements.size(); ++i)
+    {
+        BOOST_REQUIRE_EQUAL(requirements[i].getRequirementIdx(), i);
+        BOOST_REQUIRE_EQUAL(FluentTimeResource::getIndex(requirements, requirements[i]), i);
+    }
+
+    mission->getTemporalConstraintNetwork()->isConsistent();
+    TimePointComparator tpc(mission->getTemporalConstraintNetwork());
+    FluentTimeResource::List sorted = requirements;
+    FluentTimeResource::sortForEarlierEnd(sorted, tpc);
+    for(size_t i = 0; i < sorted.size(); ++i)
+    {
+        const FluentTimeResource& ftr = sorted[i];
+        BOOST_REQUIRE_EQUAL(FluentTimeResource::getIndex(requirements, ftr), ftr.getRequirementIdx());
+        // requirement index does not apply to the sorted list, so that the
+        // index has to be resolved by search
+        BOOST_REQUIRE_EQUAL(FluentTimeResource::getIndex(sorted, ftr), i);
+    }
+}
+
 BOOST_AUTO_TEST_CASE(overlapping)
 {
     std::string rootDir = getRootDir();
@@ -218,6 +249,68 @@ BOOST_AUTO_TEST_CASE(mutually_exclusive)
             << "actual: " << ssActual.str());
 }
 
+BOOST_AUTO_TEST_CASE(maximal_mutually_exclusive)
+{
+    std::string rootDir = getRootDir();
+    std::string missionFilename = rootDir + "/test/data/scenarios/test-mission-ftrs-0.xml";
+
+    Mission m = io::MissionReader::fromFile(missionFilename);
+    Mission::Ptr mission = make_shared<Mission>(m);
+    mission->prepareTimeIntervals();
+
+    FluentTimeResource::List requirements = Mission::getResourceRequirements(mission);
+    mission->getTemporalConstraintNetwork()->isConsistent();
+
+    TimePointComparator tpc(mission->getTemporalConstraintNetwork());
+
+    TimePoint::Ptr t1 = TimePoint::create("t1");
+    TimePoint::Ptr t2 = TimePoint::create("t2");
+    TimePoint::Ptr t3 = TimePoint::create("t3");
+    TimePoint::Ptr t4 = TimePoint::create("t4");
+    TimePoint::Ptr t5 = TimePoint::create("t5");
+    TimePoint::Ptr t6 = TimePoint::create("t6");
+    TimePoint::Ptr t7 = TimePoint::create("t7");
+    TimePoint::PtrList sortedTimepoints = { t1,t2,t3,t4,t5,t6,t7 };
+
+    Interval i0(t1,t3, tpc);
+    Interval i1(t1,t7, tpc);
+    Interval i2(t2,t4, tpc);
+    Interval i3(t5,t6, tpc);
+    Interval i4(t6,t7, tpc);
+
+    std::vector<Interval::List> expected = { { i0,i1,i2 }, { i1,i3,i4 } };
+
+    std::vector<Interval::List> actual;
+    std::vector<FluentTimeResource::List> mutuallyExclusiveSets =
+        FluentTimeResource::getMaximalMutualExclusive(requirements, sortedTimepoints, tpc);
+    for(FluentTimeResource::List concurrent : mutuallyExclusiveSets)
+    {
+        FluentTimeResource::sortForEarlierStart(concurrent, tpc);
+        Interval::List concurrentIntervals;
+        for(const FluentTimeResource& ftr : concurrent)
+        {
+            concurrentIntervals.push_back(ftr.getInterval());
+        }
+        actual.push_back(concurrentIntervals);
+    }
+
+    BOOST_REQUIRE_MESSAGE(expected == actual, "Maximal sets of concurrent intervals match expected");
+
+    // lander, base1 and base2
+    std::vector<FluentTimeResource::List> locationGroups = FluentTimeResource::groupByLocation(requirements);
+    BOOST_REQUIRE_MESSAGE(locationGroups.size() == 3, "Expected 3 location groups, but was " << locationGroups.size());
+    size_t numberOfRequirements = 0;
+    for(const FluentTimeResource::List& group : locationGroups)
+    {
+        numberOfRequirements += group.size();
+        for(const FluentTimeResource& ftr : group)
+        {
+            BOOST_REQUIRE_MESSAGE(ftr.getLocation() == group.front().getLocation(), "Requirements of a group share the location");
+        }
+    }
+    BOOST_REQUIRE_MESSAGE(numberOfRequirements == requirements.size(), "Each requirement is part of one group");
+}
+
 BOOST_AUTO_TEST_CASE(domain)
 {
     ModelPool modelPool;
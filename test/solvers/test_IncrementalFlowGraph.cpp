@@ -0,0 +1,185 @@
+#include <boost/test/unit_test.hpp>
+#include <limits>
+#include <templ/solvers/transshipment/IncrementalFlowGraph.hpp>
+#include <templ/solvers/temporal/point_algebra/QualitativeTimePoint.hpp>
+
+using namespace templ;
+using namespace templ::solvers::transshipment;
+using namespace graph_analysis::algorithms;
+namespace pa = templ::solvers::temporal::point_algebra;
+
+struct FlowEdge
+{
+    size_t source;
+    size_t target;
+    double cost;
+    uint32_t capacity;
+};
+
+struct FlowRound
+{
+    std::vector<FlowEdge> edges;
+    /// point index and min transflow for all commodities
+    std::vector< std::pair<size_t, uint32_t> > minTransFlows;
+    LPSolver::Status expectedStatus;
+    double expectedCost;
+};
+
+struct IncrementalFlowGraphSetup
+{
+    IncrementalFlowGraphSetup()
+    {
+        using namespace ::templ::symbols;
+        for(size_t t = 0; t < 3; ++t)
+        {
+            pa::TimePoint::Ptr timepoint = pa::QualitativeTimePoint::getInstance("t" + std::to_string(t));
+            for(size_t l = 0; l < 2; ++l)
+            {
+                if(t == 0)
+                {
+                    locations.push_back(make_shared<constants::Location>("loc" + std::to_string(l), base::Point(l,0,0)));
+                }
+                points.push_back(SpaceTime::Point(locations[l], timepoint));
+            }
+        }
+        commodities.push_back(Role(0, "http://model/instance#"));
+        commodities.push_back(Role(1, "http://model/instance#"));
+    }
+
+    /**
+     * Apply a round to the flow graph and solve it
+     * (point index: timepoint*2 + location)
+     */
+    LPSolver::Status apply(IncrementalFlowGraph& flowGraph, const FlowRound& round) const
+    {
+        flowGraph.beginUpdate(commodities, std::set<SpaceTime::Point>(points.begin(), points.end()));
+        std::vector<IncrementalFlowGraph::vertex_t::Ptr> vertices;
+        for(const SpaceTime::Point& point : points)
+        {
+            vertices.push_back(flowGraph.getVertex(point, point.first->getInstanceName()));
+        }
+        for(size_t c = 0; c < commodities.size(); ++c)
+        {
+            flowGraph.setCommoditySupply(vertices.front(), c, 1);
+            flowGraph.setCommoditySupply(vertices.back(), c, -1);
+            for(const std::pair<size_t, uint32_t>& minTransFlow : round.minTransFlows)
+            {
+                flowGraph.setCommodityMinTransFlow(vertices[minTransFlow.first], c, minTransFlow.second);
+            }
+        }
+        for(const FlowEdge& e : round.edges)
+        {
+            IncrementalFlowGraph::edge_t::Ptr edge = flowGraph.getEdge(points[e.source], points[e.target]);
+            flowGraph.setCapacityUpperBound(edge, e.capacity);
+            for(size_t c = 0; c < commodities.size(); ++c)
+            {
+                flowGraph.setCommodityCapacityUpperBound(edge, c, std::numeric_limits<uint32_t>::max());
+                flowGraph.setCommodityCost(edge, c, e.cost);
+            }
+        }
+        flowGraph.endUpdate();
+        return flowGraph.solve();
+    }
+
+    /**
+     * Compute the cost of the flow which is set on the edges of a graph
+     */
+    static double getFlowCost(const graph_analysis::BaseGraph::Ptr& graph, size_t numberOfCommodities)
+    {
+        double cost = 0;
+        graph_analysis::EdgeIterator::Ptr edgeIt = graph->getEdgeIterator();
+        while(edgeIt->next())
+        {
+            IncrementalFlowGraph::edge_t::Ptr edge = dynamic_pointer_cast<IncrementalFlowGraph::edge_t>(edgeIt->current());
+            for(size_t c = 0; c < numberOfCommodities; ++c)
+            {
+                cost += edge->getCommodityFlow(c)*edge->getCommodityCost(c);
+            }
+        }
+        return cost;
+    }
+
+    symbols::constants::Location::PtrList locations;
+    std::vector<SpaceTime::Point> points;
+    std::vector<Role> commodities;
+};
+
+BOOST_FIXTURE_TEST_SUITE(transshipment_incremental_flow_graph, IncrementalFlowGraphSetup)
+
+BOOST_AUTO_TEST_CASE(incremental_vs_from_scratch)
+{
+    uint32_t unbounded = std::numeric_limits<uint32_t>::max();
+    std::vector<FlowEdge> waits = { {0,2,1,unbounded}, {2,4,1,unbounded}, {1,3,1,unbounded}, {3,5,1,unbounded} };
+    FlowEdge move03 = {0,3,3,unbounded};
+    FlowEdge move25 = {2,5,2,unbounded};
+    FlowEdge limitedMove25 = {2,5,2,1};
+
+    std::vector<FlowRound> rounds;
+    {
+        // both commodities: (l0,t0) -> (l0,t1) -> (l1,t2)
+        FlowRound round = { waits, {}, LPSolver::STATUS_OPTIMAL, 6 };
+        round.edges.push_back(move03);
+        round.edges.push_back(move25);
+        rounds.push_back(round);
+    }
+    {
+        // joint capacity forces one commodity onto the more expensive path
+        FlowRound round = { waits, {}, LPSolver::STATUS_OPTIMAL, 7 };
+        round.edges.push_back(move03);
+        round.edges.push_back(limitedMove25);
+        rounds.push_back(round);
+    }
+    {
+        // removed edge
+        FlowRound round = { waits, {}, LPSolver::STATUS_OPTIMAL, 8 };
+        round.edges.push_back(move03);
+        rounds.push_back(round);
+    }
+    {
+        // no transition left
+        FlowRound round = { waits, {}, LPSolver::STATUS_INFEASIBLE, 0 };
+        rounds.push_back(round);
+    }
+    {
+        // re-added edges, but passing (l1,t1) is required
+        FlowRound round = { waits, { {3,1} }, LPSolver::STATUS_OPTIMAL, 8 };
+        round.edges.push_back(move03);
+        round.edges.push_back(move25);
+        rounds.push_back(round);
+    }
+    rounds.push_back(rounds.front());
+
+    IncrementalFlowGraph incremental;
+    for(size_t r = 0; r < rounds.size(); ++r)
+    {
+        const FlowRound& round = rounds[r];
+        LPSolver::Status incrementalStatus = apply(incremental, round);
+
+        IncrementalFlowGraph fromScratch;
+        LPSolver::Status fromScratchStatus = apply(fromScratch, round);
+
+        BOOST_REQUIRE_MESSAGE(incrementalStatus == fromScratchStatus, "Round " << r << ": incremental status "
+                << incrementalStatus << " vs. from scratch " << fromScratchStatus);
+        BOOST_REQUIRE_MESSAGE(incrementalStatus == round.expectedStatus, "Round " << r << ": expected status "
+                << round.expectedStatus << " got " << incrementalStatus);
+        BOOST_REQUIRE_CLOSE(incremental.getObjectiveValue(), fromScratch.getObjectiveValue(), 1E-06);
+        BOOST_REQUIRE_CLOSE(incremental.getObjectiveValue(), round.expectedCost, 1E-06);
+        BOOST_REQUIRE_CLOSE(getFlowCost(incremental.getGraph(), commodities.size()), round.expectedCost, 1E-06);
+        BOOST_REQUIRE_MESSAGE(incremental.validateInflow().empty() == (round.expectedStatus == LPSolver::STATUS_OPTIMAL),
+                "Round " << r << ": flow should be valid if and only if an optimal solution has been found");
+
+        // The graph_analysis LP from scratch has to agree on the optimal cost
+        if(round.expectedStatus == LPSolver::STATUS_OPTIMAL)
+        {
+            MultiCommodityMinCostFlow minCostFlow(fromScratch.getGraph(), commodities.size(), LPSolver::GLPK_SOLVER);
+            LPSolver::Status status = minCostFlow.solve("");
+            BOOST_REQUIRE_MESSAGE(status == LPSolver::STATUS_OPTIMAL || status == LPSolver::SOLUTION_FOUND,
+                    "Round " << r << ": from scratch LP should be solved");
+            BOOST_REQUIRE_CLOSE(getFlowCost(fromScratch.getGraph(), commodities.size()), round.expectedCost, 1E-06);
+        }
+    }
+    BOOST_REQUIRE_MESSAGE(incremental.getNumberOfResets() == 1, "Flow graph should only be built once, but was reset "
+            << incremental.getNumberOfResets() << " times");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,213 @@
+#include <boost/test/unit_test.hpp>
+#include "../../src/solvers/csp/Types.hpp"
+#include "../../src/solvers/csp/propagators/MultiCommodityFlow.hpp"
+#include <gecode/search.hh>
+#include <gecode/minimodel.hh>
+
+using namespace templ::solvers::csp;
+
+class TestMultiCommodityFlow : public Gecode::Space
+{
+    uint32_t mNumberOfTimepoints;
+    uint32_t mNumberOfFluents;
+    uint32_t mNumberOfVertices;
+
+    std::vector<int> mSupplyDemand;
+
+public:
+    templ::solvers::csp::ListOfAdjacencyLists mTimelines;
+
+    TestMultiCommodityFlow(size_t numberOfTimepoints, size_t numberOfFluents, const std::vector<int>& supplyDemand, bool usePropagator = true)
+        : Gecode::Space()
+        , mNumberOfTimepoints(numberOfTimepoints)
+        , mNumberOfFluents(numberOfFluents)
+        , mNumberOfVertices(numberOfTimepoints*numberOfFluents)
+        , mSupplyDemand(supplyDemand)
+    {
+        for(size_t r = 0; r < mSupplyDemand.size(); ++r)
+        {
+            Gecode::SetVarArray timeline(*this, mNumberOfVertices, Gecode::IntSet::empty, Gecode::IntSet(0,mNumberOfVertices-1), 0, 1);
+            for(size_t t = 0; t < mNumberOfTimepoints; ++t)
+            {
+                for(size_t l = 0; l < mNumberOfFluents; ++l)
+                {
+                    // only edges to the next timestep
+                    Gecode::Set::SetView v(timeline[t*mNumberOfFluents + l]);
+                    v.exclude(*this, 0, (t+1)*mNumberOfFluents - 1);
+                    v.exclude(*this, (t+2)*mNumberOfFluents, mNumberOfVertices);
+                }
+            }
+            mTimelines.push_back(timeline);
+        }
+
+        if(usePropagator)
+        {
+            propagators::multiCommodityFlow(*this, mSupplyDemand, mTimelines, mNumberOfTimepoints, mNumberOfFluents);
+        }
+
+        for(size_t r = 0; r < mTimelines.size(); ++r)
+        {
+            branch(*this, mTimelines[r], Gecode::SET_VAR_NONE(), Gecode::SET_VAL_MIN_INC());
+        }
+    }
+
+    TestMultiCommodityFlow(TestMultiCommodityFlow& other)
+        : Gecode::Space(other)
+        , mNumberOfTimepoints(other.mNumberOfTimepoints)
+        , mNumberOfFluents(other.mNumberOfFluents)
+        , mNumberOfVertices(other.mNumberOfVertices)
+        , mSupplyDemand(other.mSupplyDemand)
+    {
+        for(size_t i = 0; i < other.mTimelines.size(); ++i)
+        {
+            AdjacencyList array;
+            mTimelines.push_back(array);
+            mTimelines[i].update(*this, other.mTimelines[i]);
+        }
+    }
+
+    virtual Gecode::Space* copy()
+    {
+        return new TestMultiCommodityFlow(*this);
+    }
+
+    void include(size_t role, size_t source, size_t target)
+    {
+        Gecode::Set::SetView v(mTimelines[role][source]);
+        v.include(*this, target);
+    }
+
+    /**
+     * Check the transport capacity for an assigned solution
+     */
+    bool isFeasible() const
+    {
+        std::map< std::pair<int,int>, int> edges;
+        for(size_t r = 0; r < mTimelines.size(); ++r)
+        {
+            for(size_t i = 0; i < mNumberOfVertices; ++i)
+            {
+                const Gecode::SetVar& var = mTimelines[r][i];
+                if(var.glbSize() == 1)
+                {
+                    Gecode::SetVarGlbValues value(var);
+                    edges[ std::pair<int,int>(i, value.val()) ] += mSupplyDemand[r];
+                }
+            }
+        }
+
+        for(const std::pair< std::pair<int,int>, int>& edge : edges)
+        {
+            bool isLocal = edge.first.second - edge.first.first == static_cast<int>(mNumberOfFluents);
+            if(!isLocal && edge.second < 0)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+BOOST_AUTO_TEST_SUITE(propagators_multi_commodity_flow)
+
+BOOST_AUTO_TEST_CASE(force_provider)
+{
+    // (t0,l0) -> (t1,l1) for the role requiring transport
+    std::vector<int> supplyDemand = { 1, -1 };
+    TestMultiCommodityFlow* space = new TestMultiCommodityFlow(2, 2, supplyDemand);
+    space->include(1, 0, 3);
+    BOOST_REQUIRE_MESSAGE(space->status() != Gecode::SS_FAILED, "Space should not fail");
+
+    const Gecode::SetVar& provider = space->mTimelines[0][0];
+    BOOST_REQUIRE_MESSAGE(provider.assigned() && provider.contains(3), "Provider should be forced onto the edge: " << provider);
+    delete space;
+}
+
+BOOST_AUTO_TEST_CASE(exclude_demand)
+{
+    // Provider remains at l0, so that the other role cannot move
+    std::vector<int> supplyDemand = { 1, -1 };
+    TestMultiCommodityFlow* space = new TestMultiCommodityFlow(2, 2, supplyDemand);
+    space->include(0, 0, 2);
+    BOOST_REQUIRE_MESSAGE(space->status() != Gecode::SS_FAILED, "Space should not fail");
+
+    const Gecode::SetVar& demand = space->mTimelines[1][0];
+    BOOST_REQUIRE_MESSAGE(demand.notContains(3), "Edge should be excluded: " << demand);
+    delete space;
+}
+
+BOOST_AUTO_TEST_CASE(insufficient_capacity)
+{
+    std::vector<int> supplyDemand = { 1, -1, -1 };
+    TestMultiCommodityFlow* space = new TestMultiCommodityFlow(2, 2, supplyDemand);
+    space->include(1, 0, 3);
+    space->include(2, 0, 3);
+    BOOST_REQUIRE_MESSAGE(space->status() == Gecode::SS_FAILED, "Space should fail due to insufficient capacity");
+    delete space;
+}
+
+BOOST_AUTO_TEST_CASE(early_failure_detection)
+{
+    // Provider moves elsewhere, while two roles require transport along
+    // (t0,l0) -> (t1,l1): only the propagator detects the dead end before
+    // the remaining timelines are branched
+    std::vector<int> supplyDemand = { 1, -1, -1 };
+    for(bool usePropagator : { false, true })
+    {
+        TestMultiCommodityFlow* space = new TestMultiCommodityFlow(2, 2, supplyDemand, usePropagator);
+        space->include(0, 0, 2);
+        space->include(1, 0, 3);
+        if(usePropagator)
+        {
+            BOOST_REQUIRE_MESSAGE(space->status() == Gecode::SS_FAILED, "Space should fail with propagator");
+            delete space;
+            continue;
+        }
+
+        BOOST_REQUIRE_MESSAGE(space->status() != Gecode::SS_FAILED, "Space should not fail without propagator");
+        Gecode::DFS<TestMultiCommodityFlow> search(space);
+        size_t solutions = 0;
+        while(TestMultiCommodityFlow* solution = search.next())
+        {
+            BOOST_REQUIRE_MESSAGE(!solution->isFeasible(), "No feasible completion expected");
+            ++solutions;
+            delete solution;
+        }
+        BOOST_REQUIRE_MESSAGE(solutions > 0, "Search without propagator should enumerate infeasible solutions");
+    }
+}
+
+BOOST_AUTO_TEST_CASE(solutions_match_feasible_assignments)
+{
+    std::vector< std::vector<int> > scenarios = { { 2, -1, -1, -1 }, { 1, -1, 1, -1 } };
+    for(const std::vector<int>& supplyDemand : scenarios)
+    {
+        size_t expected = 0;
+        {
+            Gecode::DFS<TestMultiCommodityFlow> search(new TestMultiCommodityFlow(2, 2, supplyDemand, false));
+            while(TestMultiCommodityFlow* solution = search.next())
+            {
+                if(solution->isFeasible())
+                {
+                    ++expected;
+                }
+                delete solution;
+            }
+        }
+
+        size_t found = 0;
+        {
+            Gecode::DFS<TestMultiCommodityFlow> search(new TestMultiCommodityFlow(2, 2, supplyDemand, true));
+            while(TestMultiCommodityFlow* solution = search.next())
+            {
+                BOOST_REQUIRE_MESSAGE(solution->isFeasible(), "Solution violates transport capacity");
+                ++found;
+                delete solution;
+            }
+        }
+        BOOST_REQUIRE_MESSAGE(expected > 0, "Expected feasible assignments");
+        BOOST_REQUIRE_MESSAGE(found == expected, "Expected " << expected << " solutions, found " << found);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -2,7 +2,11 @@
 #include <templ/Mission.hpp>
 #include <templ/io/MissionReader.hpp>
 #include <templ/solvers/csp/TransportNetwork.hpp>
+#include <templ/solvers/Reachability.hpp>
+#include <templ/solvers/temporal/IntervalConstraint.hpp>
+#include <templ/constraints/ModelConstraint.hpp>
 #include <moreorg/vocabularies/OM.hpp>
+#include <boost/filesystem.hpp>
 
 #include "../test_utils.hpp"
 
@@ -281,6 +285,211 @@ BOOST_FIXTURE_TEST_CASE(mission_2, TransportNetworkSetup)
     }
 }
 
+struct LocationSequenceSpace : public Gecode::Space
+{
+    solvers::csp::LocationSequence sequence;
+
+    /// The value numberOfLocations marks an inactive timepoint
+    LocationSequenceSpace(int numberOfTimepoints, int numberOfLocations)
+        : sequence(*this, numberOfTimepoints, 0, numberOfLocations)
+    {}
+
+    LocationSequenceSpace(LocationSequenceSpace& other)
+        : Gecode::Space(other)
+    {
+        sequence.update(*this, other.sequence);
+    }
+
+    Gecode::Space* copy() { return new LocationSequenceSpace(*this); }
+};
+
+BOOST_FIXTURE_TEST_CASE(timeline_encodings, TransportNetworkSetup)
+{
+    // The access constraints are posted as restrictInEdges for the
+    // adjacency-list encoding and as reified arrivals for the successor
+    // encoding -- both have to agree on feasibility and on the number of
+    // arrivals at the constrained location
+    owlapi::model::IRI organizationModelIRI = "http://www.rock-robotics.org/2015/12/projects/TransTerrA";
+    moreorg::OrganizationModel::Ptr om = moreorg::OrganizationModel::getInstance(organizationModelIRI);
+    owlapi::model::IRI location_image_provider = vocabulary::OM::resolve("ImageProvider");
+    owlapi::model::IRI sherpa = vocabulary::OM::resolve("Sherpa");
+
+    Mission baseMission(om);
+    baseMission.addResourceLocationCardinalityConstraint(l[0], t[0], t[1], location_image_provider);
+    baseMission.addResourceLocationCardinalityConstraint(l[1], t[2], t[3], location_image_provider);
+    baseMission.addConstraint(make_shared<pa::QualitativeTimePointConstraint>(t[1],t[2], pa::QualitativeTimePointConstraint::Less));
+    baseMission.prepareTimeIntervals();
+
+    pa::TimePointComparator comparator(baseMission.getTemporalConstraintNetwork());
+    solvers::temporal::Interval fullMission(SpaceTime::getHorizonStart(),
+            SpaceTime::getHorizonEnd(),
+            comparator);
+
+    using namespace templ::constraints;
+    std::vector< std::pair<ModelConstraint::Type, uint32_t> > accessConstraints =
+        { { ModelConstraint::MIN_ACCESS, 1 },
+          { ModelConstraint::MAX_ACCESS, 1 },
+          { ModelConstraint::MAX_ACCESS, 0 } };
+
+    for(const std::pair<ModelConstraint::Type, uint32_t>& access : accessConstraints)
+    {
+        std::map<std::string, size_t> feasible;
+        for(const std::string& encoding : { "adjacency-list", "successor" })
+        {
+            Mission::Ptr mission = make_shared<Mission>(baseMission);
+            moreorg::ModelPool modelPool;
+            modelPool[ sherpa ] = 1;
+            mission->setAvailableResources(modelPool);
+            mission->addConstraint(make_shared<ModelConstraint>(access.first, sherpa,
+                        SpaceTime::SpaceIntervalTuple(l[1], fullMission), access.second));
+
+            qxcfg::Configuration configuration;
+            configuration.setValue("TransportNetwork/search/options/timeline-encoding", encoding);
+
+            csp::TransportNetwork::SolutionList solutions;
+            try {
+                solutions = solvers::csp::TransportNetwork::solve(mission, 1, configuration);
+            } catch(const std::runtime_error& e)
+            {
+                BOOST_TEST_MESSAGE("No solution with encoding '" << encoding << "': " << e.what());
+            }
+            feasible[encoding] = solutions.size();
+
+            for(const csp::TransportNetwork::Solution& solution : solutions)
+            {
+                for(const std::pair<const Role, csp::RoleTimeline>& roleTimeline : solution.getTimelines())
+                {
+                    const SpaceTime::Timeline& timeline = roleTimeline.second.getTimeline();
+                    uint32_t arrivals = 0;
+                    for(size_t i = 1; i < timeline.size(); ++i)
+                    {
+                        if(timeline[i-1].first != l[1] && timeline[i].first == l[1])
+                        {
+                            ++arrivals;
+                        }
+                    }
+                    if(access.first == ModelConstraint::MIN_ACCESS)
+                    {
+                        BOOST_REQUIRE_MESSAGE(arrivals >= access.second, "Encoding '" << encoding << "': expected at least "
+                                << access.second << " arrivals, got " << arrivals);
+                    } else {
+                        BOOST_REQUIRE_MESSAGE(arrivals <= access.second, "Encoding '" << encoding << "': expected at most "
+                                << access.second << " arrivals, got " << arrivals);
+                    }
+                }
+            }
+        }
+        BOOST_REQUIRE_MESSAGE((feasible["adjacency-list"] > 0) == (feasible["successor"] > 0),
+                "Encodings disagree on feasibility for "
+                << ModelConstraint::TypeTxt[access.first] << " " << access.second);
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE(location_sequence_to_timeline, TransportNetworkSetup)
+{
+    using namespace solvers::csp;
+    pa::TimePoint::PtrList timepoints = { t[0], t[1], t[2], t[3] };
+    symbols::constants::Location::PtrList locations = { l[0], l[1] };
+
+    LocationSequenceSpace space(timepoints.size(), locations.size());
+    rel(space, space.sequence[0], Gecode::IRT_EQ, 1);
+    rel(space, space.sequence[1], Gecode::IRT_EQ, 1);
+    rel(space, space.sequence[2], Gecode::IRT_EQ, 0);
+    BOOST_REQUIRE(space.status() != Gecode::SS_FAILED);
+
+    // unassigned variables are not skipped
+    BOOST_REQUIRE_THROW(TypeConversion::toTimeline(space.sequence, locations, timepoints), std::invalid_argument);
+
+    // inactive timepoints are not part of the timeline
+    rel(space, space.sequence[3], Gecode::IRT_EQ, static_cast<int>(locations.size()));
+    BOOST_REQUIRE(space.status() != Gecode::SS_FAILED);
+    SpaceTime::Timeline timeline = TypeConversion::toTimeline(space.sequence, locations, timepoints);
+    BOOST_REQUIRE_EQUAL(timeline.size(), 3u);
+    BOOST_REQUIRE(timeline[0] == SpaceTime::Point(l[1], t[0]));
+    BOOST_REQUIRE(timeline[1] == SpaceTime::Point(l[1], t[1]));
+    BOOST_REQUIRE(timeline[2] == SpaceTime::Point(l[0], t[2]));
+
+    std::vector<int> sequence = { 2, 0, 2, 1 };
+    timeline = TypeConversion::toTimeline(sequence, locations, timepoints);
+    BOOST_REQUIRE_EQUAL(timeline.size(), 2u);
+    BOOST_REQUIRE(timeline[0] == SpaceTime::Point(l[0], t[1]));
+    BOOST_REQUIRE(timeline[1] == SpaceTime::Point(l[1], t[3]));
+
+    sequence = { 0, 3 };
+    BOOST_REQUIRE_THROW(TypeConversion::toTimeline(sequence, locations, timepoints), std::invalid_argument);
+}
+
+BOOST_FIXTURE_TEST_CASE(reachability, TransportNetworkSetup)
+{
+    using namespace solvers;
+    using namespace solvers::temporal;
+    pa::TimePoint::PtrList timepoints = { t[0], t[1], t[2], t[3] };
+
+    IntervalConstraint::Ptr ic0 = make_shared<IntervalConstraint>(t[0], t[2]);
+    ic0->addInterval(Bounds(0, 100));
+    IntervalConstraint::Ptr ic1 = make_shared<IntervalConstraint>(t[1], t[2]);
+    ic1->addInterval(Bounds(10, 50));
+    Constraint::PtrList constraints = { ic0, ic1 };
+
+    Reachability reachability(timepoints, constraints);
+    BOOST_REQUIRE(reachability.isBounded());
+    BOOST_REQUIRE_EQUAL(reachability.getMaxStepDuration(0), 100);
+    BOOST_REQUIRE_EQUAL(reachability.getMaxStepDuration(1), 50);
+    BOOST_REQUIRE(!reachability.isBounded(2));
+
+    Reachability::TravelTimes travelTimes = { 0, 60, 60, 0 };
+    BOOST_REQUIRE(reachability.isReachable(travelTimes, 2, 0, 0, 1));
+    BOOST_REQUIRE(!reachability.isReachable(travelTimes, 2, 1, 0, 1));
+    BOOST_REQUIRE(reachability.isReachable(travelTimes, 2, 1, 1, 1));
+    BOOST_REQUIRE(reachability.isReachable(travelTimes, 2, 2, 1, 0));
+
+    Reachability unbounded(timepoints, Constraint::PtrList());
+    BOOST_REQUIRE(!unbounded.isBounded());
+}
+
+BOOST_FIXTURE_TEST_CASE(timepoint_merging, TransportNetworkSetup)
+{
+    using namespace solvers;
+    using namespace solvers::temporal;
+    pa::TimePoint::PtrList timepoints = { t[0], t[1], t[2], t[3], t[4], t[5], t[6], t[7], t[8] };
+
+    Constraint::PtrList constraints;
+    constraints.push_back(make_shared<pa::QualitativeTimePointConstraint>(t[0], t[1], pa::QualitativeTimePointConstraint::Equal));
+    constraints.push_back(make_shared<pa::QualitativeTimePointConstraint>(t[2], t[3], pa::QualitativeTimePointConstraint::LessOrEqual));
+    constraints.push_back(make_shared<pa::QualitativeTimePointConstraint>(t[2], t[3], pa::QualitativeTimePointConstraint::GreaterOrEqual));
+    constraints.push_back(make_shared<pa::QualitativeTimePointConstraint>(t[3], t[4], pa::QualitativeTimePointConstraint::Less));
+    // cycle of LessOrEqual constraints
+    constraints.push_back(make_shared<pa::QualitativeTimePointConstraint>(t[5], t[6], pa::QualitativeTimePointConstraint::LessOrEqual));
+    constraints.push_back(make_shared<pa::QualitativeTimePointConstraint>(t[6], t[7], pa::QualitativeTimePointConstraint::LessOrEqual));
+    constraints.push_back(make_shared<pa::QualitativeTimePointConstraint>(t[7], t[5], pa::QualitativeTimePointConstraint::LessOrEqual));
+    // timepoints of interval constraints are used
+    IntervalConstraint::Ptr ic = make_shared<IntervalConstraint>(t[7], t[8]);
+    ic->addInterval(Bounds(0, 100));
+    constraints.push_back(ic);
+
+    std::vector<Interval> intervals = { Interval(t[1], t[3], pa::TimePointComparator()) };
+
+    {
+        std::map<pa::TimePoint::Ptr, pa::TimePoint::Ptr> layers = csp::Context::mergeTimepoints(timepoints, constraints, intervals, false);
+        BOOST_REQUIRE(layers[t[0]] == t[1]);
+        BOOST_REQUIRE(layers[t[1]] == t[1]);
+        BOOST_REQUIRE(layers[t[2]] == t[3]);
+        BOOST_REQUIRE(layers[t[3]] == t[3]);
+        BOOST_REQUIRE(layers[t[4]] == t[4]);
+        BOOST_REQUIRE(layers[t[5]] == t[7]);
+        BOOST_REQUIRE(layers[t[6]] == t[7]);
+        BOOST_REQUIRE(layers[t[7]] == t[7]);
+    }
+    {
+        std::map<pa::TimePoint::Ptr, pa::TimePoint::Ptr> layers = csp::Context::mergeTimepoints(timepoints, constraints, intervals, true);
+        BOOST_REQUIRE(layers[t[0]] == t[1]);
+        BOOST_REQUIRE(layers[t[2]] == t[3]);
+        BOOST_REQUIRE(!layers[t[4]]);
+        BOOST_REQUIRE(layers[t[5]] == t[7]);
+        BOOST_REQUIRE(layers[t[8]] == t[8]);
+    }
+}
+
 BOOST_AUTO_TEST_CASE(mission_from_file)
 {
     moreorg::OrganizationModel::Ptr om = moreorg::OrganizationModel::getInstance(owlapi::model::IRI("http://www.rock-robotics.org/2015/12/projects/TransTerrA"));
@@ -296,6 +505,83 @@ BOOST_AUTO_TEST_CASE(mission_from_file)
 }
 
 
+BOOST_AUTO_TEST_CASE(mission_from_file_transport_capacity_propagation)
+{
+    moreorg::OrganizationModel::Ptr om = moreorg::OrganizationModel::getInstance(owlapi::model::IRI("http://www.rock-robotics.org/2015/12/projects/TransTerrA"));
+    std::string missionFilename = getRootDir() + "test/data/scenarios/should_succeed/0.xml";
+    Mission baseMission = templ::io::MissionReader::fromFile(missionFilename, om);
+    baseMission.prepareTimeIntervals();
+
+    using namespace solvers;
+    for(const std::string& propagation : { "false", "true" })
+    {
+        qxcfg::Configuration configuration;
+        configuration.setValue("TransportNetwork/search/options/transport-capacity-propagation", propagation);
+
+        Mission::Ptr mission = make_shared<Mission>(baseMission);
+        csp::TransportNetwork::SolutionList solutions = csp::TransportNetwork::solve(mission, 1, configuration);
+        BOOST_REQUIRE_MESSAGE(!solutions.empty(), "Solution found with transport-capacity-propagation: " << propagation);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(mission_from_file_portfolio)
+{
+    moreorg::OrganizationModel::Ptr om = moreorg::OrganizationModel::getInstance(owlapi::model::IRI("http://www.rock-robotics.org/2015/12/projects/TransTerrA"));
+    std::string missionFilename = getRootDir() + "test/data/scenarios/should_succeed/0.xml";
+    Mission baseMission = templ::io::MissionReader::fromFile(missionFilename, om);
+    baseMission.prepareTimeIntervals();
+
+    // A sequential (threads: 1) and a parallel portfolio
+    for(const std::string& threads : { "1", "4" })
+    {
+        qxcfg::Configuration configuration;
+        configuration.setValue("TransportNetwork/search/options/portfolio/assets", "4");
+        configuration.setValue("TransportNetwork/search/options/portfolio/seed", "1");
+        configuration.setValue("TransportNetwork/search/options/threads", threads);
+
+        Mission::Ptr mission = make_shared<Mission>(baseMission);
+        solvers::csp::TransportNetwork::SolutionList solutions = solvers::csp::TransportNetwork::solve(mission, 1, configuration);
+        BOOST_REQUIRE_MESSAGE(!solutions.empty(), "Portfolio search with " << threads << " threads should find a solution");
+    }
+}
+
+BOOST_AUTO_TEST_CASE(mission_from_file_without_artifacts)
+{
+    moreorg::OrganizationModel::Ptr om = moreorg::OrganizationModel::getInstance(owlapi::model::IRI("http://www.rock-robotics.org/2015/12/projects/TransTerrA"));
+    std::string missionFilename = getRootDir() + "test/data/scenarios/should_succeed/0.xml";
+    Mission baseMission = templ::io::MissionReader::fromFile(missionFilename, om);
+    baseMission.prepareTimeIntervals();
+
+    std::stringstream baseDir;
+    baseDir << "/tmp/templ-test-transport-network-no-artifacts-" << base::Time::now().toMicroseconds();
+
+    qxcfg::Configuration configuration;
+    configuration.setValue("TransportNetwork/logging/basedir", baseDir.str());
+    configuration.setValue("TransportNetwork/logging/artifacts", "none");
+
+    Mission::Ptr mission = make_shared<Mission>(baseMission);
+    solvers::csp::TransportNetwork::SolutionList solutions = solvers::csp::TransportNetwork::solve(mission, 1, configuration);
+    BOOST_REQUIRE_MESSAGE(!solutions.empty(), "Solution should be found without artifacts");
+
+    // Only the search statistics are logged
+    std::set<std::string> artifactExtensions = { ".gexf", ".dot", ".lp", ".status" };
+    if(boost::filesystem::exists(baseDir.str()))
+    {
+        boost::filesystem::recursive_directory_iterator it(baseDir.str()), end;
+        for(; it != end; ++it)
+        {
+            if(boost::filesystem::is_regular_file(it->path()))
+            {
+                std::string filename = it->path().filename().string();
+                bool isArtifact = artifactExtensions.count(it->path().extension().string())
+                    || filename.find("multicommodity-min-cost-flow") != std::string::npos;
+                BOOST_REQUIRE_MESSAGE(!isArtifact,
+                        "Artifact " << it->path().string() << " should not be written with artifact policy 'none'");
+            }
+        }
+    }
+}
+
 BOOST_AUTO_TEST_CASE(mission_tt)
 {
 
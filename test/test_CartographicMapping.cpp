@@ -1,6 +1,9 @@
 #include <boost/test/unit_test.hpp>
 #include <templ/utils/CartographicMapping.hpp>
 #include <templ/symbols/constants/Location.hpp>
+#include <templ/solvers/DistanceMatrix.hpp>
+#include <cmath>
+#include <sstream>
 
 BOOST_AUTO_TEST_SUITE(cartographic_mapping)
 
@@ -52,4 +55,50 @@ BOOST_AUTO_TEST_CASE(longitude_latitude_to_metric)
     }
 }
 
+BOOST_AUTO_TEST_CASE(distance_matrix)
+{
+    using namespace templ::utils;
+    using namespace templ::symbols::constants;
+    using namespace templ::solvers;
+
+    Location::PtrList spherical;
+    Location::PtrList cartesian;
+    for(size_t i = 0; i < 21; ++i)
+    {
+        std::stringstream ss;
+        ss << "l" << i;
+        spherical.push_back( templ::make_shared<Location>(ss.str(),
+                    base::Point(-83.5 + 0.1*i, 84.6 + 0.2*i, 0.0),
+                    CartographicMapping::RADIUS_MOON_IN_M) );
+        cartesian.push_back( templ::make_shared<Location>(ss.str(),
+                    base::Point(10.0*i, -5.0*i, 1.0*(i%3))) );
+    }
+    // duplicate position
+    spherical.push_back( templ::make_shared<Location>("l-duplicate",
+                spherical.front()->getPosition(), CartographicMapping::RADIUS_MOON_IN_M) );
+
+    for(const Location::PtrList& locations : { spherical, cartesian })
+    {
+        DistanceMatrix distanceMatrix(locations);
+        BOOST_REQUIRE_MESSAGE(distanceMatrix.size() == locations.size(), "Distance matrix should contain all locations");
+        for(size_t i = 0; i < locations.size(); ++i)
+        {
+            BOOST_REQUIRE_MESSAGE(distanceMatrix.getIndex(locations[i]) == static_cast<int>(i), "Location index should correspond to list position");
+            for(size_t j = 0; j < locations.size(); ++j)
+            {
+                double expected = Location::getDistance(*locations[i], *locations[j]);
+                double distance = distanceMatrix.getDistance(i,j);
+                BOOST_REQUIRE_MESSAGE(std::fabs(expected - distance) <= 1E-06*std::max(1.0, expected),
+                        "Distance from " << i << " to " << j << " expected " << expected << ", but was " << distance);
+            }
+        }
+    }
+
+    Location::Ptr unknown = templ::make_shared<Location>("unknown", base::Point(1.0,1.0,1.0));
+    DistanceMatrix distanceMatrix(cartesian);
+    BOOST_REQUIRE_MESSAGE(distanceMatrix.getIndex(unknown) == -1, "Unknown location should have no index");
+    BOOST_REQUIRE_MESSAGE(distanceMatrix.getDistance(unknown, cartesian[0]) == Location::getDistance(*unknown, *cartesian[0]),
+            "Distance for unknown location should be computed on demand");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
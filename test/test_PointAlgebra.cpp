@@ -3,6 +3,8 @@
 #include <numeric/Combinatorics.hpp>
 #include <templ/solvers/temporal/point_algebra/QualitativeTimePointConstraint.hpp>
 #include <templ/solvers/temporal/point_algebra/QualitativeTimePoint.hpp>
+#include <templ/solvers/temporal/point_algebra/QualitativeRelationMatrix.hpp>
+#include <templ/solvers/temporal/point_algebra/TimePointComparator.hpp>
 #include <templ/solvers/temporal/QualitativeTemporalConstraintNetwork.hpp>
 
 using namespace templ::solvers;
@@ -241,6 +243,11 @@ BOOST_AUTO_TEST_CASE(consistency_check_performance)
         bool consistent = tcn->isConsistent();
         base::Time stop = base::Time::now() - start;
         BOOST_REQUIRE_MESSAGE(consistent, "Temporal constraint network with " << i << " timepoints is consistent: computing time: " << stop.toSeconds());
+
+        start = base::Time::now();
+        consistent = tcn->isConsistent(QualitativeTemporalConstraintNetwork::TCN_MATRIX);
+        stop = base::Time::now() - start;
+        BOOST_REQUIRE_MESSAGE(consistent, "Temporal constraint network with " << i << " timepoints is consistent (matrix): computing time: " << stop.toSeconds());
     }
 }
 
@@ -292,6 +299,9 @@ BOOST_AUTO_TEST_CASE(inconsistency_1)
 
     bool consistent = tcn->isConsistent();
     BOOST_REQUIRE_MESSAGE(!consistent, "Temporal constraint network is inconsistent");
+
+    consistent = tcn->isConsistent(QualitativeTemporalConstraintNetwork::TCN_MATRIX);
+    BOOST_REQUIRE_MESSAGE(!consistent, "Temporal constraint network is inconsistent (matrix)");
 }
 
 BOOST_AUTO_TEST_CASE(inconsistency_benchmark)
@@ -325,4 +335,94 @@ BOOST_AUTO_TEST_CASE(inconsistency_benchmark)
     BOOST_REQUIRE_MESSAGE(!consistent, "Temporal constraint network is inconsistent");
 }
 
+BOOST_AUTO_TEST_CASE(relation_matrix)
+{
+    using namespace templ::solvers::temporal::point_algebra;
+    typedef QualitativeRelationMatrix QRM;
+
+    for(int t = 0; t < 8; ++t)
+    {
+        QTPC::Type type = static_cast<QTPC::Type>(t);
+        BOOST_REQUIRE_MESSAGE(QRM::toType(QRM::toRelation(type)) == type, "Relation mapping of " << QTPC::TypeSymbol[type]);
+    }
+
+    BOOST_REQUIRE(QRM::compose(QRM::LESS, QRM::LESS | QRM::EQUAL) == QRM::LESS);
+    BOOST_REQUIRE(QRM::compose(QRM::LESS, QRM::GREATER) == QRM::UNIVERSAL);
+    BOOST_REQUIRE(QRM::compose(QRM::EQUAL, QRM::LESS | QRM::GREATER) == (QRM::LESS | QRM::GREATER));
+    BOOST_REQUIRE(QRM::converse(QRM::LESS | QRM::EQUAL) == (QRM::GREATER | QRM::EQUAL));
+
+    // t0 < t1 < ... < tn
+    size_t n = 100;
+    QRM matrix(n);
+    for(size_t i = 1; i < n; ++i)
+    {
+        BOOST_REQUIRE(matrix.constrain(i-1, i, QRM::LESS));
+    }
+    BOOST_REQUIRE_MESSAGE(matrix.pathConsistency(), "Chain is consistent");
+    BOOST_REQUIRE_MESSAGE(matrix.get(0, n-1) == QRM::LESS, "Chain implies t0 < tn");
+    BOOST_REQUIRE_MESSAGE(matrix.get(n-1, 0) == QRM::GREATER, "Chain implies tn > t0");
+
+    // Incremental update leading to an inconsistency
+    BOOST_REQUIRE(matrix.constrain(n-1, 0, QRM::LESS | QRM::EQUAL));
+    BOOST_REQUIRE_MESSAGE(!matrix.propagate(), "Cycle is inconsistent");
+}
+
+BOOST_AUTO_TEST_CASE(timepoint_comparator)
+{
+    using namespace templ::solvers::temporal::point_algebra;
+    QualitativeTemporalConstraintNetwork::Ptr tcn(new QualitativeTemporalConstraintNetwork());
+
+    QualitativeTimePoint::Ptr t0(new QualitativeTimePoint("t0"));
+    QualitativeTimePoint::Ptr t1(new QualitativeTimePoint("t1"));
+    QualitativeTimePoint::Ptr t2(new QualitativeTimePoint("t2"));
+    QualitativeTimePoint::Ptr t3(new QualitativeTimePoint("t3"));
+
+    tcn->addQualitativeConstraint(t1, t0, QTPC::Greater);
+    tcn->addQualitativeConstraint(t2, t1, QTPC::GreaterOrEqual);
+    tcn->addQualitativeConstraint(t3, t0, QTPC::Greater);
+
+    TimePointComparator comparator(tcn);
+    BOOST_REQUIRE_MESSAGE(comparator.greaterThan(t2, t0), "t2 > t0 is consistent");
+    BOOST_REQUIRE_MESSAGE(!comparator.greaterThan(t0, t2), "t0 > t2 is inconsistent");
+    BOOST_REQUIRE_MESSAGE(comparator.greaterThan(t3, t1), "t3 > t1 is consistent");
+    BOOST_REQUIRE_MESSAGE(comparator.greaterThan(t1, t3), "t1 > t3 is consistent");
+
+    // Tightening of the network has to be reflected
+    tcn->addQualitativeConstraint(t3, t1, QTPC::LessOrEqual);
+    BOOST_REQUIRE_MESSAGE(!comparator.greaterThan(t3, t1), "t3 > t1 is inconsistent after tightening");
+    BOOST_REQUIRE_MESSAGE(comparator.greaterThan(t1, t3), "t1 > t3 remains consistent");
+
+    std::vector<TimePoint::Ptr> timepoints = { t2, t3, t1, t0 };
+    comparator.sort(timepoints);
+    BOOST_REQUIRE_MESSAGE(timepoints.front() == t0, "t0 is the first timepoint");
+    BOOST_REQUIRE_MESSAGE(timepoints.back() == t2, "t2 is the last timepoint");
+}
+
+BOOST_AUTO_TEST_CASE(constraint_network_revision)
+{
+    using namespace templ::solvers::temporal::point_algebra;
+    QualitativeTemporalConstraintNetwork::Ptr tcn(new QualitativeTemporalConstraintNetwork());
+
+    QualitativeTimePoint::Ptr t0(new QualitativeTimePoint("t0"));
+    QualitativeTimePoint::Ptr t1(new QualitativeTimePoint("t1"));
+    QualitativeTimePoint::Ptr t2(new QualitativeTimePoint("t2"));
+
+    tcn->addQualitativeConstraint(t1, t0, QTPC::Greater);
+    tcn->addQualitativeConstraint(t2, t0, QTPC::Greater);
+    tcn->addQualitativeConstraint(t2, t1, QTPC::LessOrEqual);
+
+    TimePointComparator comparator(tcn);
+    BOOST_REQUIRE_MESSAGE(!comparator.greaterThan(t2, t1), "t2 > t1 is inconsistent");
+
+    // In place change of an existing constraint has to be reflected
+    uint64_t revision = tcn->getRevision();
+    tcn->setConstraintType(t2, t1, QTPC::Universal);
+    BOOST_REQUIRE_MESSAGE(tcn->getRevision() != revision, "Changing the type of a constraint updates the revision");
+    BOOST_REQUIRE_MESSAGE(comparator.greaterThan(t2, t1), "t2 > t1 is consistent after relaxation");
+
+    revision = tcn->getRevision();
+    tcn->setConstraintType(t2, t1, QTPC::Universal);
+    BOOST_REQUIRE_MESSAGE(tcn->getRevision() == revision, "Setting the same type keeps the revision");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -40,4 +40,84 @@ BOOST_AUTO_TEST_CASE(relative_complement)
     }
 }
 
+BOOST_AUTO_TEST_CASE(tagged_roles)
+{
+    std::vector<Role> roles;
+    for(size_t i = 0; i < 100; ++i)
+    {
+        Role role(i, "http://model/instance#1");
+        roles.push_back(role);
+    }
+
+    RoleInfo a;
+    for(size_t i = 0; i < roles.size(); i += 2)
+    {
+        a.addRole(roles[i], RoleInfo::REQUIRED);
+    }
+    for(size_t i = 0; i < roles.size(); i += 3)
+    {
+        a.addRole(roles[i], RoleInfo::ASSIGNED);
+    }
+
+    BOOST_REQUIRE_MESSAGE(a.getRoles(RoleInfo::REQUIRED).size() == 50, "Expected 50 required roles");
+    BOOST_REQUIRE_MESSAGE(a.getRoles("assigned").size() == 34, "Expected 34 assigned roles");
+    BOOST_REQUIRE_MESSAGE(a.getAllRoles().size() == 67, "Expected 67 roles in total");
+
+    Role::List intersection = a.getIntersection(RoleInfo::REQUIRED, RoleInfo::ASSIGNED);
+    BOOST_REQUIRE_MESSAGE(intersection.size() == 17, "Expected 17 roles in the intersection, but was " << intersection.size());
+    BOOST_REQUIRE_MESSAGE(intersection == a.getIntersection("required", "assigned"), "Intersection should be identical for tag and text");
+
+    Role::List complement = a.getRelativeComplement(RoleInfo::REQUIRED, RoleInfo::ASSIGNED);
+    BOOST_REQUIRE_MESSAGE(complement.size() == 33, "Expected 33 roles in the complement, but was " << complement.size());
+
+    Role::List difference = a.getSymmetricDifference(RoleInfo::REQUIRED, RoleInfo::ASSIGNED);
+    BOOST_REQUIRE_MESSAGE(difference.size() == 50, "Expected 50 roles in the symmetric difference, but was " << difference.size());
+
+    BOOST_REQUIRE_MESSAGE(!a.includes(RoleInfo::ASSIGNED, RoleInfo::REQUIRED), "Assigned roles should not include the required roles");
+    for(size_t i = 0; i < roles.size(); i += 2)
+    {
+        a.addRole(roles[i], RoleInfo::ASSIGNED);
+    }
+    BOOST_REQUIRE_MESSAGE(a.includes(RoleInfo::ASSIGNED, RoleInfo::REQUIRED), "Assigned roles should include the required roles");
+    BOOST_REQUIRE_MESSAGE(a.getStatus(roles[2]) == RoleInfo::REQUIRED_ASSIGNED, "Role should be required and assigned");
+
+    a.removeRole(roles[2], RoleInfo::ASSIGNED);
+    BOOST_REQUIRE_MESSAGE(!a.hasRole(roles[2], RoleInfo::ASSIGNED), "Role should be removed");
+    BOOST_REQUIRE_MESSAGE(a.getStatus(roles[2]) == RoleInfo::REQUIRED_UNASSIGNED, "Role should be required and unassigned");
+
+    RoleInfo b;
+    b.setTaggedRoles(a.getTaggedRoles());
+    BOOST_REQUIRE_MESSAGE(b.getRoles(RoleInfo::ASSIGNED) == a.getRoles(RoleInfo::ASSIGNED), "Tagged roles should be restored");
+    BOOST_REQUIRE_MESSAGE(b.getAllRoles() == a.getAllRoles(), "All roles should be restored");
+}
+
+BOOST_AUTO_TEST_CASE(custom_tags)
+{
+    Role r0(0, "http://model/instance#2");
+    Role r1(1, "http://model/instance#2");
+
+    BOOST_REQUIRE_MESSAGE(RoleInfo::getTag("tag-0") == RoleInfo::UNKNOWN, "Unknown tag text should map to UNKNOWN");
+
+    RoleInfo a;
+    a.addRole(r0, "tag-0");
+    a.addRole(r1, "tag-0");
+    a.addRole(r1, "tag-1");
+    BOOST_REQUIRE_MESSAGE(a.getRoles("tag-0").size() == 2, "Expected 2 roles with tag-0");
+    BOOST_REQUIRE_MESSAGE(a.getRoles("tag-2").empty(), "Expected no roles for an unused tag");
+    BOOST_REQUIRE_MESSAGE(a.getRoles(RoleInfo::UNKNOWN).empty(), "Custom tags should not be stored as UNKNOWN");
+    BOOST_REQUIRE_MESSAGE(a.getIntersection("tag-0", "tag-1").size() == 1, "Expected 1 role in the intersection");
+    BOOST_REQUIRE_MESSAGE(a.getTags(r1).size() == 2, "Expected 2 tags for role 1");
+
+    a.removeRole(r1, "tag-0");
+    BOOST_REQUIRE_MESSAGE(!a.hasRole(r1, "tag-0"), "Role should be removed");
+    BOOST_REQUIRE_MESSAGE(a.getAllRoles().size() == 2, "All roles should be kept");
+
+    RoleInfo b;
+    b.setTaggedRoles(a.getTaggedRoles());
+    BOOST_REQUIRE_MESSAGE(b.getRoles("tag-1") == a.getRoles("tag-1"), "Custom tagged roles should be restored");
+
+    a.clear();
+    BOOST_REQUIRE_MESSAGE(a.getAllRoles().empty() && a.getRoles("tag-1").empty(), "Roles should be cleared");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -133,4 +133,50 @@ BOOST_AUTO_TEST_CASE(value_propagation_3)
     }
 }
 
+BOOST_AUTO_TEST_CASE(incremental_consistency)
+{
+    SimpleTemporalNetwork stn;
+
+    point_algebra::TimePoint::Ptr tp0(new point_algebra::TimePoint(0,100));
+    point_algebra::TimePoint::Ptr tp1(new point_algebra::TimePoint(0,100));
+    point_algebra::TimePoint::Ptr tp2(new point_algebra::TimePoint(0,100));
+
+    stn.addInterval(tp0, tp1, Bounds(10,20));
+    stn.addInterval(tp1, tp2, Bounds(30,40));
+    BOOST_REQUIRE_MESSAGE(stn.isConsistent(), "Network is consistent");
+
+    Bounds bounds = stn.getDistanceMatrix().getBounds(tp0, tp2);
+    BOOST_REQUIRE_MESSAGE(bounds.getLowerBound() == 40 && bounds.getUpperBound() == 60, "Minimal network tp0 -> tp2: expected [40,60], actual [" << bounds.getLowerBound() << "," << bounds.getUpperBound() << "]");
+
+    BOOST_REQUIRE_MESSAGE(stn.isConsistent(tp0, tp2, Bounds(55,70)), "Tentative interval [55,70] is consistent");
+    BOOST_REQUIRE_MESSAGE(!stn.isConsistent(tp0, tp2, Bounds(0,35)), "Tentative interval [0,35] is inconsistent");
+    BOOST_REQUIRE_MESSAGE(stn.isConsistent(), "Network remains consistent after what-if check");
+
+    stn.addInterval(tp2, tp0, Bounds(-50,-45));
+    BOOST_REQUIRE_MESSAGE(stn.isConsistent(), "Network is consistent after tightening");
+    bounds = stn.getDistanceMatrix().getBounds(tp0, tp2);
+    BOOST_REQUIRE_MESSAGE(bounds.getLowerBound() == 45 && bounds.getUpperBound() == 50, "Minimal network tp0 -> tp2: expected [45,50], actual [" << bounds.getLowerBound() << "," << bounds.getUpperBound() << "]");
+
+    stn.addInterval(tp0, tp2, Bounds(0,35));
+    BOOST_REQUIRE_MESSAGE(!stn.isConsistent(), "Network is inconsistent");
+}
+
+BOOST_AUTO_TEST_CASE(consistency_after_interval_constraint)
+{
+    SimpleTemporalNetwork stn;
+
+    point_algebra::TimePoint::Ptr tp0(new point_algebra::TimePoint(0,100));
+    point_algebra::TimePoint::Ptr tp1(new point_algebra::TimePoint(0,100));
+
+    stn.addInterval(tp0, tp1, Bounds(10,20));
+    BOOST_REQUIRE_MESSAGE(stn.isConsistent(), "Network is consistent");
+
+    // Modification through the inherited interface has to be reflected
+    IntervalConstraint::Ptr ic(new IntervalConstraint(tp1, tp0));
+    ic->addInterval(Bounds(0,5));
+    stn.addIntervalConstraint(ic);
+    BOOST_REQUIRE_MESSAGE(!stn.isConsistent(), "Network is inconsistent after adding an interval constraint");
+    BOOST_REQUIRE_MESSAGE(!stn.isConsistent(tp0, tp1, Bounds(10,20)), "No tentative interval is consistent with an inconsistent network");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -124,6 +124,35 @@ BOOST_FIXTURE_TEST_CASE(load_solution, SolutionFixture)
     BOOST_REQUIRE_MESSAGE(true, "Solution loaded");
 }
 
+BOOST_FIXTURE_TEST_CASE(network_indices, SolutionFixture)
+{
+    for(size_t i = 0; i < 5; ++i)
+    {
+        timepoints.push_back( pa::TimePoint::create("t" + std::to_string(i)) );
+        locations.push_back( sym::Location::create("l" + std::to_string(i)) );
+    }
+    network = SpaceTime::Network(locations, timepoints);
+    SpaceTime::Network copiedNetwork(network);
+
+    for(size_t l = 0; l < locations.size(); ++l)
+    {
+        for(size_t t = 0; t < timepoints.size(); ++t)
+        {
+            SpaceTime::Network::tuple_t::Ptr tuple = copiedNetwork.tupleByKeys(locations[l], timepoints[t]);
+            BOOST_REQUIRE_MESSAGE(copiedNetwork.getValue(tuple) == locations[l], "Value resolved for tuple");
+            BOOST_REQUIRE_MESSAGE(copiedNetwork.getTimepoint(tuple) == timepoints[t], "Timepoint resolved for tuple");
+            BOOST_REQUIRE_EQUAL(copiedNetwork.getColumn(tuple), l);
+            BOOST_REQUIRE_EQUAL(copiedNetwork.getRow(tuple), t);
+        }
+    }
+
+    pa::TimePoint::PtrList interval = network.getTimepoints(timepoints[1], timepoints[3]);
+    BOOST_REQUIRE_EQUAL(interval.size(), 3u);
+    BOOST_REQUIRE_MESSAGE(interval.front() == timepoints[1] && interval.back() == timepoints[3], "Interval resolved");
+    BOOST_REQUIRE_MESSAGE(network.getTimepoints(timepoints[3], timepoints[1]).empty(), "Inverted interval is empty");
+    BOOST_REQUIRE_EQUAL(network.getTuples(timepoints[0], timepoints[4], locations[2]).size(), 5u);
+}
+
 BOOST_AUTO_TEST_CASE(narrow_mission)
 {
 
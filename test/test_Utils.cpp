@@ -1,7 +1,13 @@
 #include <boost/test/unit_test.hpp>
 
 #include <templ/utils/CSVLogger.hpp>
+#include <templ/utils/ArtifactWriter.hpp>
+#include <templ/utils/Combinations.hpp>
+#include <templ/utils/CopyOnWrite.hpp>
+#include <templ/utils/Logger.hpp>
+#include <set>
 #include <sstream>
+#include <fstream>
 
 using namespace templ;
 
@@ -42,4 +48,142 @@ BOOST_AUTO_TEST_CASE(csv_logger)
 
 }
 
+BOOST_AUTO_TEST_CASE(artifact_writer)
+{
+    std::string filename = "/tmp/templ-test-utils-artifact-writer.log";
+    {
+        templ::utils::ArtifactWriter writer(2);
+        writer.write(filename, "# header\n");
+        for(size_t i = 0; i < 10; ++i)
+        {
+            std::stringstream ss;
+            ss << i << "\n";
+            writer.append(filename, ss.str());
+        }
+        writer.flush();
+        BOOST_REQUIRE_MESSAGE(writer.getNumberOfPendingRequests() == 0, "No pending requests after flush");
+
+        // pending on destruction
+        writer.append(filename, "10\n");
+    }
+
+    std::ifstream infile(filename);
+    std::string line;
+    std::getline(infile, line);
+    BOOST_REQUIRE_MESSAGE(line == "# header", "Header expected, but was '" << line << "'");
+    for(size_t i = 0; i <= 10; ++i)
+    {
+        std::getline(infile, line);
+        std::stringstream ss;
+        ss << i;
+        BOOST_REQUIRE_MESSAGE(line == ss.str(), "Line " << ss.str() << " expected, but was '" << line << "'");
+    }
+}
+
+BOOST_AUTO_TEST_CASE(artifact_policy)
+{
+    using namespace templ::utils;
+    {
+        Logger logger;
+        logger.setArtifactPolicy(Logger::ARTIFACTS_NONE);
+        for(size_t i = 0; i < 10; ++i)
+        {
+            BOOST_REQUIRE_MESSAGE(!logger.sampleIntermediateArtifacts(), "No intermediate artifacts should be sampled when disabled");
+        }
+        BOOST_REQUIRE_MESSAGE(!logger.logSolutionArtifacts(), "No solution artifacts should be logged when disabled");
+    }
+    {
+        Logger logger;
+        logger.setArtifactPolicy(Logger::ARTIFACTS_ON_SOLUTION);
+        BOOST_REQUIRE_MESSAGE(!logger.sampleIntermediateArtifacts(), "No intermediate artifacts should be sampled on-solution");
+        BOOST_REQUIRE_MESSAGE(logger.logSolutionArtifacts(), "Solution artifacts should be logged on-solution");
+    }
+    {
+        Logger logger;
+        logger.setArtifactPolicy(Logger::ARTIFACTS_EVERY_NTH, 3);
+        size_t sampled = 0;
+        for(size_t i = 0; i < 9; ++i)
+        {
+            if(logger.sampleIntermediateArtifacts())
+            {
+                BOOST_REQUIRE_MESSAGE(i % 3 == 0, "Evaluation " << i << " should not be sampled");
+                ++sampled;
+            }
+        }
+        BOOST_REQUIRE_MESSAGE(sampled == 3, "Every third evaluation should be sampled, but sampled " << sampled);
+        BOOST_REQUIRE_THROW(logger.setArtifactPolicy(Logger::ARTIFACTS_EVERY_NTH, 0), std::invalid_argument);
+    }
+
+    for(const std::pair<const Logger::ArtifactPolicy, std::string>& p : Logger::ArtifactPolicyTxt)
+    {
+        BOOST_REQUIRE_MESSAGE(Logger::getArtifactPolicyFromTxt(p.second) == p.first, "Policy '" << p.second << "' should be parsed");
+    }
+    BOOST_REQUIRE_THROW(Logger::getArtifactPolicyFromTxt("unknown"), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(combinations)
+{
+    for(size_t n = 1; n < 10; ++n)
+    {
+        templ::utils::Combinations combinations(n);
+        BOOST_REQUIRE_MESSAGE(combinations.total() == (1u << n) - 1, "Expected 2^n - 1 combinations for n=" << n);
+
+        templ::utils::Combinations::Draw previous;
+        for(uint64_t i = 0; i < combinations.total(); ++i)
+        {
+            templ::utils::Combinations::Draw draw = combinations.unrank(i);
+            BOOST_REQUIRE_MESSAGE(combinations.rank(draw) == i, "Rank of unranked combination " << i << " should be identical");
+            if(i > 0)
+            {
+                bool ordered = draw.size() > previous.size() || (draw.size() == previous.size() && previous < draw);
+                BOOST_REQUIRE_MESSAGE(ordered, "Combinations should be ordered by size and lexicographically");
+            }
+            previous = draw;
+        }
+
+        std::mt19937 generator(n);
+        std::set<templ::utils::Combinations::Draw> drawn;
+        templ::utils::Combinations::Draw draw;
+        while(combinations.next(draw, true, generator))
+        {
+            BOOST_REQUIRE_MESSAGE(drawn.insert(draw).second, "Combinations should be drawn without replacement");
+        }
+        BOOST_REQUIRE_MESSAGE(drawn.size() == combinations.total(), "All combinations should be drawn");
+        BOOST_REQUIRE_MESSAGE(combinations.empty(), "Combinations should be exhausted");
+    }
+
+    templ::utils::Combinations combinations(templ::utils::Combinations::MAX_ITEMS);
+    templ::utils::Combinations::Draw all = combinations.unrank(combinations.total() - 1);
+    BOOST_REQUIRE_MESSAGE(all.size() == templ::utils::Combinations::MAX_ITEMS, "Last combination should contain all items");
+
+    BOOST_REQUIRE_THROW(templ::utils::Combinations(templ::utils::Combinations::MAX_ITEMS + 1), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(copy_on_write)
+{
+    templ::utils::CopyOnWrite< std::vector<int> > original(std::vector<int>({0,1,2}));
+    BOOST_REQUIRE_MESSAGE(!original.isShared(), "Data should not be shared before copying");
+
+    templ::utils::CopyOnWrite< std::vector<int> > copy(original);
+    BOOST_REQUIRE_MESSAGE(original.isShared() && copy.isShared(), "Copy should share the data");
+    BOOST_REQUIRE_MESSAGE(&original.get() == &copy.get(), "Copy should refer to the same data");
+
+    // modification detaches the modified copy only
+    copy.modify().push_back(3);
+    BOOST_REQUIRE_MESSAGE(!original.isShared() && !copy.isShared(), "Modification should detach the copy");
+    BOOST_REQUIRE_MESSAGE(original->size() == 3, "Original should remain unchanged, but has size " << original->size());
+    BOOST_REQUIRE_MESSAGE(copy->size() == 4 && copy->back() == 3, "Copy should be modified");
+
+    // modification of unshared data does not copy
+    const std::vector<int>* data = &original.get();
+    original.modify()[0] = 10;
+    BOOST_REQUIRE_MESSAGE(&original.get() == data, "Unshared data should be modified in place");
+    BOOST_REQUIRE_MESSAGE((*copy)[0] == 0, "Copy should not be affected by the original");
+
+    // assignment replaces the data without affecting other copies
+    templ::utils::CopyOnWrite< std::vector<int> > other(copy);
+    other = std::vector<int>();
+    BOOST_REQUIRE_MESSAGE(other->empty() && copy->size() == 4, "Assignment should only replace the assigned copy");
+}
+
 BOOST_AUTO_TEST_SUITE_END()